@@ -0,0 +1,130 @@
+//[FILE]: CompiledPlan.cpp
+//[DESC]: This file contains the implementation of the 'CompiledPlan' class {[SEE]: CompiledPlan.h}
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: Registers are numbered in order of first use, walking the formulas inputs first.
+
+#include <limits>
+#include <stdexcept>
+
+#include "CompiledPlan.h"
+
+namespace ResourceConversion
+{
+  //[DESC]: Default constructor
+  //[PRE]: None
+  //[POST]: An empty program is constructed, it matches no plan
+  CompiledPlan::CompiledPlan() {}
+
+  //[DESC]: Compile a plan for a stockpile
+  //[PARAM]: 'Source' The plan, read through its packed 'FormulaBook'
+  //[PARAM]: 'Target' The stockpile the program is meant for
+  //[PRE]: None
+  //[POST]: Every resource of 'Source' is resolved to a register, step i describes formula i and the
+  //        dependency graph of the steps is built
+  //[THROW]: 'std::runtime_error' If 'Target' cannot hold one of the resources {[SEE]: Fits(...)}
+  CompiledPlan::CompiledPlan(const Plan& Source, const Stockpile& Target) : Revision(Source.GetRevision())
+  {
+    const FormulaBook& Recipes = Source.GetFormulaBook();
+    const ResourceId* InputIds = Recipes.GetInputIds();
+    const unsigned int* Quantities = Recipes.GetInputQuantities();
+    const ResourceId* OutputIds = Recipes.GetOutputIds();
+    Pinned.reserve(Recipes.Size());
+    for(size_t i = 0; i < Recipes.Size(); i++) { Pinned.push_back(Recipes.GetRecipe(i)); }
+
+    static constexpr std::uint32_t Unassigned = std::numeric_limits<std::uint32_t>::max();
+    std::vector<std::uint32_t> RegisterOf;
+    auto Resolve = [this, &RegisterOf](ResourceId Resource) -> std::uint32_t {
+      if(Resource >= RegisterOf.size()) { RegisterOf.resize(static_cast<size_t>(Resource) + 1, Unassigned); }
+      if(RegisterOf[Resource] == Unassigned)
+      {
+        RegisterOf[Resource] = static_cast<std::uint32_t>(Resources.size());
+        Resources.push_back(Resource);
+      }
+      return RegisterOf[Resource];
+    };
+
+    Steps.reserve(Recipes.Size());
+    if(Recipes.Size() > 0)
+    {
+      InputRegisters.reserve(Recipes.InputEnd(Recipes.Size() - 1));
+      InputQuantities.reserve(Recipes.InputEnd(Recipes.Size() - 1));
+      OutputRegisters.reserve(Recipes.OutputEnd(Recipes.Size() - 1));
+    }
+
+    for(size_t i = 0; i < Recipes.Size(); i++)
+    {
+      Step Compiled;
+      Compiled.InputBegin = static_cast<std::uint32_t>(InputRegisters.size());
+      for(size_t j = Recipes.InputBegin(i); j < Recipes.InputEnd(i); j++)
+      {
+        const std::uint32_t Register = Resolve(InputIds[j]);
+        size_t Merged = Compiled.InputBegin;
+        while(Merged < InputRegisters.size() && InputRegisters[Merged] != Register) { Merged++; }
+
+        if(Merged < InputRegisters.size()) { InputQuantities[Merged] += Quantities[j]; }
+        else
+        {
+          InputRegisters.push_back(Register);
+          InputQuantities.push_back(Quantities[j]);
+        }
+      }
+      Compiled.InputEnd = static_cast<std::uint32_t>(InputRegisters.size());
+
+      Compiled.OutputBegin = static_cast<std::uint32_t>(OutputRegisters.size());
+      for(size_t j = Recipes.OutputBegin(i); j < Recipes.OutputEnd(i); j++)
+      {
+        OutputRegisters.push_back(Resolve(OutputIds[j]));
+      }
+      Compiled.OutputEnd = static_cast<std::uint32_t>(OutputRegisters.size());
+      Steps.push_back(Compiled);
+    }
+
+    Graph.Reset(Resources.size());
+    for(const Step& Compiled : Steps)
+    {
+      Graph.AddStep(Span<const std::uint32_t>(InputRegisters.data() + Compiled.InputBegin, Compiled.InputEnd - Compiled.InputBegin),
+                    Span<const std::uint32_t>(OutputRegisters.data() + Compiled.OutputBegin, Compiled.OutputEnd - Compiled.OutputBegin));
+    }
+    Graph.Finish();
+
+    if(!Fits(Target))
+    {
+      throw std::runtime_error("[CP]CompiledPlan(...) [Resource has no slot in the Concurrent/Sharded stockpile]");
+    }
+  }
+
+  //[DESC]: Check whether the program was compiled from the current state of a plan
+  //[PRE]: None
+  //[POST]: None
+  //[RETURN]: 'false' once any formula of 'Source' may have changed since compilation, through the plan
+  //          (revision) or through a 'Formula&' kept from before (pinned recipe)
+  bool CompiledPlan::Matches(const Plan& Source) const
+  {
+    if(Revision != Source.GetRevision() || Steps.size() != Source.GetSize()) { return false; }
+    for(size_t i = 0; i < Steps.size(); i++)
+    {
+      if(!Source[i].UsesRecipe(Pinned[i].get())) { return false; }
+    }
+    return true;
+  }
+
+  //[DESC]: Check whether a stockpile can store every resource of the program
+  //[PRE]: None
+  //[POST]: None
+  //[RETURN]: 'true' if the program can run on 'Target' {[SEE]: Stockpile::CanStore(...)}
+  bool CompiledPlan::Fits(const Stockpile& Target) const
+  {
+    for(ResourceId Resource : Resources)
+    {
+      if(!Target.CanStore(Resource)) { return false; }
+    }
+    return true;
+  }
+}//[NAMESPACE]: ResourceConversion
@@ -0,0 +1,111 @@
+//[FILE]: CompiledPlan.h
+//[DESC]: This file defines the 'CompiledPlan' class, a flat, pre-resolved program for running an
+//        'ExecutablePlan' against a stockpile {[SEE]: ExecutablePlan::Compile(...)}.
+//
+//        Compiling numbers every distinct resource the plan touches with a register (0, 1, 2, ...)
+//        and rewrites each formula as a step over those registers:
+//
+//          Resources      [Iron, Coal, Steel]             -> register r holds 'Resources[r]'
+//          Steps          [{0, 2, 0, 1}, ...]             -> step i reads inputs [0, 2) and outputs [0, 1)
+//          InputRegisters [0, 1]   InputQuantities [2, 1]
+//          OutputRegisters[2]
+//
+//        Running the program loads each register from the stockpile once, executes every step on the
+//        register file (no lookups, no hashing, no allocations) and writes the changed registers back
+//        once. Duplicate inputs of a formula are merged at compile time.
+//
+//        Compiling also derives the dependency DAG of the steps {[SEE]: StepGraph.h}, so steps that
+//        share no resource can run at the same time {[SEE]: ExecutablePlan::PlanApply(..., Pool)}.
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: 'Steps[i]' describes formula i of the compiled plan, its ranges index the register arrays.
+//[INVARIANT]: Every register index is below 'RegisterCount()', every register appears once in 'Resources'.
+//[INVARIANT]: A program never changes after compilation.
+//
+//[USAGE]
+//{
+// CompiledPlan Program = PlanObj.Compile(*StockpilePtr);
+//
+// for(...) { PlanObj.PlanApply(Program, FreshStockpilePtr); }   -> compiled once, run many times
+//}
+//
+//[DEPENDENCIES]:
+//       [INTERNAL]:
+//          - Member, Helper, Utility methods
+//          - Private Data Members
+//
+//        [EXTERNAL]:
+//          - 'Plan' class {[SEE]: Plan.h}
+//          - 'Stockpile' class {[SEE]: Stockpile.h}
+//          - 'StepGraph' class {[SEE]: StepGraph.h}
+//          - 'std::vector'
+//
+//[NAMESPACE]: {ResourceConversion} Encapsulates the 'Formula', 'Plan', 'ExecutablePlan', 'Stockpile'
+//             and supporting classes.
+#ifndef CompiledPlan_h
+#define CompiledPlan_h
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "FormulaRecipe.h"
+#include "Plan.h"
+#include "ResourceRegistry.h"
+#include "Stockpile.h"
+#include "StepGraph.h"
+
+namespace ResourceConversion
+{
+  class CompiledPlan
+  {
+    public:
+    //[DESC]: One formula of the plan, as half-open ranges of the input and output arrays
+    struct Step
+    {
+      std::uint32_t InputBegin = 0;
+      std::uint32_t InputEnd = 0;
+      std::uint32_t OutputBegin = 0;
+      std::uint32_t OutputEnd = 0;
+    };
+
+    private:
+    std::vector<Step> Steps = std::vector<Step>();
+    std::vector<std::uint32_t> InputRegisters = std::vector<std::uint32_t>();
+    std::vector<size_t> InputQuantities = std::vector<size_t>();
+    std::vector<std::uint32_t> OutputRegisters = std::vector<std::uint32_t>();
+    std::vector<ResourceId> Resources = std::vector<ResourceId>();
+    StepGraph Graph = StepGraph();
+
+    //[NOTE]: The plan revision the program was compiled from {[SEE]: Plan::GetRevision()}
+    std::uint64_t Revision = 0;
+    //[NOTE]: The recipes step i was compiled from, a formula edited through a kept reference no longer
+    //        uses its pinned recipe {[SEE]: FormulaBook.h}
+    std::vector<std::shared_ptr<const FormulaRecipe>> Pinned = std::vector<std::shared_ptr<const FormulaRecipe>>();
+
+    public:
+    CompiledPlan();
+    CompiledPlan(const Plan& Source, const Stockpile& Target);
+
+    bool Matches(const Plan& Source) const;
+    bool Fits(const Stockpile& Target) const;
+
+    inline size_t StepCount() const { return Steps.size(); }
+    inline size_t RegisterCount() const { return Resources.size(); }
+
+    inline const Step& GetStep(size_t Index) const { return Steps[Index]; }
+    inline const std::uint32_t* GetInputRegisters() const { return InputRegisters.data(); }
+    inline const size_t* GetInputQuantities() const { return InputQuantities.data(); }
+    inline const std::uint32_t* GetOutputRegisters() const { return OutputRegisters.data(); }
+    inline const ResourceId* GetResources() const { return Resources.data(); }
+    inline const StepGraph& GetGraph() const { return Graph; }
+  };
+}//[NAMESPACE]: ResourceConversion
+#endif /*CompiledPlan_h*/
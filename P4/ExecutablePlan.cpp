@@ -27,11 +27,14 @@
 #include <memory>
 #include <utility>
 #include <optional>
+#include <vector>
+#include <cstdint>
 
 #include <iostream>
 
 #include "Stockpile.h"
 #include "ExecutablePlan.h"
+#include "PlanCheckpoint.h"
 #include "Formula.h"
 #include "Plan.h"
 
@@ -48,6 +51,7 @@ ExecutablePlan::ExecutablePlan() : Plan()
 {
     Step = 0;
     CompletedArray = new (std::nothrow) bool[Size];
+    CompletedArraySize = CompletedArrayCapacity = Size;
     for(size_t i = 0; i < Size; i++)
     {
         CompletedArray[i] = false;
@@ -81,6 +85,7 @@ ExecutablePlan::ExecutablePlan(Formula* FormulaArray_, size_t Size_, unsigned in
         };
         
         CompletedArray = new (std::nothrow) bool[CompletedArraySize];
+        CompletedArrayCapacity = CompletedArraySize;
         SetCompletedArrayValues();
     }
 
@@ -109,6 +114,7 @@ inline void ExecutablePlan::CopyXPlanData (const ExecutablePlan& other)
 {
     Step = other.Step;
     CompletedArraySize = other.CompletedArraySize;
+    CompletedArrayCapacity = other.CompletedArraySize;
     CompletedArray = new (std::nothrow) bool[CompletedArraySize];
     
     for(size_t i = 0; i < CompletedArraySize; i++)
@@ -126,6 +132,7 @@ inline void ExecutablePlan::ResetXPlan ()
 {
     CompletedArray = nullptr;
     CompletedArraySize = 0;
+    CompletedArrayCapacity = 0;
     Step = 0;
 }
 
@@ -135,12 +142,14 @@ inline void ExecutablePlan::ResetXPlan ()
 // [PRE]: The 'other' ExecutablePlan object is in a valid state, but it may be left in an unspecified
 //        state after this operation.
 // [POST]: This ExecutablePlan object receives the data (CompletedArray, CompletedArraySize, and Step)
-//         from 'other,' and 'other' may be in an unspecified state after this operation.
-inline void ExecutablePlan::ReassignDataXPlan(ExecutablePlan&& other) const
+//         from 'other,' and 'other' is reset to an empty state.
+inline void ExecutablePlan::ReassignDataXPlan(ExecutablePlan&& other)
 {
-    other.CompletedArray = CompletedArray;
-    other.CompletedArraySize = CompletedArraySize;
-    other.Step = Step;
+    CompletedArray = other.CompletedArray;
+    CompletedArraySize = other.CompletedArraySize;
+    CompletedArrayCapacity = other.CompletedArrayCapacity;
+    Step = other.Step;
+    other.ResetXPlan();
 }
 
 // [DESC]: Swaps the data of this ExecutablePlan with another ExecutablePlan using move semantics.
@@ -153,6 +162,7 @@ inline void ExecutablePlan::SwapDataXPlan(ExecutablePlan&& other)
 {
     std::swap(other.CompletedArray, CompletedArray);
     std::swap(other.CompletedArraySize, CompletedArraySize);
+    std::swap(other.CompletedArrayCapacity, CompletedArrayCapacity);
     std::swap(other.Step, Step);
 }
 
@@ -192,7 +202,6 @@ ExecutablePlan::ExecutablePlan(const ExecutablePlan& other) : Plan(other)
 ExecutablePlan::ExecutablePlan(ExecutablePlan &&other) noexcept : Plan(std::move(other))
 {
     ReassignDataXPlan(std::move(other));
-    ClearXPlan();
 }
 
 //[DESC]: Move assignment operator for the 'ExecutablePlan' class. Allows for efficient deep copying
@@ -213,21 +222,24 @@ ExecutablePlan::ExecutablePlan(ExecutablePlan &&other) noexcept : Plan(std::move
 
 //[DESC]: Adds a value to the CompletedArray.
 //[PRE]: The 'CompletedArray' must be a valid pointer to an existing C-style array of booleans.
-//[POST]: The CompletedArray is resized to include the new value, and `CompletedArraySize` is updated
-//        accordingly.
+//[POST]: The value is appended and `CompletedArraySize` is updated accordingly. The array grows
+//        geometrically, so a run of pushes copies every value a constant number of times.
 inline void ExecutablePlan::PushArrayValue(const bool &Value)
 {
-    size_t NewSize = CompletedArraySize + 1;
-    bool* NewArray = new (std::nothrow) bool[NewSize];
-    
-    for(size_t i = 0; i < CompletedArraySize; i++)
+    if(CompletedArraySize >= CompletedArrayCapacity)
     {
-        NewArray[i] = CompletedArray[i];
+        size_t NewCapacity = std::max(static_cast<size_t>(2), CompletedArrayCapacity * 2);
+        bool* NewArray = new (std::nothrow) bool[NewCapacity];
+        
+        for(size_t i = 0; i < CompletedArraySize; i++)
+        {
+            NewArray[i] = CompletedArray[i];
+        }
+        delete [] CompletedArray;
+        CompletedArray = NewArray;
+        CompletedArrayCapacity = NewCapacity;
     }
-    NewArray[CompletedArraySize] = Value;
-    delete [] CompletedArray;
-    CompletedArray = NewArray;
-    CompletedArraySize = NewSize;
+    CompletedArray[CompletedArraySize++] = Value;
 }
 
 //[DESC]: Add a new Formula to the ExecutablePlan.
@@ -246,6 +258,18 @@ void ExecutablePlan::AddFormula(const Formula &NewFormula)
     PushArrayValue(InitialCompletedArrayValue);
 }
 
+//[DESC]: Add a new Formula to the ExecutablePlan, taking over its data.
+//[PARAM]: NewFormula The Formula to be moved into the plan.
+//[PRE]: None.
+//[POST]: Same as 'AddFormula(const Formula&)', 'NewFormula' is left empty.
+//[THROW]: None
+void ExecutablePlan::AddFormula(Formula &&NewFormula)
+{
+    bool const InitialCompletedArrayValue = false;
+    Plan::AddFormula(std::move(NewFormula));
+    PushArrayValue(InitialCompletedArrayValue);
+}
+
 
 
 //[DESC]: Remove the last Formula from the Plan.
@@ -270,6 +294,8 @@ void ExecutablePlan::RemoveLastFormula()
 //
 //[THROW]: std::invalid_argument if Index < Step, and std::logic_error if the formula was already
 //         completed
+//[NOTE]: Copies one formula, whatever the size of the plan. To see what a replacement changes without
+//        running the plan again {[SEE]: PlanReplay.h}
 void ExecutablePlan::ReplaceFormula(const Formula& NewFormula, const size_t &Index)
 {
     if(Index < Step)
@@ -277,14 +303,11 @@ void ExecutablePlan::ReplaceFormula(const Formula& NewFormula, const size_t &Ind
         throw std::invalid_argument("[EP]ReplaceFormula(...): [Index cannot be less than _Step]");
     }
     
-    for(size_t i = 0; i < CompletedArraySize; i++)
+    if(Index < CompletedArraySize && CompletedArray[Index] == true)
     {
-        if(CompletedArray[Index] == true)
-        {
-            throw std::logic_error("[EP]ReplaceFormula(...): [Cannot Replace, Formula was already applied]");
-        }
-        Plan::ReplaceFormula(NewFormula, Index);
+        throw std::logic_error("[EP]ReplaceFormula(...): [Cannot Replace, Formula was already applied]");
     }
+    Plan::ReplaceFormula(NewFormula, Index);
 }
 
 //[DESC]: Apply all Formulas in the Plan.ß
@@ -307,7 +330,7 @@ void ExecutablePlan::PlanApply() {
         throw std::out_of_range("[EP]PlanApply(): Step is out of range for FormulaArray");
     }
 
-    FormulaArray[Step].Apply();
+    ApplyFormulaAt(Step);
 
     CompletedArray[Step] = true;
     Step++;
@@ -320,8 +343,16 @@ void ExecutablePlan::PlanApply() {
 //[PARAM]: Reference to a a 'shared_ptr' of Type Stockpile
 //[RETURN]: A shared_ptr to the updated Stockpile after applying the plan.
 //[THROW]: Throws std::invalid_argument if StockpilePtr is a null shared_ptr.
+//[THROW]: {[SEE]: ApplyStepTo(...)} The failing step is undone, the steps before it stay applied.
 //[NOTE]: This function iterates through the formulas in the plan, checks if the required resources are available 
 //        in the Stockpile, applies the formulas, and updates the Stockpile accordingly.
+//        The inputs of a step are consumed all-or-nothing and the realized results of the formula
+//        (not the nominal outputs) are produced {[SEE]: Stockpile::TryConsume(...), Stockpile::Produce(...)}.
+//        A step whose inputs are short leaves the Stockpile unchanged, so several plans may share one
+//        'Concurrent' Stockpile.
+//        The recipes are read through non-owning views of the formulas {[SEE]: Formula::GetView()}.
+//        The apply path itself never allocates; the Stockpile only does when a step adds a resource
+//        it does not hold yet (or in 'Versioned' mode, which allocates every new version).
 std::shared_ptr<Stockpile> ExecutablePlan::PlanApply(const std::shared_ptr<Stockpile>& StockpilePtr)
 {
     if (StockpilePtr == nullptr)
@@ -333,30 +364,305 @@ std::shared_ptr<Stockpile> ExecutablePlan::PlanApply(const std::shared_ptr<Stock
 
     for (size_t i = 0; i < Size; i++)
     {
-        Formula::StockpileDataLoader s_Data(FormulaArray[i]);
-        bool QuantitiesAreSufficient = std::all_of(s_Data.s_InputResources.begin(),
-            s_Data.s_InputResources.end(),
-            [ResultStockpile, &s_Data](const std::string& resource) {
-                return ResultStockpile -> HasResource(resource) &&
-                       ResultStockpile -> GetResourceQuantity(resource) >=
-                           s_Data.s_InputQuantities[&resource - &s_Data.s_InputResources[0]];
-            });
-
-        if (QuantitiesAreSufficient)
+        ApplyStepTo(i, *ResultStockpile);
+    }
+    FinishApplyRound();
+    return ResultStockpile;
+}
+
+//[DESC]: Applies a single formula of the plan to the given Stockpile, one step of 'PlanApply(StockpilePtr)'.
+//[PRE]: None.
+//[POST]: If the inputs of formula 'Index' are available they are consumed, the formula is applied and
+//        its results are produced. Otherwise the Stockpile is unchanged.
+//        If the results cannot be produced, the consumed inputs are put back and the proficiency level
+//        of the formula is restored before the exception leaves; only its result array keeps the draw.
+//
+//[PARAM]: 'Index' The step to apply
+//[PARAM]: 'Target' The Stockpile to apply it to
+//[RETURN]: True if the step ran, false if its inputs were short.
+//[THROW]: Throws std::out_of_range if Index is out of range.
+//[THROW]: {[SEE]: Stockpile::Produce(...)}
+//[NOTE]: For schedulers that interleave the steps of many plans {[SEE]: PlanExecutor.h}. Applying every
+//        step in order and then calling 'FinishApplyRound()' is exactly 'PlanApply(StockpilePtr)'.
+bool ExecutablePlan::ApplyStepTo(size_t Index, Stockpile& Target)
+{
+    if (Index >= Size)
+    {
+        throw std::out_of_range("[EP]ApplyStepTo(...) [Index out of range]");
+    }
+
+    const Formula::ResourceView Recipe = FormulaArray[Index].GetView();
+    if (!Target.TryConsume(Recipe.InputResources.data(), Recipe.InputQuantities.data(), Recipe.InputResources.size()))
+    {
+        return false;
+    }
+
+    const unsigned int Level = FormulaArray[Index].GetProficiencyLevel();
+    ApplyFormulaAt(Index);
+    try
+    {
+        Target.Produce(Recipe.OutputResources.data(), FormulaArray[Index].GetResultArray(), Recipe.OutputResources.size());
+    }
+    catch (...)
+    {
+        Target.Produce(Recipe.InputResources.data(), Recipe.InputQuantities.data(), Recipe.InputResources.size());
+        FormulaArray[Index].RestoreProgress(Level, nullptr);
+        throw;
+    }
+    return true;
+}
+
+//[DESC]: Compiles the plan for a stockpile, resolving every resource to a register of a flat program.
+//[PRE]: None.
+//[POST]: The plan is unchanged. The program stays valid until a formula of the plan changes.
+//
+//[PARAM]: The stockpile the program is meant for, or one with the same storage mode and size.
+//[RETURN]: The program {[SEE]: CompiledPlan.h}
+//[THROW]: Throws std::runtime_error if a 'Concurrent' or 'Sharded' Target cannot hold one of the resources.
+//[NOTE]: Compile once and run the program on any number of fresh stockpiles.
+CompiledPlan ExecutablePlan::Compile(const Stockpile& Target) const
+{
+    return CompiledPlan(*this, Target);
+}
+
+//[DESC]: Checks that a compiled program can run on this plan and the given Stockpile.
+//[PRE]: None.
+//[POST]: None.
+//[THROW]: Throws std::invalid_argument if StockpilePtr is a null shared_ptr, or if the program was not
+//         compiled from the current formulas of this plan.
+//[THROW]: Throws std::runtime_error if the Stockpile cannot hold one of the resources of the program.
+inline void ExecutablePlan::CheckProgram(const CompiledPlan& Program, const std::shared_ptr<Stockpile>& StockpilePtr) const
+{
+    if (StockpilePtr == nullptr)
+    {
+        throw std::invalid_argument("[EP]PlanApply{Compiled}(...) [StockpilePtr must not be NULL]");
+    }
+    if (!Program.Matches(*this))
+    {
+        throw std::invalid_argument("[EP]PlanApply{Compiled}(...) [Program is stale, compile the plan again]");
+    }
+    if (!Program.Fits(*StockpilePtr))
+    {
+        throw std::runtime_error("[EP]PlanApply{Compiled}(...) [Resource has no slot in the Concurrent/Sharded stockpile]");
+    }
+}
+
+//[DESC]: Reads every register of a program from the Stockpile.
+//[PRE]: None.
+//[POST]: 'Loaded' and 'Registers' hold one quantity per register, 'AbsentRegister' for an absent resource.
+inline void ExecutablePlan::LoadRegisters(const CompiledPlan& Program, const Stockpile& Source, std::vector<size_t>& Loaded, std::vector<size_t>& Registers)
+{
+    const ResourceId* Resources = Program.GetResources();
+    Loaded.resize(Program.RegisterCount());
+    for (size_t r = 0; r < Program.RegisterCount(); r++)
+    {
+        Loaded[r] = Source.HasResource(Resources[r]) ? Source.GetResourceQuantity(Resources[r]) : AbsentRegister;
+    }
+    Registers.assign(Loaded.begin(), Loaded.end());
+}
+
+//[DESC]: Runs one step of a program on the register file.
+//[PRE]: 'Registers' holds one quantity per register of the program.
+//[POST]: If every input is available it is consumed, the formula is applied and its results are added.
+//        Otherwise nothing changes.
+//[THROW]: Throws std::overflow_error if a result does not fit, the inputs stay consumed.
+//[NOTE]: Touches only the registers of step 'Index' and 'FormulaArray[Index]', steps without a shared
+//        register may run at the same time.
+void ExecutablePlan::RunCompiledStep(const CompiledPlan& Program, size_t Index, size_t* Registers)
+{
+    const CompiledPlan::Step& Current = Program.GetStep(Index);
+    const std::uint32_t* InputRegisters = Program.GetInputRegisters();
+    const size_t* InputQuantities = Program.GetInputQuantities();
+    const std::uint32_t* OutputRegisters = Program.GetOutputRegisters();
+
+    for (std::uint32_t j = Current.InputBegin; j < Current.InputEnd; j++)
+    {
+        const size_t Quantity = Registers[InputRegisters[j]];
+        if (Quantity == AbsentRegister || Quantity < InputQuantities[j])
         {
-            FormulaArray[i].Apply();
-            for (size_t j = 0; j < s_Data.s_InputResources.size(); j++)
-            {
-                ResultStockpile -> DecreaseQuantity(s_Data.s_InputResources[j], s_Data.s_InputQuantities[j]);
-            }
+            return;
+        }
+    }
 
-            for (size_t j = 0; j < FormulaArray[i].GetOutputResourcesSize(); j++)
-            {
-                ResultStockpile -> IncreaseQuantity(FormulaArray[i].GetOutputResources()[j], this -> FormulaArray[i].GetOutputQuantities()[j]);
-            }
+    for (std::uint32_t j = Current.InputBegin; j < Current.InputEnd; j++)
+    {
+        Registers[InputRegisters[j]] -= InputQuantities[j];
+    }
+
+    ApplyFormulaAt(Index);
+    const unsigned int* Results = FormulaArray[Index].GetResultArray();
+    for (std::uint32_t j = Current.OutputBegin; j < Current.OutputEnd; j++)
+    {
+        size_t& Quantity = Registers[OutputRegisters[j]];
+        const size_t Base = (Quantity == AbsentRegister) ? 0 : Quantity;
+        if (Results[j - Current.OutputBegin] >= AbsentRegister - Base)
+        {
+            throw std::overflow_error("[EP]PlanApply{Compiled}(...) [Quantity overflow]");
         }
+        Quantity = Base + Results[j - Current.OutputBegin];
+    }
+}
+
+//[DESC]: Writes the changed registers of a program back to the Stockpile.
+//[PRE]: No other thread changed the Stockpile since 'LoadRegisters(...)'.
+//[POST]: The Stockpile holds the quantities of 'Registers', a resource that became present is added.
+inline void ExecutablePlan::StoreRegisters(const CompiledPlan& Program, Stockpile& Target, const std::vector<size_t>& Loaded, const std::vector<size_t>& Registers)
+{
+    const ResourceId* Resources = Program.GetResources();
+    for (size_t r = 0; r < Program.RegisterCount(); r++)
+    {
+        if (Registers[r] == Loaded[r])
+        {
+            continue;
+        }
+
+        if (Loaded[r] == AbsentRegister || Registers[r] > Loaded[r])
+        {
+            Target.Deposit(Resources[r], Registers[r] - ((Loaded[r] == AbsentRegister) ? 0 : Loaded[r]));
+        }
+        else
+        {
+            Target.Withdraw(Resources[r], Loaded[r] - Registers[r]);
+        }
+    }
+}
+
+//[DESC]: Applies a compiled plan to the given Stockpile, with the same outcome as 'PlanApply(StockpilePtr)'.
+//[PRE]: The StockpilePtr parameter must not be a null shared_ptr. No other thread changes the Stockpile
+//       while the program runs.
+//[POST]: The Stockpile is updated according to the plan's formulas, and the resulting Stockpile is returned.
+//
+//[PARAM]: 'Program' The result of 'Compile(...)' on this plan
+//[PARAM]: Reference to a a 'shared_ptr' of Type Stockpile
+//[RETURN]: A shared_ptr to the updated Stockpile after applying the plan.
+//[THROW]: {[SEE]: CheckProgram(...)}
+//[THROW]: Throws std::overflow_error if a quantity does not fit, the Stockpile is unchanged in that case.
+//[NOTE]: Each register is read from the Stockpile once, the steps run on the register file only (no
+//        lookups, no hashing, no allocations) and the changed registers are written back once at the
+//        end. The register file is kept per thread, so repeated runs do not allocate either.
+//        Unlike 'PlanApply(StockpilePtr)' the steps are not individually visible to other threads,
+//        use the uncompiled overload to share one 'Concurrent' Stockpile between plans.
+std::shared_ptr<Stockpile> ExecutablePlan::PlanApply(const CompiledPlan& Program, const std::shared_ptr<Stockpile>& StockpilePtr)
+{
+    CheckProgram(Program, StockpilePtr);
+
+    thread_local std::vector<size_t> Loaded;
+    thread_local std::vector<size_t> Registers;
+    LoadRegisters(Program, *StockpilePtr, Loaded, Registers);
+
+    for (size_t i = 0; i < Program.StepCount(); i++)
+    {
+        RunCompiledStep(Program, i, Registers.data());
+    }
+
+    StoreRegisters(Program, *StockpilePtr, Loaded, Registers);
+    FinishApplyRound();
+    return StockpilePtr;
+}
+
+//[DESC]: Applies a compiled plan to the given Stockpile, running independent steps in parallel.
+//[PRE]: Same as 'PlanApply(Program, StockpilePtr)'.
+//[POST]: The Stockpile holds exactly what 'PlanApply(Program, StockpilePtr)' would have produced with
+//        the same draws {[SEE]: StepGraph.h}. With a seeded or counter-based plan the result is
+//        identical for any number of workers.
+//
+//[PARAM]: 'Program' The result of 'Compile(...)' on this plan
+//[PARAM]: Reference to a a 'shared_ptr' of Type Stockpile
+//[PARAM]: 'Pool' The workers to run the steps on
+//[RETURN]: A shared_ptr to the updated Stockpile after applying the plan.
+//[THROW]: {[SEE]: CheckProgram(...)}
+//[THROW]: Throws std::overflow_error if a quantity does not fit, the Stockpile is unchanged in that case.
+//[NOTE]: The steps run on the compiled register file, so two steps without a shared resource touch
+//        disjoint memory and need no locking, whatever the storage mode of the Stockpile. A step starts
+//        once every earlier step on one of its resources finished {[SEE]: CompiledPlan::GetGraph()}.
+std::shared_ptr<Stockpile> ExecutablePlan::PlanApply(const CompiledPlan& Program, const std::shared_ptr<Stockpile>& StockpilePtr, WorkStealingPool& Pool)
+{
+    CheckProgram(Program, StockpilePtr);
+
+    thread_local std::vector<size_t> Loaded;
+    thread_local std::vector<size_t> Registers;
+    LoadRegisters(Program, *StockpilePtr, Loaded, Registers);
+
+    size_t* RegisterFile = Registers.data();
+    Pool.Run(Program.GetGraph(), [this, &Program, RegisterFile](size_t Index) {
+        RunCompiledStep(Program, Index, RegisterFile);
+    });
+
+    StoreRegisters(Program, *StockpilePtr, Loaded, Registers);
+    FinishApplyRound();
+    return StockpilePtr;
+}
+
+//[DESC]: Applies the remaining steps of the plan to the given Stockpile, recording a checkpoint every
+//        'Interval' steps so a crashed run can resume where it stopped {[SEE]: PlanCheckpoint.h}.
+//[PRE]: The StockpilePtr parameter must not be a null shared_ptr.
+//[POST]: A checkpoint of the starting point is recorded. Steps 'Step' .. Size - 1 are applied as in
+//        'PlanApply(StockpilePtr)', each is marked completed and 'Step' moves past it. The round is
+//        finished and a last checkpoint is recorded at the end.
+//
+//[PARAM]: Reference to a a 'shared_ptr' of Type Stockpile
+//[PARAM]: 'Log' The checkpoint to record into
+//[PARAM]: 'Interval' The number of steps between two checkpoints
+//[RETURN]: A shared_ptr to the updated Stockpile.
+//[THROW]: Throws std::invalid_argument if StockpilePtr is a null shared_ptr or 'Interval' is 0.
+//[THROW]: {[SEE]: PlanCheckpoint::Record(...)}
+//[NOTE]: A plan whose steps are all completed returns right away, so calling this again on a restored
+//        plan never applies a step twice. A seeded or counter-based plan resumed from a checkpoint
+//        draws exactly what the interrupted run would have drawn.
+std::shared_ptr<Stockpile> ExecutablePlan::PlanApply(const std::shared_ptr<Stockpile>& StockpilePtr, PlanCheckpoint& Log, size_t Interval)
+{
+    if (StockpilePtr == nullptr)
+    {
+        throw std::invalid_argument("[EP]PlanApply{Checkpoint}(...) [StockpilePtr must not be NULL]");
+    }
+    if (Interval == 0)
+    {
+        throw std::invalid_argument("[EP]PlanApply{Checkpoint}(...) [Interval must not be 0]");
+    }
+    if (Step >= Size)
+    {
+        return StockpilePtr;
+    }
+
+    Log.Record(*this, *StockpilePtr);
+    size_t SinceRecord = 0;
+    while (Step < Size)
+    {
+        ApplyStepTo(Step, *StockpilePtr);
+        CompletedArray[Step] = true;
+        Step++;
+
+        if (++SinceRecord == Interval && Step < Size)
+        {
+            Log.Record(*this, *StockpilePtr);
+            SinceRecord = 0;
+        }
+    }
+    FinishApplyRound();
+    Log.Record(*this, *StockpilePtr);
+    return StockpilePtr;
+}
+
+//[DESC]: Puts back how far the plan got {[SEE]: PlanCheckpoint.h}.
+//[PRE]: None.
+//[POST]: 'Step' is 'Step_' and step i is marked completed exactly when 'Completed[i]' is set.
+//
+//[PARAM]: 'Step_' The next step to apply, 'Size' once every step was applied
+//[PARAM]: 'Completed' One flag per formula of the plan
+//[THROW]: Throws std::invalid_argument if 'Step_' is above the size or 'Completed' does not have one
+//         flag per formula.
+void ExecutablePlan::RestoreProgress(unsigned int Step_, Span<const bool> Completed)
+{
+    if (Step_ > Size || Completed.size() != Size)
+    {
+        throw std::invalid_argument("[EP]RestoreProgress(...) [Progress does not match the plan]");
+    }
+
+    Step = Step_;
+    for (size_t i = 0; i < Size && i < CompletedArraySize; i++)
+    {
+        CompletedArray[i] = Completed[i];
     }
-    return ResultStockpile;
 }
 
 // [DESC]: Overloads the inequality operator (!=) for comparing two ExecutablePlan objects.
@@ -702,9 +1008,20 @@ ExecutablePlan& ExecutablePlan::operator-=(unsigned int DecrementValue)
 // - 'Index' is the index of the element to be accessed in the Plan.
 //
 // [POST]:
-// - Returns a reference to the element at the specified 'Index' in the Plan.
+// - Returns a const reference to the element at the specified 'Index' in the Plan.
+// - Compiled programs stay valid {[SEE]: Plan::operator[](size_t) const}.
 //
 // [NOTE]:
 // - This operator[] function is used to directly access elements in the Plan using 'Index'.
-Formula& ExecutablePlan::operator[](size_t Index) const { return Plan::operator[](Index); }
+const Formula& ExecutablePlan::operator[](size_t Index) const { return Plan::operator[](Index); }
+
+// [DESC]: Overloads the subscript operator ([]) for a mutable ExecutablePlan object.
+//
+// [PRE]:
+// - 'Index' is the index of the element to be accessed in the Plan.
+//
+// [POST]:
+// - Returns a reference to the element at the specified 'Index' in the Plan.
+// - Programs compiled from the Plan no longer match it {[SEE]: Plan::operator[](size_t)}.
+Formula& ExecutablePlan::operator[](size_t Index) { return Plan::operator[](Index); }
 }//[NAMESPACE]: ResourceConversion
\ No newline at end of file
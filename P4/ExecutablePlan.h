@@ -18,6 +18,9 @@
 //          - 3.0 [28/10/23] Debugging, Removing unnecesary allocations
 //          - 4.0 [29/10/23] Refine documentation, fix error formatting
 //          - 5.0 [29/10/23] More Debugging (std::move())
+//          - 6.0 [16/10/2026] Compiled plans {[SEE]: CompiledPlan.h}
+//          - 6.1 [16/10/2026] Parallel execution of independent steps {[SEE]: WorkStealingPool.h}
+//          - 6.2 [16/10/2026] Checkpointed, resumable runs {[SEE]: PlanCheckpoint.h}
 //
 //[INVARIANT]: Step cannot be negative (unsigned int)
 //[INVARIANT]: 'CompletedArray' matches the 'FormulaArray' size
@@ -87,27 +90,42 @@
 #include <memory>
 #include <utility>
 #include <optional>
+#include <limits>
+#include <vector>
 
 #include "Plan.h"
 #include "Formula.h"
 #include "Stockpile.h"
+#include "CompiledPlan.h"
+#include "WorkStealingPool.h"
 
 namespace ResourceConversion
 {
+  class PlanCheckpoint;
+
   class ExecutablePlan : public Plan
   {
   private:
     unsigned int Step = 0;
     bool* CompletedArray = nullptr;
     size_t CompletedArraySize = 0;
+    size_t CompletedArrayCapacity = 0;
     
     inline void ClearXPlan ();
     inline void CopyXPlanData (const ExecutablePlan& other);
     inline void ResetXPlan ();
-    inline void ReassignDataXPlan(ExecutablePlan&& other) const;
+    inline void ReassignDataXPlan(ExecutablePlan&& other);
     inline void SwapDataXPlan(ExecutablePlan&& other);
     
     inline void PushArrayValue(const bool& Value);
+
+    //[NOTE]: Register value of a resource that is not part of the Stockpile {[SEE]: CompiledPlan.h}
+    static constexpr size_t AbsentRegister = std::numeric_limits<size_t>::max();
+
+    inline void CheckProgram(const CompiledPlan& Program, const std::shared_ptr<Stockpile>& StockpilePtr) const;
+    static inline void LoadRegisters(const CompiledPlan& Program, const Stockpile& Source, std::vector<size_t>& Loaded, std::vector<size_t>& Registers);
+    void RunCompiledStep(const CompiledPlan& Program, size_t Index, size_t* Registers);
+    static inline void StoreRegisters(const CompiledPlan& Program, Stockpile& Target, const std::vector<size_t>& Loaded, const std::vector<size_t>& Registers);
     
   public:
     explicit ExecutablePlan();
@@ -121,10 +139,21 @@ namespace ResourceConversion
     ExecutablePlan& operator=(ExecutablePlan&& other) noexcept;
     
     void AddFormula(const Formula &NewFormula) override;
+    void AddFormula(Formula &&NewFormula) override;
     void RemoveLastFormula() override;
     void ReplaceFormula(const Formula& NewFormula, const size_t &Index) override;
     void PlanApply() override;
     std::shared_ptr<Stockpile> PlanApply(const std::shared_ptr<Stockpile>& StockpilePtr);
+    bool ApplyStepTo(size_t Index, Stockpile& Target);
+
+    CompiledPlan Compile(const Stockpile& Target) const;
+    std::shared_ptr<Stockpile> PlanApply(const CompiledPlan& Program, const std::shared_ptr<Stockpile>& StockpilePtr);
+    std::shared_ptr<Stockpile> PlanApply(const CompiledPlan& Program, const std::shared_ptr<Stockpile>& StockpilePtr, WorkStealingPool& Pool);
+    std::shared_ptr<Stockpile> PlanApply(const std::shared_ptr<Stockpile>& StockpilePtr, PlanCheckpoint& Log, size_t Interval);
+
+    inline unsigned int GetStep() const { return Step; }
+    inline bool IsCompleted(size_t Index) const { return Index < CompletedArraySize && CompletedArray[Index]; }
+    void RestoreProgress(unsigned int Step_, Span<const bool> Completed);
 
     //[OPERATORS]:
     bool operator!=(const ExecutablePlan& other) const;
@@ -150,7 +179,8 @@ namespace ResourceConversion
     ExecutablePlan& operator+=(unsigned int IncrementValue);
     ExecutablePlan& operator-=(unsigned int DecrementValue);
 
-    Formula& operator[](size_t Index) const;
+    const Formula& operator[](size_t Index) const;
+    Formula& operator[](size_t Index);
   };
 }//[NAMESPACE]: ResourceConversion
 #endif /* ExecutablePlan_h */
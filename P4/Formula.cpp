@@ -43,13 +43,13 @@ namespace ResourceConversion
 Formula::Formula ()
 {
     InputResourcesSize = 0;
-    InputResources = nullptr;
+    InputResourceIds = nullptr;
     
     InputQuantitiesSize = 0;
     InputQuantities = nullptr;
     
     OutputResourcesSize = 0;
-    InputResources = nullptr;
+    OutputResourceIds = nullptr;
     
     OutputQuantitiesSize = 0;
     OutputQuantities = nullptr;
@@ -83,7 +83,9 @@ Formula::Formula ()
 //[POST]: A new Formula object is created with member variables initialized as follows:
 //          - InputResources and InputQuantities are initialized based on the provided arrays.
 //          - OutputResources and OutputQuantities are initialized based on the provided arrays.
-//          - ResultArray is allocated based on the size of OutputQuantities.
+//          - Resource names are interned into 'ResourceId' values. The Formula takes ownership of
+//            every array passed in, copies the values into a new 'FormulaRecipe' (and its own
+//            'ResultArray') and releases them.
 //          - ProficiencyLevel is set to the provided value.
 //
 //[THROW]: std::invalid_argument if any preconditions are violated.
@@ -114,26 +116,72 @@ Formula::Formula (std::string* InputResources_, size_t InputResourcesSize_,
         throw std::invalid_argument ("[F]Formula(...): [ProficiencyLevel must not exceed 5]");
     }
     
-    this->InputResourcesSize = InputResourcesSize_;
-    this->InputResources = InputResources_;
+    Recipe = std::make_shared<FormulaRecipe> (InputResourcesSize_, OutputResourcesSize_);
+    BindRecipe ();
+    AllocateResults ();
+
+    InternResources (InputResources_, InputResourcesSize_, InputResourceIds);
+    delete[] InputResources_;
     InputResources_ = nullptr;
     
-    this->InputQuantitiesSize = InputQuantitiesSize_;
-    this->InputQuantities = InputQuantities_;
+    std::copy (InputQuantities_, InputQuantities_ + InputQuantitiesSize_, InputQuantities);
+    delete[] InputQuantities_;
     InputQuantities_ = nullptr;
     
-    this->OutputResourcesSize = OutputResourcesSize_;
-    this->OutputResources = OutputResources_;
+    InternResources (OutputResources_, OutputResourcesSize_, OutputResourceIds);
+    delete[] OutputResources_;
     OutputResources_ = nullptr;
     
-    this->OutputQuantitiesSize = OutputQuantitiesSize_;
-    this->OutputQuantities = OutputQuantities_;
+    std::copy (OutputQuantities_, OutputQuantities_ + OutputQuantitiesSize_, OutputQuantities);
+    delete[] OutputQuantities_;
     OutputQuantities_ = nullptr;
     
-    this->ResultArray = ResultArray_;
+    if (ResultArray_ != nullptr)
+    {
+        std::copy (ResultArray_, ResultArray_ + OutputQuantitiesSize_, ResultArray);
+    }
+    delete[] ResultArray_;
     ResultArray_ = nullptr;
 }
 
+//[DESC]: Constructor for the Formula class, from resource ids that are already interned.
+//
+//[PARAM]: Recipe_ The ids and quantities of both sides, copied into a new 'FormulaRecipe'.
+//[PARAM]: ProficencyLevel_ The proficiency level of the formula (0 to 5).
+//
+//[PRE]: - Every id was handed out by the 'ResourceRegistry'.
+//       - The id and quantity spans of a side have the same length.
+//       - ProficencyLevel_ must not exceed 5.
+//
+//[POST]: The Formula holds the given recipe and zeroed results. No name is hashed, so this is the
+//        cheap way to rebuild formulas that were stored by id {[SEE]: PlanArchive.h}.
+//
+//[THROW]: std::invalid_argument if any preconditions are violated.
+Formula::Formula (const ResourceView& Recipe_, unsigned int ProficencyLevel_)
+{
+    if (Recipe_.InputResources.size () != Recipe_.InputQuantities.size ()) {
+        throw std::invalid_argument ("[F]Formula(...): [lengths of [IN] -> Resources array doesn't match the [IN] -> Quantity array]");
+    }
+
+    if (Recipe_.OutputResources.size () != Recipe_.OutputQuantities.size ()) {
+        throw std::invalid_argument ("[F]Formula(...): [lengths of [OUT] -> Resources array doesn't match the [OUT] -> Quantity array]");
+    }
+
+    if (ProficencyLevel_ > 5) {
+        throw std::invalid_argument ("[F]Formula(...): [ProficiencyLevel must not exceed 5]");
+    }
+
+    Recipe = std::make_shared<FormulaRecipe> (Recipe_.InputResources.size (), Recipe_.OutputResources.size ());
+    BindRecipe ();
+    AllocateResults ();
+
+    std::copy (Recipe_.InputResources.begin (), Recipe_.InputResources.end (), InputResourceIds);
+    std::copy (Recipe_.InputQuantities.begin (), Recipe_.InputQuantities.end (), InputQuantities);
+    std::copy (Recipe_.OutputResources.begin (), Recipe_.OutputResources.end (), OutputResourceIds);
+    std::copy (Recipe_.OutputQuantities.begin (), Recipe_.OutputQuantities.end (), OutputQuantities);
+    ProficiencyLevel = ProficencyLevel_;
+}
+
 //[DESC]: Destructor for the Formula class, cleaning up resources.
 //
 //[PRE]: None.
@@ -148,8 +196,9 @@ Formula::~Formula () { ClearContainer (); }
 //
 //[PRE]: None.
 //
-//[POST]: A new Formula object is created as a deep copy of the provided 'other' Formula object.
-//        Both objects will have independent copies of data.
+//[POST]: A new Formula object shares the recipe of 'other' and holds its own copy of the results and
+//        proficiency level. The recipe is cloned on the first write to either Formula (copy-on-write
+//        {[SEE]: 'DetachRecipe()'}), so neither ever sees a change made through the other.
 Formula::Formula (const Formula& other) { CopyData (other); }
 
 //[DESC]: Copy assignment operator for the Formula class, assigning the data of another Formula object.
@@ -158,8 +207,9 @@ Formula::Formula (const Formula& other) { CopyData (other); }
 //
 //[PRE]: None.
 //
-//[POST]: The current Formula object is assigned the data (deep copy) from the 'other' Formula object.
-//        Both objects will have independent copies of data.
+//[POST]: The current Formula object releases its data, then shares the recipe of 'other' and holds its
+//        own copy of the results and proficiency level. The recipe is cloned on the first write to
+//        either Formula (copy-on-write {[SEE]: 'DetachRecipe()'}).
 [[nodiscard]]Formula& Formula::operator=(const Formula& other)
 {
     if (this == &other) { return *this; }
@@ -184,7 +234,6 @@ Formula::Formula (const Formula& other) { CopyData (other); }
 Formula::Formula (Formula&& other) noexcept
 {
     ReassignData(std::move(other));
-    ResetContainer ();
 }
 
 //[DESC]: Move assignment operator for the Formula class, transferring ownership of resources from
@@ -204,55 +253,83 @@ Formula::Formula (Formula&& other) noexcept
 [[nodiscard]]Formula& Formula::operator=(Formula&& other) noexcept
 {
     if (this == &other) { return *this; }
-    SwapData(std::move(other));
+    ClearContainer ();
+    ReassignData(std::move(other));
     return *this;
 }
 
-//[DESC]: Copies data from another Formula object to the current object.
-//
-//[PARAM]: other The Formula object from which data is to be copied.
+//[DESC]: Points the array members at the sections of 'Recipe' and sets the sizes from it.
 //
-//[PRE]: The 'other' Formula object must be valid and contain data.
+//[PRE]: None.
 //
-//[POST]: The data from the 'other' Formula object is copied to the current object.
-//        The current object's member variables are updated with deep copies of the 'other' object's
-//        data.
-void Formula::CopyData (const Formula& other)
+//[POST]: The id and quantity arrays point into 'Recipe', or are all nullptr if there is no recipe.
+inline void Formula::BindRecipe ()
 {
-    InputResourcesSize = other.InputResourcesSize;
-    InputResources = new (std::nothrow) std::string[InputResourcesSize];
-    for (size_t i = 0; i < InputResourcesSize; ++i)
+    if (Recipe == nullptr)
     {
-        InputResources[i] = other.InputResources[i];
+        InputResourceIds = InputQuantities = OutputResourceIds = OutputQuantities = nullptr;
+        InputResourcesSize = InputQuantitiesSize = OutputResourcesSize = OutputQuantitiesSize = 0;
+        return;
     }
-    
-    InputQuantitiesSize = other.InputQuantitiesSize;
-    InputQuantities = new (std::nothrow) unsigned int[InputQuantitiesSize];
-    for (size_t i = 0; i < InputQuantitiesSize; ++i)
-    {
-        InputQuantities[i] = other.InputQuantities[i];
-    }
-    
-    OutputResourcesSize = other.OutputResourcesSize;
-    OutputResources = new (std::nothrow) std::string[OutputResourcesSize];
-    for (size_t i = 0; i < OutputResourcesSize; ++i)
+    InputResourcesSize = InputQuantitiesSize = Recipe -> GetInputsSize ();
+    OutputResourcesSize = OutputQuantitiesSize = Recipe -> GetOutputsSize ();
+    InputResourceIds = Recipe -> InputIds ();
+    InputQuantities = Recipe -> InputQuantities ();
+    OutputResourceIds = Recipe -> OutputIds ();
+    OutputQuantities = Recipe -> OutputQuantities ();
+}
+
+//[DESC]: Points 'ResultArray' at storage for 'OutputQuantitiesSize' results.
+//
+//[PRE]: The Formula holds no result storage, 'BindRecipe()' was called.
+//
+//[POST]: 'ResultArray' is 'InlineResults' if the results fit, otherwise a heap array. Every result
+//        is 0. Without a recipe 'ResultArray' stays nullptr.
+inline void Formula::AllocateResults ()
+{
+    if (Recipe == nullptr)
     {
-        OutputResources[i] = other.OutputResources[i];
+        ResultArray = nullptr;
+        return;
     }
-    
-    OutputQuantitiesSize = other.OutputQuantitiesSize;
-    OutputQuantities = new (std::nothrow) unsigned int[OutputQuantitiesSize];
-    for (size_t i = 0; i < OutputQuantitiesSize; ++i)
+    ResultArray = (OutputQuantitiesSize <= InlineOutputs) ? InlineResults : new unsigned int[OutputQuantitiesSize];
+    std::fill (ResultArray, ResultArray + OutputQuantitiesSize, 0u);
+}
+
+//[DESC]: Gives this Formula a recipe of its own before the recipe is modified (copy-on-write).
+//
+//[PRE]: None.
+//
+//[POST]: If the recipe was shared with another Formula, this Formula now holds a private clone and
+//        the array members point into it. The other Formulas are unaffected.
+inline void Formula::DetachRecipe ()
+{
+    if (Recipe != nullptr && Recipe.use_count () > 1)
     {
-        OutputQuantities[i] = other.OutputQuantities[i];
+        Recipe = std::make_shared<FormulaRecipe> (*Recipe);
+        BindRecipe ();
     }
-    
-    ResultArray = new (std::nothrow) unsigned int[OutputQuantitiesSize];
-    for (size_t i = 0; i < OutputQuantitiesSize; ++i)
+}
+
+//[DESC]: Copies data from another Formula object to the current object.
+//
+//[PARAM]: other The Formula object from which data is to be copied.
+//
+//[PRE]: The current object holds no storage.
+//
+//[POST]: The current object shares the recipe of 'other' and holds a copy of its results and
+//        proficiency level.
+//
+//[NOTE]: The recipe is not copied, only its reference count changes {[SEE]: 'DetachRecipe()'}.
+void Formula::CopyData (const Formula& other)
+{
+    Recipe = other.Recipe;
+    BindRecipe ();
+    AllocateResults ();
+    if (ResultArray != nullptr)
     {
-        ResultArray[i] = other.ResultArray[i];
+        std::copy (other.ResultArray, other.ResultArray + OutputQuantitiesSize, ResultArray);
     }
-    
     ProficiencyLevel = other.ProficiencyLevel;
 }
 
@@ -260,92 +337,54 @@ void Formula::CopyData (const Formula& other)
 //
 //[PRE]: None.
 //
-//[POST]: Any dynamically allocated memory and resources used by member variables are released.
-//        Member variables are set to nullptr or appropriate initial values.
+//[POST]: The heap result array, if any, is released and the recipe reference dropped. The Formula
+//        holds no storage and no data.
 inline void Formula::ClearContainer ()
 {
-    if (InputResources != nullptr) {
-        delete[] InputResources;
-        InputResources = nullptr;
-    }
-    
-    if (InputQuantities != nullptr) {
-        delete[] InputQuantities;
-        InputQuantities = nullptr;
-    }
-    
-    if (OutputResources != nullptr) {
-        delete[] OutputResources;
-        OutputResources = nullptr;
-    }
-    
-    if (OutputQuantities != nullptr) {
-        delete[] OutputQuantities;
-        OutputQuantities = nullptr;
-    }
-    
-    if (ResultArray != nullptr) {
+    if (ResultArray != nullptr && !UsesInlineResults ())
+    {
         delete[] ResultArray;
-        ResultArray = nullptr;
     }
+    ResetContainer ();
 }
 
-//[DESC]: Resets the member variables of another Formula object.
-//
-//[PARAM]: other The Formula object whose member variables are to be reset.
+//[DESC]: Resets the member variables of the Formula without releasing the result array.
 //
-//[PRE]: The 'other' Formula object must be valid.
+//[PRE]: None.
 //
-//[POST]: The member variables of the 'other' Formula object are set to nullptr or appropriate initial
-//        values.
+//[POST]: The member variables are set to nullptr or appropriate initial values.
 inline void Formula::ResetContainer ()
 {
-    InputResources = nullptr;
-    OutputResources = nullptr;
-    InputQuantities = nullptr;
-    OutputQuantities = nullptr;
+    Recipe.reset ();
+    BindRecipe ();
     ResultArray = nullptr;
-    
-    InputResourcesSize = 0;
-    InputQuantitiesSize = 0;
-    OutputResourcesSize = 0;
-    OutputQuantitiesSize = 0;
-    
     ProficiencyLevel = 0;
 }
 
-inline void Formula::SwapData(Formula &&other) 
+//[DESC]: Takes over the data of another Formula object.
+//
+//[PARAM]: other The Formula object to move from.
+//
+//[PRE]: The current object holds no storage.
+//
+//[POST]: The recipe reference and a heap result array change owner, inline results are copied.
+//        'other' is left empty.
+inline void Formula::ReassignData(Formula &&other)
 {
-    std::swap(other.InputResources, InputResources);
-    std::swap(other.InputQuantities, InputQuantities);
-    std::swap(other.OutputResources, OutputResources);
-    std::swap(other.OutputQuantities, OutputQuantities);
-    
-    std::swap(other.ResultArray, ResultArray);
-    
-    std::swap(other.InputResourcesSize, InputResourcesSize);
-    std::swap(other.InputQuantitiesSize, InputQuantitiesSize);
-    std::swap(other.OutputResourcesSize, OutputResourcesSize);
-    std::swap(other.OutputQuantitiesSize, OutputQuantitiesSize);
-    
-    std::swap(other.ProficiencyLevel, ProficiencyLevel);
-}
+    Recipe = std::move (other.Recipe);
+    BindRecipe ();
+    ProficiencyLevel = other.ProficiencyLevel;
 
-inline void Formula::ReassignData(Formula &&other) const
-{
-    other.InputResources = InputResources;
-    other.InputQuantities = InputQuantities;
-    other.OutputResources = OutputResources;
-    other.OutputQuantities = OutputQuantities;
-    
-    other.ResultArray = ResultArray;
-    
-    other.InputResourcesSize = InputResourcesSize;
-    other.InputQuantitiesSize = InputQuantitiesSize;
-    other.OutputResourcesSize = OutputResourcesSize;
-    other.OutputQuantitiesSize = OutputQuantitiesSize;
-    
-    other.ProficiencyLevel = ProficiencyLevel;
+    if (other.UsesInlineResults ())
+    {
+        std::copy (other.InlineResults, other.InlineResults + InlineOutputs, InlineResults);
+        ResultArray = InlineResults;
+    }
+    else
+    {
+        ResultArray = other.ResultArray;
+    }
+    other.ResetContainer ();
 }
 
 //[DESC]: Calculates and returns outcome modifiers based on the proficiency level.
@@ -356,7 +395,7 @@ inline void Formula::ReassignData(Formula &&other) const
 //
 //[POST]: Outcome modifiers are calculated based on the proficiency level and returned as an
 //        OutcomeModifiers object.
-inline Formula::OutcomeModifiers Formula::GetOutcomeChances (const unsigned int &Level)
+inline Formula::OutcomeModifiers Formula::GetOutcomeChances (const unsigned int &Level) const
 {
     const float DefaultFailureConst = 0.25f;
     const float DefaultPartialConst = 0.2f;
@@ -405,6 +444,145 @@ inline bool Formula::ContainsNullOrWhiteSpace (const std::string* Array,const si
     return false;
 }
 
+//[DESC]: Interns an array of resource names into an array of identifiers.
+//
+//[PARAM]: Names The array of resource names to be interned.
+//[PARAM]: NamesSize The size of the array.
+//[PARAM]: Destination Receives 'NamesSize' identifiers, parallel to 'Names'.
+//
+//[PRE]: 'Names' must point to a valid array of 'NamesSize' strings.
+//
+//[POST]: Every name is present in the 'ResourceRegistry'.
+inline void Formula::InternResources (const std::string* Names, const size_t &NamesSize, ResourceId* Destination)
+{
+    ResourceRegistry& Registry = ResourceRegistry::Instance();
+    for (size_t i = 0; i < NamesSize; ++i)
+    {
+        Destination[i] = Registry.Intern (Names[i]);
+    }
+}
+
+//[DESC]: Get the name of an input resource.
+//[PARAM]: Index The position of the resource in the input array.
+//[PRE]: Index should be within the valid range [0, InputResourcesSize - 1].
+//[THROW]: std::out_of_range if Index is out of range.
+//[RETURN]: The interned name of the resource.
+const std::string& Formula::GetInputResourceName(size_t Index) const
+{
+    if (Index >= InputResourcesSize) { throw std::out_of_range ("[F]GetInputResourceName(...): [Index out of range]"); }
+    return ResourceRegistry::Instance().GetName (InputResourceIds[Index]);
+}
+
+//[DESC]: Get the name of an output resource.
+//[PARAM]: Index The position of the resource in the output array.
+//[PRE]: Index should be within the valid range [0, OutputResourcesSize - 1].
+//[THROW]: std::out_of_range if Index is out of range.
+//[RETURN]: The interned name of the resource.
+const std::string& Formula::GetOutputResourceName(size_t Index) const
+{
+    if (Index >= OutputResourcesSize) { throw std::out_of_range ("[F]GetOutputResourceName(...): [Index out of range]"); }
+    return ResourceRegistry::Instance().GetName (OutputResourceIds[Index]);
+}
+
+//[DESC]: Maps a random draw onto an outcome, based on the chance modifiers.
+//
+//[PARAM]: RandomValue The draw, in [0, 1] and rounded to two decimals.
+//[PARAM]: Chances The outcome modifiers for the current proficiency level.
+//
+//[PRE]: None.
+//
+//[POST]: None.
+//
+//[RETURN]: The outcome whose range contains 'RandomValue'. The ranges may overlap at higher
+//          proficiency levels; the outcome checked last in 'Apply' wins, so 'Normal' takes
+//          precedence over 'Bonus'. A draw on a range boundary is 'Unchanged'.
+inline Formula::Outcome Formula::ClassifyOutcome (float RandomValue, const OutcomeModifiers& Chances) const
+{
+    float ChanceOfFailure = Chances.Failure;
+    float ChanceOfPartial = Chances.Partial;
+    float ChanceOfBonus = Chances.Bonus;
+    float ChanceOfNormal = Chances.Normal;
+    
+    constexpr unsigned int UpperBound = 1;
+
+    //Normal Out -> 0.5
+    if (RandomValue > (ChanceOfFailure + ChanceOfBonus + ChanceOfPartial) &&
+        RandomValue < static_cast<double>(UpperBound))
+    {
+        return Outcome::Normal;
+    }
+    
+    //Bonus Out -> 0.05
+    if (RandomValue > (ChanceOfPartial + ChanceOfFailure) &&
+        RandomValue < ChanceOfNormal)
+    {
+        return Outcome::Bonus;
+    }
+    
+    //Partial Out -> 0.2
+    if (RandomValue > ChanceOfFailure &&
+        RandomValue < (ChanceOfPartial + ChanceOfFailure))
+    {
+        return Outcome::Partial;
+    }
+
+    //Failure Out -> 0.25
+    if (RandomValue < ChanceOfFailure)
+    {
+        return Outcome::Failure;
+    }
+    return Outcome::Unchanged;
+}
+
+//[DESC]: Writes the output quantities produced by an outcome.
+//
+//[PARAM]: Result The outcome to be written.
+//[PARAM]: Destination Array of 'OutputQuantitiesSize' elements receiving the quantities.
+//
+//[PRE]: 'Destination' must hold at least 'OutputQuantitiesSize' elements.
+//
+//[POST]: 'Destination' holds the produced quantities. It is left untouched for 'Outcome::Unchanged'.
+inline void Formula::WriteOutcome (Outcome Result, unsigned int* Destination) const
+{
+    constexpr unsigned int FailedValue = 0;
+    constexpr float BonusConstModifier = 1.1f;
+    constexpr float PartialConstModifier = 0.75f;
+
+    switch (Result)
+    {
+        case Outcome::Failure:
+            for (size_t i = 0; i < OutputQuantitiesSize; ++i)
+            {
+                Destination[i] = FailedValue;
+            }
+            break;
+
+        case Outcome::Partial:
+            for (size_t i = 0; i < OutputQuantitiesSize; ++i)
+            {
+                Destination[i] = static_cast<unsigned int>(std::floor (static_cast<float>(OutputQuantities[i]) * PartialConstModifier));
+            }
+            break;
+
+        case Outcome::Bonus:
+            for (size_t i = 0; i < OutputQuantitiesSize; ++i)
+            {
+                Destination[i] = static_cast<unsigned int>(std::ceil (static_cast<float>(OutputQuantities[i]) * BonusConstModifier));
+            }
+            break;
+
+        case Outcome::Normal:
+            for (size_t i = 0; i < OutputQuantitiesSize; ++i)
+            {
+                Destination[i] = OutputQuantities[i];
+            }
+            break;
+
+        case Outcome::Unchanged:
+            break;
+    }
+}
+
 //[DESC]: Applies the formula and computes the outcome based on proficiency level and chance modifiers.
 //
 //[PRE]: The Formula object must be properly initialized with valid data and proficiency level.
@@ -413,40 +591,37 @@ inline bool Formula::ContainsNullOrWhiteSpace (const std::string* Array,const si
 //        chance modifiers.
 //        The 'ResultArray' member variable is updated with the computed outcome.
 //        The function does not modify other member variables or external state.
+//
+//[NOTE]: Draws from the calling thread's engine {[SEE]: RandomEngine.h 'ThreadLocalEngine()'}, use
+//        'Apply(Engine&)' with a seeded engine for reproducible results.
 void Formula::Apply ()
+{
+    Apply (ThreadLocalEngine ());
+}
+
+//[DESC]: Applies the formula for one uniform draw.
+//
+//[PARAM]: RawValue A uniform value in [0, 1), rounded to two decimals before it is classified.
+//
+//[PRE]: The Formula object must be properly initialized with valid data and proficiency level.
+//
+//[POST]: The 'ResultArray' member variable is updated with the computed outcome and the
+//        proficiency level is raised.
+//
+//[THROW]: std::invalid_argument if the formula holds no data.
+void Formula::ApplyDraw (float RawValue)
 {
     if (InputQuantities == nullptr  || 
         OutputQuantities == nullptr || 
-        InputResources == nullptr   || 
-        OutputResources == nullptr) 
+        InputResourceIds == nullptr || 
+        OutputResourceIds == nullptr) 
     {
         throw std::invalid_argument("[F]Apply(): [Attempting to dereference nullptr in the 'Apply' Method]");
     }
     OutcomeModifiers OutcomeChances = GetOutcomeChances (ProficiencyLevel);
     
-    float ChanceOfFailure = OutcomeChances.Failure;
-    float ChanceOfPartial = OutcomeChances.Partial;
-    float ChanceOfBonus = OutcomeChances.Bonus;
-    float ChanceOfNormal = OutcomeChances.Normal;
-    
-    constexpr unsigned int UpperBound = 1;
-    
-    constexpr unsigned int FailedArraySize = 1;
-    constexpr unsigned int FailedValue = 0;
-    
-    float RandomValue = 0.0f;
-    
     unsigned int Count = 0;
 
-    auto GetRandomFloat = [this, RandomValue]() mutable -> float {
-        std::random_device RandomDevice;
-        std::mt19937 Generator(RandomDevice());
-        std::uniform_real_distribution<float> Distribution (0.0f, 1.0f);
-        
-        RandomValue = Distribution (Generator);
-        return std::round (RandomValue * 100.0f) / 100.0f;
-    };
-    
     auto IncrementProficiencyLevel = [this, Count]() -> void {
         if(Count % 5 == 0 && ProficiencyLevel <= 5) 
         {
@@ -454,48 +629,199 @@ void Formula::Apply ()
         }
     };
 
-    constexpr float BonusConstModifier = 1.1f;
-    constexpr float PartialConstModifier = 0.75f;
-    
-    RandomValue = GetRandomFloat();
-    
-    //Failure Out -> 0.25
-    if (RandomValue < ChanceOfFailure)
+    float RandomValue = std::round (RawValue * 100.0f) / 100.0f;
+    WriteOutcome (ClassifyOutcome (RandomValue, OutcomeChances), ResultArray);
+
+    Count++;
+    IncrementProficiencyLevel();
+}
+
+//[DESC]: Computes the outcome of one uniform draw without modifying the formula.
+//
+//[PARAM]: RawValue A uniform value in [0, 1), rounded to two decimals before it is classified.
+//[PARAM]: Destination Receives 'OutputQuantitiesSize' produced quantities.
+//
+//[PRE]: The Formula object must be properly initialized with valid data and proficiency level.
+//
+//[POST]: 'Destination' holds the produced quantities. An 'Unchanged' draw copies the current
+//        'ResultArray', which is what 'Apply' would have left in place.
+//
+//[THROW]: std::invalid_argument if the formula holds no data.
+//
+//[RETURN]: The outcome of the draw.
+Formula::Outcome Formula::EvaluateDraw (float RawValue, unsigned int* Destination) const
+{
+    if (InputQuantities == nullptr  || 
+        OutputQuantities == nullptr || 
+        InputResourceIds == nullptr || 
+        OutputResourceIds == nullptr) 
     {
-        std::memset (ResultArray, FailedValue, FailedArraySize);
+        throw std::invalid_argument("[F]Evaluate(...): [Attempting to dereference nullptr in the 'Evaluate' Method]");
     }
-    
-    //Partial Out -> 0.2
-    if (RandomValue > ChanceOfFailure &&
-        RandomValue < (ChanceOfPartial + ChanceOfFailure))
+
+    for (size_t i = 0; i < OutputQuantitiesSize; ++i)
+    {
+        Destination[i] = (ResultArray != nullptr) ? ResultArray[i] : 0;
+    }
+    Outcome Result = ClassifyDraw (RawValue, GetOutcomeChances (ProficiencyLevel));
+    WriteOutcome (Result, Destination);
+    return Result;
+}
+
+//[DESC]: Runs 'Trials' independent applications of the formula and aggregates the outcomes.
+//
+//[PARAM]: Trials The number of independent draws.
+//[PARAM]: Results Receives the outcome histogram and the summed output quantities.
+//
+//[PRE]: The Formula object must be properly initialized with valid data and proficiency level.
+//
+//[POST]: 'Results.Histogram' counts the trials per outcome and 'Results.OutputTotals' holds
+//        'OutputQuantitiesSize' sums of the produced quantities. An 'Unchanged' trial contributes
+//        the current 'ResultArray', which is what 'Apply' would have left in place.
+//        The Formula itself is not modified, all trials use the current proficiency level.
+//
+//[THROW]: std::invalid_argument if the formula holds no data.
+//
+//[NOTE]: Unlike 'Apply', a single engine is seeded once and drawn from for every trial. The yield
+//        of an outcome does not depend on the draw, so the per-trial work is classifying the draw;
+//        the totals are computed once per outcome from the histogram.
+void Formula::ApplyBatch (std::size_t Trials, BatchResult& Results) const
+{
+    Xoshiro256StarStar Generator (ThreadLocalEngine () ());
+    ApplyBatch (Trials, Results, Generator);
+}
+
+//[DESC]: Validates the formula and resets 'Results' before a batch.
+//[PARAM]: Results The batch result to be reset.
+//[PRE]: None.
+//[POST]: 'Results' holds an all-zero histogram and 'OutputQuantitiesSize' zero totals.
+//[THROW]: std::invalid_argument if the formula holds no data.
+//[RETURN]: The outcome modifiers for the current proficiency level.
+Formula::OutcomeModifiers Formula::BeginBatch (BatchResult& Results) const
+{
+    if (InputQuantities == nullptr  || 
+        OutputQuantities == nullptr || 
+        InputResourceIds == nullptr || 
+        OutputResourceIds == nullptr) 
     {
+        throw std::invalid_argument("[F]ApplyBatch(...): [Attempting to dereference nullptr in the 'ApplyBatch' Method]");
+    }
+
+    Results.Histogram.fill (0);
+    Results.OutputTotals.assign (OutputQuantitiesSize, 0);
+    return GetOutcomeChances (ProficiencyLevel);
+}
+
+//[DESC]: Rounds a uniform draw the same way 'Apply' does and classifies it.
+//[PARAM]: RawValue A uniform value in [0, 1).
+//[PARAM]: Chances The outcome modifiers for the current proficiency level.
+//[RETURN]: The outcome of the draw.
+Formula::Outcome Formula::ClassifyDraw (float RawValue, const OutcomeModifiers& Chances) const
+{
+    return ClassifyOutcome (std::round (RawValue * 100.0f) / 100.0f, Chances);
+}
+
+//[DESC]: Converts the histogram of a batch into the summed output quantities.
+//[PARAM]: Results The batch result holding a filled histogram.
+//[PRE]: 'BeginBatch(Results)' was called and the histogram was filled.
+//[POST]: 'Results.OutputTotals' holds the summed yield of every output resource.
+void Formula::FinishBatch (BatchResult& Results) const
+{
+    std::vector<unsigned int> Yield (OutputQuantitiesSize, 0);
+    for (size_t k = 0; k < OutcomeCount; ++k)
+    {
+        if (Results.Histogram[k] == 0) { continue; }
+
         for (size_t i = 0; i < OutputQuantitiesSize; ++i)
         {
-            ResultArray[i] = static_cast<unsigned int>(std::floor (static_cast<float>(OutputQuantities[i]) * PartialConstModifier));
+            Yield[i] = (ResultArray != nullptr) ? ResultArray[i] : 0;
         }
-    }
-    
-    //Bonus Out -> 0.05
-    if (RandomValue > (ChanceOfPartial + ChanceOfFailure) &&
-        RandomValue < ChanceOfNormal)
-    {
+        WriteOutcome (static_cast<Outcome>(k), Yield.data ());
+
         for (size_t i = 0; i < OutputQuantitiesSize; ++i)
         {
-            ResultArray[i] = static_cast<unsigned int>(std::ceil (static_cast<float>(OutputQuantities[i]) * BonusConstModifier));
+            Results.OutputTotals[i] += Results.Histogram[k] * Yield[i];
         }
     }
-    
-    //Normal Out -> 0.5
-    if (RandomValue > (ChanceOfFailure + ChanceOfBonus + ChanceOfPartial) &&
-        RandomValue < static_cast<double>(UpperBound))
+}
+
+//[DESC]: Puts back the state a Formula built up by being applied {[SEE]: PlanCheckpoint.h}.
+//
+//[PARAM]: Level The proficiency level, as returned by 'GetProficiencyLevel()'.
+//[PARAM]: Results The result array, 'GetOutputResourcesSize()' values.
+//
+//[PRE]: None.
+//
+//[POST]: The Formula applies and evaluates exactly as the Formula the state was read from.
+//
+//[THROW]: std::invalid_argument if Level is above what applying can reach.
+void Formula::RestoreProgress (unsigned int Level, const unsigned int* Results)
+{
+    if (Level > 6)
+    {
+        throw std::invalid_argument ("[F]RestoreProgress(...): [ProficiencyLevel must not exceed 6]");
+    }
+
+    ProficiencyLevel = Level;
+    if (ResultArray != nullptr && Results != nullptr)
+    {
+        std::copy (Results, Results + OutputResourcesSize, ResultArray);
+    }
+}
+
+//[DESC]: Computes the expected quantity of every output of one application.
+//
+//[PARAM]: Destination Receives 'OutputQuantitiesSize' expected quantities.
+//
+//[PRE]: The Formula object must be properly initialized with valid data and proficiency level.
+//
+//[POST]: 'Destination[i]' is the mean of what 'Apply' would write to 'ResultArray[i]', at the
+//        current proficiency level. The Formula itself is not modified.
+//
+//[THROW]: std::invalid_argument if the formula holds no data.
+//
+//[NOTE]: A draw is rounded to two decimals before it is classified, so there are only 101 distinct
+//        draws: k / 100 has probability 1/100, the two ends (0 and 1) 1/200. They are enumerated
+//        instead of sampled, the result is exact up to the 2^-24 resolution of a draw.
+void Formula::ExpectedOutputs (double* Destination) const
+{
+    if (InputQuantities == nullptr  || 
+        OutputQuantities == nullptr || 
+        InputResourceIds == nullptr || 
+        OutputResourceIds == nullptr) 
+    {
+        throw std::invalid_argument("[F]ExpectedOutputs(...): [Attempting to dereference nullptr in the 'ExpectedOutputs' Method]");
+    }
+
+    constexpr int Draws = 100;
+    const OutcomeModifiers Chances = GetOutcomeChances (ProficiencyLevel);
+    std::array<double, OutcomeCount> Probability{};
+    for (int k = 0; k <= Draws; ++k)
+    {
+        const double Weight = (k == 0 || k == Draws) ? 0.5 / Draws : 1.0 / Draws;
+        Probability[static_cast<size_t>(ClassifyOutcome (static_cast<float>(k) / 100.0f, Chances))] += Weight;
+    }
+
+    std::vector<unsigned int> Yield (OutputQuantitiesSize, 0);
+    for (size_t i = 0; i < OutputQuantitiesSize; ++i)
+    {
+        Destination[i] = 0.0;
+    }
+    for (size_t k = 0; k < OutcomeCount; ++k)
     {
+        if (Probability[k] == 0.0) { continue; }
+
         for (size_t i = 0; i < OutputQuantitiesSize; ++i)
         {
-            ResultArray[i] = OutputQuantities[i];
+            Yield[i] = (ResultArray != nullptr) ? ResultArray[i] : 0;
+        }
+        WriteOutcome (static_cast<Outcome>(k), Yield.data ());
+
+        for (size_t i = 0; i < OutputQuantitiesSize; ++i)
+        {
+            Destination[i] += Probability[k] * Yield[i];
         }
     }
-    Count++;
-    IncrementProficiencyLevel();
 }
 
 //[DESC]: Displays the values of input and output resources for the Formula.
@@ -529,6 +855,8 @@ void Formula::DisplayFormulaValues(const bool PrintResultArray) const
 
     const std::string RESET = "\033[0m";
 
+    const ResourceRegistry& Registry = ResourceRegistry::Instance();
+
     auto IsResultArrayZero = [this]() -> bool {
         if(ResultArray[0] == 0)
         {
@@ -550,7 +878,7 @@ void Formula::DisplayFormulaValues(const bool PrintResultArray) const
         
         for(size_t i = 0; i < InputResourcesSize; i++)
         {
-            std::cout  << "{" << InputResources[i] << "} : {" << YELLOW << InputQuantities[i] << RESET << "}";
+            std::cout  << "{" << Registry.GetName(InputResourceIds[i]) << "} : {" << YELLOW << InputQuantities[i] << RESET << "}";
         }
         std::cout  << BLUE << "]>" << RESET << GREEN << " <-+-> " << RESET << BLUE << " <[" << RESET;
         
@@ -560,9 +888,9 @@ void Formula::DisplayFormulaValues(const bool PrintResultArray) const
         {
             if(PrintResultArray && ResultArray != nullptr)
             {
-                std::cout  << "{" << OutputResources[i] << RESET << "} : {" << YELLOW << ResultArray[i] << RESET << "}";
+                std::cout  << "{" << Registry.GetName(OutputResourceIds[i]) << RESET << "} : {" << YELLOW << ResultArray[i] << RESET << "}";
             } else {
-                std::cout  << "{" << OutputResources[i] << RESET << "} : {" << YELLOW << OutputQuantities[i] << RESET << "}";
+                std::cout  << "{" << Registry.GetName(OutputResourceIds[i]) << RESET << "} : {" << YELLOW << OutputQuantities[i] << RESET << "}";
             }
         }
         std::cout << BLUE << "]>" << RESET << "\n";
@@ -579,10 +907,10 @@ void Formula::DisplayFormulaValues(const bool PrintResultArray) const
 // - size_t SecondArraySize: Size of the second array.
 //
 //[RETURN]: Returns a boolean value (true if arrays are equal, false if not).
-//[NOTE]: This function is templated to work with either unsigned int or std::string arrays.
-//[TEMPLATE]: Enables 'T' if 'T' is either a 'std::string' or a 'size_t'
+//[NOTE]: This function is templated to work with either unsigned int or ResourceId arrays.
+//[TEMPLATE]: Enables 'T' if 'T' is either an 'unsigned int' or a 'ResourceId'
 template<typename T>
-typename std::enable_if<std::is_same<T, unsigned int>::value || std::is_same<T, std::string>::value, bool>::type 
+typename std::enable_if<std::is_same<T, unsigned int>::value || std::is_same<T, ResourceId>::value, bool>::type 
 inline Formula::ArraysAreEqual(T* First, T* Second, size_t FirstArraySize, size_t SecondArraySize) const
 {
     if(FirstArraySize != SecondArraySize) { return false; }
@@ -656,8 +984,8 @@ bool Formula::operator==(const Formula& other) const
                                         InputQuantitiesSize, 
                                         other.InputQuantitiesSize);
 
-    bool In_Resources = ArraysAreEqual(InputResources, 
-                                       other.InputResources, 
+    bool In_Resources = ArraysAreEqual(InputResourceIds, 
+                                       other.InputResourceIds, 
                                        InputResourcesSize, 
                                        other.InputResourcesSize);
 
@@ -666,8 +994,8 @@ bool Formula::operator==(const Formula& other) const
                                          OutputQuantitiesSize, 
                                          other.OutputQuantitiesSize);
 
-    bool Out_Resources = ArraysAreEqual(OutputResources, 
-                                        other.OutputResources, 
+    bool Out_Resources = ArraysAreEqual(OutputResourceIds, 
+                                        other.OutputResourceIds, 
                                         OutputResourcesSize, 
                                         other.OutputResourcesSize);
 
@@ -699,6 +1027,7 @@ bool Formula::operator!=(const Formula& other) const
 //[NOTE]: This overloaded inequality operator (+) relies on the Increment(...) utility method
 Formula Formula::operator+(unsigned int IncrementValue)
 {
+    DetachRecipe ();
     Increment(InputQuantities, InputQuantitiesSize, IncrementValue);
     Increment(OutputQuantities, OutputQuantitiesSize, IncrementValue);
     return *this;
@@ -712,6 +1041,7 @@ Formula Formula::operator+(unsigned int IncrementValue)
 //[NOTE]: This overloaded inequality operator (+) relies on the Decrement(...) utility method
 Formula Formula::operator-(unsigned int DecrementValue)
 {
+    DetachRecipe ();
     Decrement(InputQuantities, InputQuantitiesSize, DecrementValue);
     Decrement(OutputQuantities, OutputQuantitiesSize, DecrementValue);
     return *this;
@@ -729,6 +1059,7 @@ Formula Formula::operator++(int DummyParameter)
 {
     Formula OldState = *this;
     constexpr unsigned int DefaultIncrementValue = 1;
+    DetachRecipe ();
 
     Increment(InputQuantities, InputQuantitiesSize, DefaultIncrementValue);
     Increment(OutputQuantities, OutputQuantitiesSize, DefaultIncrementValue);
@@ -748,6 +1079,7 @@ Formula Formula::operator--(int DummyParameter)
 {
     Formula OldState = *this;
     constexpr unsigned int DefaultDecrementValue = 1;
+    DetachRecipe ();
 
     Decrement(InputQuantities, InputQuantitiesSize, DefaultDecrementValue);
     Decrement(OutputQuantities, OutputQuantitiesSize, DefaultDecrementValue);
@@ -766,6 +1098,7 @@ Formula Formula::operator--(int DummyParameter)
 Formula& Formula::operator++()
 {
     constexpr unsigned int DefaultIncrementValue = 1;
+    DetachRecipe ();
 
     Increment(InputQuantities, InputQuantitiesSize, DefaultIncrementValue);
     Increment(OutputQuantities, OutputQuantitiesSize, DefaultIncrementValue);
@@ -782,6 +1115,7 @@ Formula& Formula::operator++()
 Formula& Formula::operator--()
 {
     constexpr unsigned int DefaultDecrementValue = 1;
+    DetachRecipe ();
 
     Decrement(InputQuantities, InputQuantitiesSize, DefaultDecrementValue);
     Decrement(OutputQuantities, OutputQuantitiesSize, DefaultDecrementValue);
@@ -800,6 +1134,7 @@ Formula& Formula::operator--()
 //        IncrementValue and returns the current state of the object after the increment.
 Formula& Formula::operator+=(unsigned int IncrementValue)
 {
+    DetachRecipe ();
     Increment(InputQuantities, InputQuantitiesSize, IncrementValue);
     Increment(OutputQuantities, OutputQuantitiesSize, IncrementValue);
     return *this;
@@ -816,6 +1151,7 @@ Formula& Formula::operator+=(unsigned int IncrementValue)
 //        DecrementValue and returns the current state of the object after the decrement.
 Formula& Formula::operator-=(unsigned int DecrementValue)
 {
+    DetachRecipe ();
     Decrement(InputQuantities, InputQuantitiesSize, DecrementValue);
     Decrement(OutputQuantities, OutputQuantitiesSize, DecrementValue);
     return *this;
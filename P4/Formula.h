@@ -16,6 +16,9 @@
 //           - 1.0 [27/10/2023]: Optimisation and Impored Move Semantics
 //           - 2.0 [28/10/2023]: Debugging
 //           - 3.0 [28/10/2023]: Documentation
+//           - 4.0 [16/10/2026]: Exact expected yields {[SEE]: ExpectedOutputs(...)}
+//           - 4.1 [16/10/2026]: Progress can be saved and restored {[SEE]: RestoreProgress(...)}
+//           - 4.2 [16/10/2026]: Construction from interned resource ids {[SEE]: Formula(const ResourceView&, ...)}
 //
 //[INVARIANT]: Resource Arrays should contain valid Strings and should not be empty
 //[INVARIANT]: Quantity Arrays should contain Non-Negative Quantities and should not be empty
@@ -61,7 +64,25 @@
 //          - Private Data Members
 //
 //        [EXTERNAL]:
-//          - This class doesn't have any extrenal depencdencies
+//          - 'ResourceRegistry' class {[SEE]: ResourceRegistry.h}
+//          - 'FormulaRecipe' class {[SEE]: FormulaRecipe.h}
+//          - 'Xoshiro256StarStar', 'UnitFloat' {[SEE]: RandomEngine.h}
+//          - 'Span' {[SEE]: Span.h}
+//
+//[NOTE]: Resource names are interned into 'ResourceId' values on construction. The Formula only
+//        stores identifiers, names are looked up in the 'ResourceRegistry' at the API edge.
+//
+//[NOTE]: The resource ids and quantities form an immutable 'FormulaRecipe' {[SEE]: FormulaRecipe.h}
+//        shared by every copy of the Formula. Copying a Formula copies a reference-counted pointer
+//        plus the per-instance state (proficiency level and 'ResultArray'); up to 'InlineOutputs'
+//        results live inside the object, so a typical copy does not allocate at all.
+//        The quantity operators ('+=', '++', ...) clone a shared recipe before modifying it
+//        (copy-on-write), so changing one copy never changes another.
+//
+//[NOTE]: The random engine is injected through the templated 'Apply(Engine&)' and
+//        'ApplyBatch(..., Engine&)' overloads. Any 'UniformRandomBitGenerator' works; the plain
+//        overloads draw from 'ThreadLocalEngine()'. Seeding the engine makes an application
+//        reproducible bit-for-bit.
 //
 //[NAMESPACE]: Might be deemed unnecessary, but despite the distinctive function names, global
 //             namespace pollution is still in the picture.
@@ -71,21 +92,37 @@
 #ifndef Formula_h
 #define Formula_h
 
+#include <array>
+#include <cstddef>
+#include <memory>
 #include <string>
 #include <random>
+#include <vector>
+
+#include "ResourceRegistry.h"
+#include "FormulaRecipe.h"
+#include "RandomEngine.h"
+#include "Span.h"
 
 namespace ResourceConversion
 {
     class Formula
     {
     private:
-        std::string* InputResources = nullptr;
+        //[NOTE]: Up to 2 results are stored inside the object
+        static constexpr size_t InlineOutputs = 2;
+
+        //[NOTE]: Shared and immutable while shared, the array members below point into it
+        std::shared_ptr<FormulaRecipe> Recipe = nullptr;
+        unsigned int InlineResults[InlineOutputs] = {};
+
+        ResourceId* InputResourceIds = nullptr;
         size_t InputResourcesSize = 0;
 
         unsigned int* InputQuantities = nullptr;
         size_t InputQuantitiesSize = 0;
 
-        std::string* OutputResources = nullptr;
+        ResourceId* OutputResourceIds = nullptr;
         size_t OutputResourcesSize = 0;
 
         unsigned int* OutputQuantities = nullptr;
@@ -121,16 +158,21 @@ namespace ResourceConversion
         };
 
         inline bool ContainsNullOrWhiteSpace (const std::string* Array, const size_t& ArraySize) const;
-        inline OutcomeModifiers GetOutcomeChances (const unsigned int &Level);
+        static inline void InternResources (const std::string* Names, const size_t& NamesSize, ResourceId* Destination);
+        inline OutcomeModifiers GetOutcomeChances (const unsigned int &Level) const;
         
+        inline void BindRecipe ();
+        inline void AllocateResults ();
+        inline bool UsesInlineResults () const { return ResultArray == InlineResults; }
+        inline void DetachRecipe ();
+
         inline void CopyData (const Formula& other);
         inline void ClearContainer ();
         inline void ResetContainer ();
-        inline void SwapData(Formula &&other);
-        inline void ReassignData(Formula &&other) const;
+        inline void ReassignData(Formula &&other);
 
         template<typename T>
-        typename std::enable_if<std::is_same<T, unsigned int>::value || std::is_same<T, std::string>::value, bool>::type 
+        typename std::enable_if<std::is_same<T, unsigned int>::value || std::is_same<T, ResourceId>::value, bool>::type 
         inline ArraysAreEqual(T* First, T* Second, size_t FirstArraySize, size_t SecondArraySize) const;
 
         //[NOTE]: Decrements the Quantities
@@ -154,44 +196,76 @@ namespace ResourceConversion
         Formula (Formula&& other) noexcept;
         Formula& operator=(Formula&& other) noexcept;
 
+        //[DESC]: Possible outcomes of a single application {[SEE]: Formula.cpp Apply()}
+        //[NOTE]: 'Unchanged' covers draws that land exactly on a chance boundary, the
+        //        'ResultArray' keeps its previous values in that case.
+        enum class Outcome : std::size_t { Failure = 0, Partial, Bonus, Normal, Unchanged };
+        static constexpr std::size_t OutcomeCount = 5;
+
+        //[DESC]: Aggregated result of 'ApplyBatch(...)'
+        //        - 'Histogram' counts how many trials ended in each 'Outcome'
+        //        - 'OutputTotals' sums the produced quantity of each output resource over all trials
+        struct BatchResult
+        {
+            std::array<std::size_t, OutcomeCount> Histogram{};
+            std::vector<unsigned long long> OutputTotals;
+        };
+
         void Apply ();
+        template<typename Engine> void Apply (Engine& Generator);
+
+        void ApplyBatch (std::size_t Trials, BatchResult& Results) const;
+        template<typename Engine> void ApplyBatch (std::size_t Trials, BatchResult& Results, Engine& Generator) const;
+        template<typename Engine> Outcome Evaluate (Engine& Generator, unsigned int* Destination) const;
+        void ExpectedOutputs (double* Destination) const;
         inline unsigned int* GetResultArray () const { return ResultArray; }
+        inline unsigned int GetProficiencyLevel () const { return ProficiencyLevel; }
+        void RestoreProgress (unsigned int Level, const unsigned int* Results);
         void DisplayFormulaValues(const bool PrintResultArray = false) const;
 
-        inline std::string* GetInputResources() { return InputResources; }
-        inline std::string* GetOutputResources() { return OutputResources; }
+        inline const ResourceId* GetInputResourceIds() const { return InputResourceIds; }
+        inline const ResourceId* GetOutputResourceIds() const { return OutputResourceIds; }
 
-        inline std::size_t GetInputResourcesSize() { return InputResourcesSize; }
-        inline std::size_t GetOutputResourcesSize() { return OutputResourcesSize; }
+        const std::string& GetInputResourceName(size_t Index) const;
+        const std::string& GetOutputResourceName(size_t Index) const;
 
-        inline unsigned int* GetInputQuantities() { return InputQuantities; }
-        inline unsigned int* GetOutputQuantities() { return OutputQuantities; }
-        
+        inline std::size_t GetInputResourcesSize() const { return InputResourcesSize; }
+        inline std::size_t GetOutputResourcesSize() const { return OutputResourcesSize; }
+
+        inline const unsigned int* GetInputQuantities() const { return InputQuantities; }
+        inline const unsigned int* GetOutputQuantities() const { return OutputQuantities; }
+
+        //[NOTE]: True if this Formula and 'other' share one recipe {[SEE]: FormulaRecipe.h}
+        inline bool SharesRecipeWith(const Formula& other) const { return Recipe != nullptr && Recipe == other.Recipe; }
+        //[NOTE]: Pins the recipe: while the pointer is held, a change to this Formula's recipe goes to a
+        //        private clone (copy-on-write), so 'UsesRecipe(...)' turns false
+        inline std::shared_ptr<const FormulaRecipe> ShareRecipe() const { return Recipe; }
+        inline bool UsesRecipe(const FormulaRecipe* Pinned) const { return Recipe.get() == Pinned; }
 
-        //[DESC]: Struct that abstracts the acess of internal data [Formula].
-        //        Does not modify any of the data but simply retrieves them
-        //[NOTE]: using the "s_prefix" naming convention, to not confuse the
-        //        internals of the struct with the Formula members
-        //[NOTE #2]: Using 'std::vector' and iterators to build the Resources.
-        //           Dsicussed with professor Dingle.
-        struct StockpileDataLoader
-        { 
-            std::vector<std::string> s_InputResources;
-            std::vector<std::string> s_OutputResources;
-            std::vector<unsigned int> s_InputQuantities;
-            std::vector<unsigned int> s_OutputQuantities;
-
-            std::size_t s_InputResourcesSize = 0;
-            std::size_t s_OutputResourcesSize = 0;
-
-            StockpileDataLoader(Formula s_Formula)
-          : s_InputResources(s_Formula.GetInputResources(), s_Formula.GetInputResources() + s_Formula.GetInputResourcesSize()),
-            s_OutputResources(s_Formula.GetOutputResources(), s_Formula.GetOutputResources() + s_Formula.GetOutputResourcesSize()),
-            s_InputQuantities(s_Formula.GetInputQuantities(), s_Formula.GetInputQuantities() + s_Formula.GetInputResourcesSize()),
-            s_OutputQuantities(s_Formula.GetOutputQuantities(), s_Formula.GetOutputQuantities() + s_Formula.GetOutputResourcesSize()),
-            s_InputResourcesSize(s_Formula.GetInputResourcesSize()),
-            s_OutputResourcesSize(s_Formula.GetOutputResourcesSize()) {}
+
+        //[DESC]: Non-owning view of the recipe of a Formula: spans over the resource ids and the
+        //        nominal quantities of both sides. Replaces the old 'StockpileDataLoader', which
+        //        copied the Formula and four vectors just to read them.
+        //[NOTE]: Building or reading a view never allocates. It stays valid as long as the Formula
+        //        is alive and its quantities are not modified {[SEE]: 'GetView()'}.
+        struct ResourceView
+        {
+            Span<const ResourceId> InputResources;
+            Span<const unsigned int> InputQuantities;
+            Span<const ResourceId> OutputResources;
+            Span<const unsigned int> OutputQuantities;
         };
+
+        inline ResourceView GetView() const
+        {
+            return ResourceView{Span<const ResourceId>(InputResourceIds, InputResourcesSize),
+                                Span<const unsigned int>(InputQuantities, InputQuantitiesSize),
+                                Span<const ResourceId>(OutputResourceIds, OutputResourcesSize),
+                                Span<const unsigned int>(OutputQuantities, OutputQuantitiesSize)};
+        }
+
+        //[NOTE]: Builds a Formula from resource ids that are already interned {[SEE]: PlanArchive.h}
+        explicit Formula (const ResourceView& Recipe_, unsigned int ProficiencyLevel_ = 0);
         
         //[OPERATORS]
         bool operator!=(const Formula& other) const;
@@ -208,7 +282,61 @@ namespace ResourceConversion
 
         Formula& operator+=(unsigned int IncrementValue);
         Formula& operator-=(unsigned int DecrementValue);
+
+    private:
+        inline Outcome ClassifyOutcome (float RandomValue, const OutcomeModifiers& Chances) const;
+        inline void WriteOutcome (Outcome Result, unsigned int* Destination) const;
+
+        void ApplyDraw (float RawValue);
+        Outcome EvaluateDraw (float RawValue, unsigned int* Destination) const;
+        OutcomeModifiers BeginBatch (BatchResult& Results) const;
+        Outcome ClassifyDraw (float RawValue, const OutcomeModifiers& Chances) const;
+        void FinishBatch (BatchResult& Results) const;
     };
+
+    //[DESC]: Applies the formula with a caller supplied random engine.
+    //[PARAM]: Generator Any 'UniformRandomBitGenerator' {[SEE]: RandomEngine.h 'UnitFloat'}
+    //[PRE]: The Formula object must be properly initialized with valid data and proficiency level.
+    //[POST]: Same as 'Apply()'. Exactly one value is drawn from 'Generator'.
+    //[THROW]: std::invalid_argument if the formula holds no data.
+    template<typename Engine>
+    void Formula::Apply (Engine& Generator)
+    {
+        ApplyDraw (UnitFloat (Generator));
+    }
+
+    //[DESC]: Computes the outcome of one application without modifying the Formula.
+    //[PARAM]: Generator Any 'UniformRandomBitGenerator' {[SEE]: RandomEngine.h 'UnitFloat'}
+    //[PARAM]: Destination Receives 'OutputQuantitiesSize' produced quantities.
+    //[PRE]: The Formula object must be properly initialized with valid data and proficiency level.
+    //[POST]: 'Destination' holds what 'Apply(Generator)' would have written to 'ResultArray'.
+    //        Neither 'ResultArray' nor the proficiency level change, so with a counter-based engine
+    //        {[SEE]: RandomEngine.h 'Philox4x32'} evaluations can run in any order and on any thread.
+    //[THROW]: std::invalid_argument if the formula holds no data.
+    //[RETURN]: The outcome of the draw.
+    template<typename Engine>
+    Formula::Outcome Formula::Evaluate (Engine& Generator, unsigned int* Destination) const
+    {
+        return EvaluateDraw (UnitFloat (Generator), Destination);
+    }
+
+    //[DESC]: Runs 'Trials' independent applications with a caller supplied random engine.
+    //[PARAM]: Trials The number of independent draws.
+    //[PARAM]: Results Receives the outcome histogram and the summed output quantities.
+    //[PARAM]: Generator Any 'UniformRandomBitGenerator' {[SEE]: RandomEngine.h 'UnitFloat'}
+    //[PRE]: The Formula object must be properly initialized with valid data and proficiency level.
+    //[POST]: Same as 'ApplyBatch(Trials, Results)'. Exactly 'Trials' values are drawn from 'Generator'.
+    //[THROW]: std::invalid_argument if the formula holds no data.
+    template<typename Engine>
+    void Formula::ApplyBatch (std::size_t Trials, BatchResult& Results, Engine& Generator) const
+    {
+        OutcomeModifiers OutcomeChances = BeginBatch (Results);
+        for (std::size_t Trial = 0; Trial < Trials; ++Trial)
+        {
+            Results.Histogram[static_cast<std::size_t>(ClassifyDraw (UnitFloat (Generator), OutcomeChances))]++;
+        }
+        FinishBatch (Results);
+    }
 }//[NAMESPACE]: ResourceConversion
 #endif /* Formula_h */
 
@@ -0,0 +1,105 @@
+//[FILE]: FormulaBook.cpp
+//[DESC]: This file contains the implementation of the 'FormulaBook' class {[SEE]: FormulaBook.h}
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: Offsets are prefix sums over the formula sizes, so row i of either side is the
+//             half-open range [Offsets[i], Offsets[i + 1]).
+
+#include "FormulaBook.h"
+
+namespace ResourceConversion
+{
+  //[DESC]: Default constructor
+  //[PRE]: None
+  //[POST]: An empty book is constructed, 'Size()' is 0
+  FormulaBook::FormulaBook()
+    : InputOffsets(), InputIds(), InputQuantities(), OutputOffsets(), OutputIds(), OutputQuantities(), Pinned() {}
+
+  //[DESC]: Pack the recipes of 'Count' formulas into the flat arrays
+  //[PARAM]: 'Formulas' The formulas to pack, in plan order
+  //[PARAM]: 'Count' The number of formulas
+  //[PRE]: 'Formulas' points to at least 'Count' formulas, or 'Count' is 0
+  //[POST]: Row i of the book describes 'Formulas[i]', any previous content is replaced
+  //[NOTE]: Two passes, the first sizes every array exactly so the second never reallocates.
+  //        The storage of a previous build is reused.
+  void FormulaBook::Build(const Formula* Formulas, size_t Count)
+  {
+    Clear();
+    InputOffsets.reserve(Count + 1);
+    OutputOffsets.reserve(Count + 1);
+    Pinned.reserve(Count);
+
+    size_t InputTotal = 0;
+    size_t OutputTotal = 0;
+    InputOffsets.push_back(0);
+    OutputOffsets.push_back(0);
+    for(size_t i = 0; i < Count; i++)
+    {
+      InputTotal += Formulas[i].GetInputResourcesSize();
+      OutputTotal += Formulas[i].GetOutputResourcesSize();
+      InputOffsets.push_back(InputTotal);
+      OutputOffsets.push_back(OutputTotal);
+      Pinned.push_back(Formulas[i].ShareRecipe());
+    }
+
+    InputIds.resize(InputTotal);
+    InputQuantities.resize(InputTotal);
+    OutputIds.resize(OutputTotal);
+    OutputQuantities.resize(OutputTotal);
+
+    for(size_t i = 0; i < Count; i++)
+    {
+      const ResourceId* FormulaInputIds = Formulas[i].GetInputResourceIds();
+      const unsigned int* FormulaInputQuantities = Formulas[i].GetInputQuantities();
+      for(size_t j = 0; j < InputOffsets[i + 1] - InputOffsets[i]; j++)
+      {
+        InputIds[InputOffsets[i] + j] = FormulaInputIds[j];
+        InputQuantities[InputOffsets[i] + j] = FormulaInputQuantities[j];
+      }
+
+      const ResourceId* FormulaOutputIds = Formulas[i].GetOutputResourceIds();
+      const unsigned int* FormulaOutputQuantities = Formulas[i].GetOutputQuantities();
+      for(size_t j = 0; j < OutputOffsets[i + 1] - OutputOffsets[i]; j++)
+      {
+        OutputIds[OutputOffsets[i] + j] = FormulaOutputIds[j];
+        OutputQuantities[OutputOffsets[i] + j] = FormulaOutputQuantities[j];
+      }
+    }
+  }
+
+  //[DESC]: Empty the book
+  //[PRE]: None
+  //[POST]: 'Size()' is 0, the allocated storage is kept for the next 'Build(...)'
+  void FormulaBook::Clear()
+  {
+    InputOffsets.clear();
+    InputIds.clear();
+    InputQuantities.clear();
+    OutputOffsets.clear();
+    OutputIds.clear();
+    OutputQuantities.clear();
+    Pinned.clear();
+  }
+
+  //[DESC]: Check whether the book still describes a set of formulas
+  //[PARAM]: 'Formulas' The formulas the book was built from
+  //[PARAM]: 'Count' The number of formulas
+  //[PRE]: 'Formulas' points to at least 'Count' formulas, or 'Count' is 0
+  //[POST]: None
+  //[RETURN]: 'false' if the count differs or a formula no longer uses the recipe its row was packed from
+  bool FormulaBook::Describes(const Formula* Formulas, size_t Count) const
+  {
+    if(Count != Size()) { return false; }
+    for(size_t i = 0; i < Count; i++)
+    {
+      if(!Formulas[i].UsesRecipe(Pinned[i].get())) { return false; }
+    }
+    return true;
+  }
+}//[NAMESPACE]: ResourceConversion
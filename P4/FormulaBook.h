@@ -0,0 +1,99 @@
+//[FILE]: FormulaBook.h
+//[DESC]: This file defines the 'FormulaBook' class, a read-only, structure-of-arrays view of every
+//        'Formula' in a 'Plan'. The resource ids and quantities of all formulas are packed into a few
+//        flat arrays (compressed sparse rows), with an offset table per side:
+//
+//          InputOffsets   [0, 2, 5, ...]      -> formula i owns [InputOffsets[i], InputOffsets[i + 1])
+//          InputIds       [A, B, C, D, E, ...]
+//          InputQuantities[1, 2, 4, 5, 1, ...]
+//
+//        Walking a plan then reads a handful of contiguous arrays instead of four separate heap
+//        allocations per formula. The book only holds the recipe ('ResourceId's and nominal
+//        quantities); results and proficiency stay in the 'Formula' objects.
+//
+//        The book also keeps a reference to the recipe of every formula it packed. Recipes are
+//        copy-on-write {[SEE]: FormulaRecipe.h}, so a formula changed after the build no longer uses
+//        its pinned recipe, and 'Describes(...)' notices without comparing any quantity.
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: 'InputOffsets' and 'OutputOffsets' hold 'Size() + 1' non-decreasing values, the first
+//             is 0 and the last equals the length of the matching id and quantity arrays.
+//[INVARIANT]: The id and quantity arrays of a side always have the same length.
+//[INVARIANT]: 'Pinned' holds 'Size()' recipes, row i was packed from 'Pinned[i]'.
+//
+//[USAGE]
+//{
+// FormulaBook Book;
+// Book.Build(FormulaArray, Size);
+//
+// for(size_t j = Book.InputBegin(i); j < Book.InputEnd(i); j++)
+// {
+//   Book.GetInputIds()[j];  Book.GetInputQuantities()[j];
+// }
+//}
+//
+//[DEPENDENCIES]:
+//       [INTERNAL]:
+//          - Member, Helper, Utility methods
+//          - Private Data Members
+//
+//        [EXTERNAL]:
+//          - 'Formula' class {[SEE]: Formula.h}
+//          - 'std::vector'
+//
+//[NAMESPACE]: {ResourceConversion} Encapsulates the 'Formula', 'Plan', 'ExecutablePlan', 'Stockpile'
+//             and supporting classes.
+#ifndef FormulaBook_h
+#define FormulaBook_h
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "Formula.h"
+#include "FormulaRecipe.h"
+#include "ResourceRegistry.h"
+
+namespace ResourceConversion
+{
+  class FormulaBook
+  {
+    private:
+    std::vector<size_t> InputOffsets;
+    std::vector<ResourceId> InputIds;
+    std::vector<unsigned int> InputQuantities;
+
+    std::vector<size_t> OutputOffsets;
+    std::vector<ResourceId> OutputIds;
+    std::vector<unsigned int> OutputQuantities;
+
+    std::vector<std::shared_ptr<const FormulaRecipe>> Pinned;
+
+    public:
+    FormulaBook();
+
+    void Build(const Formula* Formulas, size_t Count);
+    void Clear();
+    bool Describes(const Formula* Formulas, size_t Count) const;
+
+    inline size_t Size() const { return InputOffsets.empty() ? 0 : InputOffsets.size() - 1; }
+
+    inline size_t InputBegin(size_t Index) const { return InputOffsets[Index]; }
+    inline size_t InputEnd(size_t Index) const { return InputOffsets[Index + 1]; }
+    inline size_t OutputBegin(size_t Index) const { return OutputOffsets[Index]; }
+    inline size_t OutputEnd(size_t Index) const { return OutputOffsets[Index + 1]; }
+
+    inline const ResourceId* GetInputIds() const { return InputIds.data(); }
+    inline const unsigned int* GetInputQuantities() const { return InputQuantities.data(); }
+    inline const ResourceId* GetOutputIds() const { return OutputIds.data(); }
+    inline const unsigned int* GetOutputQuantities() const { return OutputQuantities.data(); }
+    inline const std::shared_ptr<const FormulaRecipe>& GetRecipe(size_t Index) const { return Pinned[Index]; }
+  };
+}//[NAMESPACE]: ResourceConversion
+#endif /*FormulaBook_h*/
@@ -0,0 +1,47 @@
+//[FILE]: FormulaRecipe.cpp
+//[DESC]: This file contains the implementation of the 'FormulaRecipe' class {[SEE]: FormulaRecipe.h}
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: 'Storage' points to 'InlineStorage' whenever the block fits.
+
+#include <algorithm>
+
+#include "FormulaRecipe.h"
+
+namespace ResourceConversion
+{
+  //[DESC]: Construct a zeroed recipe for the given number of inputs and outputs
+  //[PARAM]: 'InputsSize_' The number of input resources
+  //[PARAM]: 'OutputsSize_' The number of output resources
+  //[PRE]: None
+  //[POST]: Every id and quantity is 0, the caller fills them in before sharing the recipe
+  FormulaRecipe::FormulaRecipe(size_t InputsSize_, size_t OutputsSize_)
+    : InputsSize(InputsSize_), OutputsSize(OutputsSize_), HeapStorage(), Storage(nullptr)
+  {
+    if(Words() <= InlineWords)
+    {
+      Storage = InlineStorage;
+    }
+    else
+    {
+      HeapStorage.reset(new unsigned int[Words()]());
+      Storage = HeapStorage.get();
+    }
+  }
+
+  //[DESC]: Clone a recipe, used when a shared recipe is about to be modified
+  //[PARAM]: 'other' The recipe to clone
+  //[PRE]: None
+  //[POST]: The clone holds the same ids and quantities in storage of its own
+  FormulaRecipe::FormulaRecipe(const FormulaRecipe& other)
+    : FormulaRecipe(other.InputsSize, other.OutputsSize)
+  {
+    std::copy(other.Storage, other.Storage + other.Words(), Storage);
+  }
+}//[NAMESPACE]: ResourceConversion
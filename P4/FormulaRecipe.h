@@ -0,0 +1,78 @@
+//[FILE]: FormulaRecipe.h
+//[DESC]: This file defines the 'FormulaRecipe' class, the immutable part of a 'Formula': which
+//        resources go in and come out, and in what quantities. A recipe is shared between every copy
+//        of a Formula through a reference-counted pointer; copying a 'Formula' (and therefore a
+//        'Plan' or 'ExecutablePlan') copies a pointer instead of the recipe. Only the proficiency
+//        level and the result array are per-instance state.
+//
+//        The ids and quantities live in one block of 32-bit words:
+//          [InputIds | InputQuantities | OutputIds | OutputQuantities]
+//        Recipes of up to 'InlineWords' words (4 inputs and 2 outputs) keep the block inside the
+//        object, so 'std::make_shared' allocates the control block and the recipe together.
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: A recipe that is shared (use count above 1) is never modified. 'Formula' clones it
+//             first {[SEE]: Formula.cpp 'DetachRecipe()'}.
+//[INVARIANT]: 'Storage' points to 'InlineStorage' or 'HeapStorage', and holds
+//             2 * ('InputsSize' + 'OutputsSize') words.
+//
+//[DEPENDENCIES]:
+//       [INTERNAL]:
+//          - Member, Helper, Utility methods
+//          - Private Data Members
+//
+//        [EXTERNAL]:
+//          - 'ResourceRegistry' class {[SEE]: ResourceRegistry.h}
+//
+//[NAMESPACE]: {ResourceConversion} Encapsulates the 'Formula', 'Plan', 'ExecutablePlan', 'Stockpile'
+//             and supporting classes.
+#ifndef FormulaRecipe_h
+#define FormulaRecipe_h
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+#include "ResourceRegistry.h"
+
+namespace ResourceConversion
+{
+  class FormulaRecipe
+  {
+    private:
+    static_assert(std::is_same<ResourceId, unsigned int>::value, "[FormulaRecipe] ids and quantities share one block of words");
+
+    //[NOTE]: 4 inputs and 2 outputs (id + quantity each) fit inline
+    static constexpr size_t InlineInputs = 4;
+    static constexpr size_t InlineOutputs = 2;
+    static constexpr size_t InlineWords = 2 * InlineInputs + 2 * InlineOutputs;
+
+    size_t InputsSize = 0;
+    size_t OutputsSize = 0;
+    unsigned int InlineStorage[InlineWords] = {};
+    std::unique_ptr<unsigned int[]> HeapStorage;
+    unsigned int* Storage = nullptr;
+
+    inline size_t Words() const { return 2 * (InputsSize + OutputsSize); }
+
+    public:
+    FormulaRecipe(size_t InputsSize_, size_t OutputsSize_);
+    FormulaRecipe(const FormulaRecipe& other);
+    FormulaRecipe& operator=(const FormulaRecipe& other) = delete;
+
+    inline size_t GetInputsSize() const { return InputsSize; }
+    inline size_t GetOutputsSize() const { return OutputsSize; }
+
+    inline ResourceId* InputIds() const { return Storage; }
+    inline unsigned int* InputQuantities() const { return Storage + InputsSize; }
+    inline ResourceId* OutputIds() const { return Storage + 2 * InputsSize; }
+    inline unsigned int* OutputQuantities() const { return Storage + 2 * InputsSize + OutputsSize; }
+  };
+}//[NAMESPACE]: ResourceConversion
+#endif /*FormulaRecipe_h*/
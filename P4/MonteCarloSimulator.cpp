@@ -0,0 +1,261 @@
+//[FILE]: MonteCarloSimulator.cpp
+//[DESC]: This file contains the implementation of the 'MonteCarloSimulator' class {[SEE]: MonteCarloSimulator.h}
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: Worker w owns the trials [w * Trials / Workers, (w + 1) * Trials / Workers) and writes
+//             only to its own 'WorkerState'.
+//[INVARIANT]: Statistics are computed from the merged, exact histograms in ascending order, so the
+//             floating point results are identical for any number of workers.
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+#include "FormulaBook.h"
+#include "MonteCarloSimulator.h"
+#include "RandomEngine.h"
+
+namespace ResourceConversion
+{
+  namespace
+  {
+    //[DESC]: Everything one worker thread touches while it runs its block of trials
+    //        - 'Histograms[k]' maps a final quantity of tracked resource k to its number of trials
+    //[NOTE]: Cache line aligned so that workers never write to a line another worker reads
+    struct alignas(64) WorkerState
+    {
+      Stockpile Scratch = Stockpile();
+      std::vector<unsigned int> Produced = std::vector<unsigned int>();
+      std::vector<std::unordered_map<std::size_t, std::uint64_t>> Histograms = std::vector<std::unordered_map<std::size_t, std::uint64_t>>();
+      std::exception_ptr Error = nullptr;
+    };
+
+    //[DESC]: Run one trial of the plan on 'Scratch'
+    //[PARAM]: 'Recipes' The packed recipes of 'PlanObj'
+    //[PARAM]: 'Produced' Scratch buffer, holds at least as many values as the widest formula output
+    //[PRE]: 'Scratch' holds the initial quantities
+    //[POST]: 'Scratch' holds the final quantities of the trial
+    //[THROW]: 'std::overflow_error' if a quantity overflows {[SEE]: Stockpile::Produce(...)}
+    //[NOTE]: Mirrors 'ExecutablePlan::PlanApply(...)', a step whose inputs are short is skipped and
+    //        leaves the stockpile unchanged
+    inline void RunTrial(const Plan& PlanObj, const FormulaBook& Recipes, std::uint64_t Seed, std::uint32_t PlanId,
+                         std::uint32_t Trial, Stockpile& Scratch, unsigned int* Produced)
+    {
+      const ResourceId* InputIds = Recipes.GetInputIds();
+      const unsigned int* InputQuantities = Recipes.GetInputQuantities();
+      const ResourceId* OutputIds = Recipes.GetOutputIds();
+
+      for(size_t Step = 0; Step < Recipes.Size(); Step++)
+      {
+        const size_t InputBegin = Recipes.InputBegin(Step);
+        if(!Scratch.TryConsume(InputIds + InputBegin, InputQuantities + InputBegin, Recipes.InputEnd(Step) - InputBegin))
+        {
+          continue;
+        }
+
+        Philox4x32 Generator(Seed, PlanId, static_cast<std::uint32_t>(Step), Trial);
+        PlanObj.GetFormula(Step).Evaluate(Generator, Produced);
+        const size_t OutputBegin = Recipes.OutputBegin(Step);
+        Scratch.Produce(OutputIds + OutputBegin, Produced, Recipes.OutputEnd(Step) - OutputBegin);
+      }
+    }
+  }
+
+  //[DESC]: Look up the statistics of one resource
+  //[PARAM]: 'Resource' The interned identifier of the resource
+  //[PRE]: None
+  //[POST]: None
+  //[RETURN]: Pointer to the statistics, or 'nullptr' if the resource was not tracked
+  const MonteCarloSimulator::ResourceStatistics* MonteCarloSimulator::Result::Find(ResourceId Resource) const
+  {
+    auto it = std::lower_bound(Resources.begin(), Resources.end(), Resource,
+                               [](const ResourceStatistics& Entry, ResourceId Id) { return Entry.Resource < Id; });
+    if(it == Resources.end() || it -> Resource != Resource) { return nullptr; }
+    return &*it;
+  }
+
+  //[DESC]: Default constructor, 1000 trials with seed 0 on every hardware thread
+  //[PRE]: None
+  //[POST]: Object is constructed
+  MonteCarloSimulator::MonteCarloSimulator() : MonteCarloSimulator(Options()) {}
+
+  //[DESC]: Constructor
+  //[PARAM]: 'Settings_' The settings of every following 'Run(...)'
+  //[PRE]: None
+  //[POST]: Object is constructed
+  //[THROW]: 'std::invalid_argument' if 'Trials' is 0 or above 2^32, or if a percentile rank is outside [0, 1]
+  MonteCarloSimulator::MonteCarloSimulator(const Options& Settings_) : Settings(Settings_)
+  {
+    constexpr std::uint64_t TrialLimit = static_cast<std::uint64_t>(std::numeric_limits<std::uint32_t>::max()) + 1;
+    if(Settings.Trials == 0 || Settings.Trials > TrialLimit)
+    {
+      throw std::invalid_argument("[MC]MonteCarloSimulator(...) [Trials must be in [1, 2^32]]");
+    }
+
+    for(double Rank : Settings.Percentiles)
+    {
+      if(!(Rank >= 0.0 && Rank <= 1.0))
+      {
+        throw std::invalid_argument("[MC]MonteCarloSimulator(...) [Percentile ranks must be in [0, 1]]");
+      }
+    }
+  }
+
+  //[DESC]: Collect the resources reported by a simulation
+  //[PARAM]: 'Recipes' The packed recipes of the plan
+  //[PARAM]: 'Initial' The initial stockpile
+  //[PRE]: None
+  //[POST]: None
+  //[RETURN]: Every resource of 'Initial' and every output of the plan, sorted and unique
+  std::vector<ResourceId> MonteCarloSimulator::TrackedResources(const FormulaBook& Recipes, const Stockpile& Initial)
+  {
+    std::vector<ResourceId> Tracked;
+    if(Recipes.Size() != 0)
+    {
+      Tracked.assign(Recipes.GetOutputIds(), Recipes.GetOutputIds() + Recipes.OutputEnd(Recipes.Size() - 1));
+    }
+
+    const size_t Interned = ResourceRegistry::Instance().Size();
+    for(size_t i = 0; i < Interned; i++)
+    {
+      if(Initial.HasResource(static_cast<ResourceId>(i))) { Tracked.push_back(static_cast<ResourceId>(i)); }
+    }
+
+    std::sort(Tracked.begin(), Tracked.end());
+    Tracked.erase(std::unique(Tracked.begin(), Tracked.end()), Tracked.end());
+    return Tracked;
+  }
+
+  //[DESC]: Estimate the distribution of the final stockpile contents after running a plan
+  //[PARAM]: 'PlanObj' The plan, usually an 'ExecutablePlan'. Every step runs in order, in every trial.
+  //[PARAM]: 'Initial' The contents of the stockpile before each trial
+  //[PRE]: Neither 'PlanObj' nor 'Initial' is modified by another thread during the call
+  //[POST]: 'PlanObj' and 'Initial' are unchanged
+  //[THROW]: 'std::overflow_error' if a quantity overflows in any trial
+  //[THROW]: 'std::system_error' if a worker thread cannot be started
+  //[RETURN]: The statistics of every tracked resource {[SEE]: TrackedResources(...)}
+  //[NOTE]: The packed recipes are fetched once, before any worker starts, so workers only ever read
+  //        the plan. Trials are split into one contiguous block per worker; the calling thread runs
+  //        the first block itself.
+  MonteCarloSimulator::Result MonteCarloSimulator::Run(const Plan& PlanObj, const Stockpile& Initial) const
+  {
+    const FormulaBook& Recipes = PlanObj.GetFormulaBook();
+    const std::vector<ResourceId> Tracked = TrackedResources(Recipes, Initial);
+
+    size_t Widest = 1;
+    for(size_t Step = 0; Step < Recipes.Size(); Step++)
+    {
+      Widest = std::max(Widest, Recipes.OutputEnd(Step) - Recipes.OutputBegin(Step));
+    }
+
+    Stockpile Template;
+    Template.CopyFrom(Initial, Stockpile::StorageMode::Dense);
+
+    const std::uint64_t Trials = Settings.Trials;
+    unsigned int Workers = Settings.Threads != 0 ? Settings.Threads : std::max(1U, std::thread::hardware_concurrency());
+    Workers = static_cast<unsigned int>(std::min<std::uint64_t>(Workers, Trials));
+
+    std::vector<WorkerState> States(Workers);
+    auto Work = [&](unsigned int Worker) -> void {
+      WorkerState& State = States[Worker];
+      try
+      {
+        State.Produced.assign(Widest, 0);
+        State.Histograms.resize(Tracked.size());
+
+        const std::uint64_t Begin = Trials * Worker / Workers;
+        const std::uint64_t End = Trials * (Worker + 1) / Workers;
+        for(std::uint64_t Trial = Begin; Trial < End; Trial++)
+        {
+          State.Scratch.CopyFrom(Template, Stockpile::StorageMode::Dense);
+          RunTrial(PlanObj, Recipes, Settings.Seed, Settings.PlanId, static_cast<std::uint32_t>(Trial), State.Scratch, State.Produced.data());
+
+          for(size_t k = 0; k < Tracked.size(); k++)
+          {
+            ++State.Histograms[k][State.Scratch.GetResourceQuantity(Tracked[k])];
+          }
+        }
+      }
+      catch(...)
+      {
+        State.Error = std::current_exception();
+      }
+    };
+
+    std::vector<std::thread> Threads;
+    Threads.reserve(Workers - 1);
+    try
+    {
+      for(unsigned int Worker = 1; Worker < Workers; Worker++) { Threads.emplace_back(Work, Worker); }
+    }
+    catch(...)
+    {
+      for(std::thread& Thread : Threads) { Thread.join(); }
+      throw;
+    }
+    Work(0);
+    for(std::thread& Thread : Threads) { Thread.join(); }
+
+    for(const WorkerState& State : States)
+    {
+      if(State.Error != nullptr) { std::rethrow_exception(State.Error); }
+    }
+
+    Result Outcome;
+    Outcome.Trials = Trials;
+    Outcome.PercentileRanks = Settings.Percentiles;
+    Outcome.Resources.reserve(Tracked.size());
+
+    for(size_t k = 0; k < Tracked.size(); k++)
+    {
+      std::map<std::size_t, std::uint64_t> Merged;
+      for(const WorkerState& State : States)
+      {
+        for(const auto& [Quantity, Count] : State.Histograms[k]) { Merged[Quantity] += Count; }
+      }
+
+      ResourceStatistics Statistics;
+      Statistics.Resource = Tracked[k];
+      Statistics.Minimum = Merged.begin() -> first;
+      Statistics.Maximum = Merged.rbegin() -> first;
+
+      long double Sum = 0.0L;
+      for(const auto& [Quantity, Count] : Merged) { Sum += static_cast<long double>(Quantity) * static_cast<long double>(Count); }
+      const long double Mean = Sum / static_cast<long double>(Trials);
+
+      long double SquaredDeviations = 0.0L;
+      for(const auto& [Quantity, Count] : Merged)
+      {
+        const long double Deviation = static_cast<long double>(Quantity) - Mean;
+        SquaredDeviations += Deviation * Deviation * static_cast<long double>(Count);
+      }
+      Statistics.Mean = static_cast<double>(Mean);
+      Statistics.Variance = static_cast<double>(SquaredDeviations / static_cast<long double>(Trials));
+
+      //Nearest rank: the smallest quantity reached by at least ceil(Rank * Trials) trials
+      Statistics.Percentiles.reserve(Settings.Percentiles.size());
+      for(double Rank : Settings.Percentiles)
+      {
+        const std::uint64_t Target = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(Rank * static_cast<double>(Trials))));
+        std::uint64_t Seen = 0;
+        auto it = Merged.begin();
+        while((Seen += it -> second) < Target) { ++it; }
+        Statistics.Percentiles.push_back(it -> first);
+      }
+
+      Outcome.Resources.push_back(std::move(Statistics));
+    }
+    return Outcome;
+  }
+}//[NAMESPACE]: ResourceConversion
@@ -0,0 +1,117 @@
+//[FILE]: MonteCarloSimulator.h
+//[DESC]: This file defines the 'MonteCarloSimulator' class. It estimates the distribution of the
+//        final stockpile contents after running a plan: every trial starts from a copy of the
+//        initial 'Stockpile', applies each step of the plan in order (exactly like
+//        'ExecutablePlan::PlanApply(...)') and records the final quantity of every tracked resource.
+//        The result holds the mean, the variance, the extremes and the requested percentiles of
+//        each resource.
+//
+//        Trials run in parallel. Each worker thread owns a contiguous block of trials, a scratch
+//        'Stockpile' (reset with 'CopyFrom(...)', no allocation after the first trial) and its own
+//        histograms, nothing is shared between workers until they are joined. Every step draws from
+//        'Philox4x32(Seed, PlanId, Step, Trial)' {[SEE]: RandomEngine.h}, so a trial computes the
+//        same values on any thread and the result does not depend on the number of threads.
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: 'Settings.Trials' is in [1, 2^32] and every percentile rank is in [0, 1].
+//[INVARIANT]: The simulated plan and the initial 'Stockpile' are never modified.
+//
+//[USAGE]
+//{
+// MonteCarloSimulator::Options Settings;
+// Settings.Trials = 100000;
+// Settings.Seed = 42;
+//
+// MonteCarloSimulator Simulator(Settings);
+// MonteCarloSimulator::Result Yield = Simulator.Run(PlanObj, InitialStockpile);
+//
+// const MonteCarloSimulator::ResourceStatistics* Wood = Yield.Find(Registry.Intern("Wood"));
+// Wood -> Mean;  Wood -> Variance;  Wood -> Percentiles[1];   -> median (default ranks 5%, 50%, 95%)
+//}
+//
+//[NOTE]: Formulas are evaluated with their current proficiency level and results
+//        {[SEE]: Formula::Evaluate(...)}, a trial is one pass over the plan as it is right now.
+//
+//[DEPENDENCIES]:
+//       [INTERNAL]:
+//          - Member, Helper, Utility methods
+//          - Private Data Members
+//
+//        [EXTERNAL]:
+//          - 'Plan', 'FormulaBook', 'Stockpile' and 'Philox4x32' {[SEE]: Plan.h, Stockpile.h}
+//          - 'std::thread'
+//
+//[NAMESPACE]: {ResourceConversion} Encapsulates the 'Formula', 'Plan', 'ExecutablePlan', 'Stockpile'
+//             and supporting classes.
+#ifndef MonteCarloSimulator_h
+#define MonteCarloSimulator_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Plan.h"
+#include "ResourceRegistry.h"
+#include "Stockpile.h"
+
+namespace ResourceConversion
+{
+  class MonteCarloSimulator
+  {
+    public:
+    //[DESC]: Settings of a simulation
+    //        - 'Threads' 0 uses every hardware thread
+    //        - 'Percentiles' ranks in [0, 1], reported with the nearest-rank method
+    struct Options
+    {
+      std::uint64_t Trials = 1000;
+      std::uint64_t Seed = 0;
+      std::uint32_t PlanId = 0;
+      unsigned int Threads = 0;
+      std::vector<double> Percentiles = {0.05, 0.5, 0.95};
+    };
+
+    //[DESC]: Distribution of the final quantity of one resource over all trials
+    //        - 'Variance' is the population variance
+    //        - 'Percentiles[k]' belongs to 'Options::Percentiles[k]'
+    struct ResourceStatistics
+    {
+      ResourceId Resource = 0;
+      double Mean = 0.0;
+      double Variance = 0.0;
+      std::size_t Minimum = 0;
+      std::size_t Maximum = 0;
+      std::vector<std::size_t> Percentiles = std::vector<std::size_t>();
+    };
+
+    //[DESC]: Outcome of 'Run(...)', one entry per tracked resource, ordered by 'ResourceId'
+    struct Result
+    {
+      std::uint64_t Trials = 0;
+      std::vector<double> PercentileRanks = std::vector<double>();
+      std::vector<ResourceStatistics> Resources = std::vector<ResourceStatistics>();
+
+      const ResourceStatistics* Find(ResourceId Resource) const;
+    };
+
+    private:
+    Options Settings;
+
+    static std::vector<ResourceId> TrackedResources(const FormulaBook& Recipes, const Stockpile& Initial);
+
+    public:
+    MonteCarloSimulator();
+    explicit MonteCarloSimulator(const Options& Settings_);
+
+    Result Run(const Plan& PlanObj, const Stockpile& Initial) const;
+
+    inline const Options& GetOptions() const { return Settings; }
+  };
+}//[NAMESPACE]: ResourceConversion
+#endif /*MonteCarloSimulator_h*/
@@ -15,12 +15,110 @@
 #include <new>
 #include <memory>
 #include <unordered_map>
+#include <map>
 #include <functional>
+#include <atomic>
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <fstream>
+#include <iterator>
+#include <filesystem>
+#include <algorithm>
+#include <cmath>
+#include <random>
 
 #include "Formula.h"
+#include "RandomEngine.h"
 #include "Plan.h"
 #include "ExecutablePlan.h"
+#include "CompiledPlan.h"
+#include "MonteCarloSimulator.h"
 #include "Stockpile.h"
+#include "PlanExecutor.h"
+#include "PlanReplay.h"
+#include "PlanCheckpoint.h"
+#include "PlanArchive.h"
+#include "ThroughputPlanner.h"
+#include "ResourceGraph.h"
+
+//[NAMESPACE]: Counting allocator hook. Every global 'operator new' of the program bumps 'Count', so a
+//             test can assert that a code path does not allocate {[SEE]: TestApplyAllocations()}.
+//             'Live' counts the blocks not yet deleted, and 'FailAt' makes one chosen allocation throw,
+//             so a test can check that a failed operation leaks nothing {[SEE]: TestPlanCopyFailure()}
+//[NOTE]: Every replaceable form is replaced (single and array, aligned, nothrow), so over-aligned types
+//        such as the cache-line slots of the Concurrent and Sharded modes are counted too.
+namespace Driver::AllocationCounter
+{
+    inline std::atomic<std::size_t> Count{0};
+    inline std::atomic<std::size_t> Live{0};
+    //[NOTE]: When non-zero, the allocation that would bring 'Count' to this value fails
+    inline std::atomic<std::size_t> FailAt{0};
+
+    // [DESC]: The allocation behind every 'operator new' below.
+    // [RETURN]: The block, nullptr if it cannot be allocated or is the one chosen by 'FailAt'
+    inline void* Allocate(std::size_t Size, std::size_t Alignment) noexcept
+    {
+        const std::size_t Number = Count.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (Number == FailAt.load(std::memory_order_relaxed)) { return nullptr; }
+
+        if (Size == 0) { Size = 1; }
+        void* Memory = Alignment <= alignof(std::max_align_t) ? std::malloc(Size)
+                                                              : std::aligned_alloc(Alignment, (Size + Alignment - 1) / Alignment * Alignment);
+        if (Memory != nullptr) { Live.fetch_add(1, std::memory_order_relaxed); }
+        return Memory;
+    }
+
+    inline void* AllocateOrThrow(std::size_t Size, std::size_t Alignment)
+    {
+        if (void* Memory = Allocate(Size, Alignment)) { return Memory; }
+        throw std::bad_alloc();
+    }
+
+    // [DESC]: The release behind every 'operator delete' below.
+    inline void Release(void* Memory) noexcept
+    {
+        if (Memory != nullptr) { Live.fetch_sub(1, std::memory_order_relaxed); }
+        std::free(Memory);
+    }
+}//[NAMESPACE]: Driver::AllocationCounter
+
+void* operator new(std::size_t Size) { return Driver::AllocationCounter::AllocateOrThrow(Size, 0); }
+void* operator new[](std::size_t Size) { return Driver::AllocationCounter::AllocateOrThrow(Size, 0); }
+void* operator new(std::size_t Size, std::align_val_t Alignment)
+{
+    return Driver::AllocationCounter::AllocateOrThrow(Size, static_cast<std::size_t>(Alignment));
+}
+void* operator new[](std::size_t Size, std::align_val_t Alignment)
+{
+    return Driver::AllocationCounter::AllocateOrThrow(Size, static_cast<std::size_t>(Alignment));
+}
+void* operator new(std::size_t Size, const std::nothrow_t&) noexcept { return Driver::AllocationCounter::Allocate(Size, 0); }
+void* operator new[](std::size_t Size, const std::nothrow_t&) noexcept { return Driver::AllocationCounter::Allocate(Size, 0); }
+void* operator new(std::size_t Size, std::align_val_t Alignment, const std::nothrow_t&) noexcept
+{
+    return Driver::AllocationCounter::Allocate(Size, static_cast<std::size_t>(Alignment));
+}
+void* operator new[](std::size_t Size, std::align_val_t Alignment, const std::nothrow_t&) noexcept
+{
+    return Driver::AllocationCounter::Allocate(Size, static_cast<std::size_t>(Alignment));
+}
+
+void operator delete(void* Memory) noexcept { Driver::AllocationCounter::Release(Memory); }
+void operator delete[](void* Memory) noexcept { Driver::AllocationCounter::Release(Memory); }
+void operator delete(void* Memory, std::size_t) noexcept { Driver::AllocationCounter::Release(Memory); }
+void operator delete[](void* Memory, std::size_t) noexcept { Driver::AllocationCounter::Release(Memory); }
+void operator delete(void* Memory, std::align_val_t) noexcept { Driver::AllocationCounter::Release(Memory); }
+void operator delete[](void* Memory, std::align_val_t) noexcept { Driver::AllocationCounter::Release(Memory); }
+void operator delete(void* Memory, std::size_t, std::align_val_t) noexcept { Driver::AllocationCounter::Release(Memory); }
+void operator delete[](void* Memory, std::size_t, std::align_val_t) noexcept { Driver::AllocationCounter::Release(Memory); }
+void operator delete(void* Memory, const std::nothrow_t&) noexcept { Driver::AllocationCounter::Release(Memory); }
+void operator delete[](void* Memory, const std::nothrow_t&) noexcept { Driver::AllocationCounter::Release(Memory); }
+void operator delete(void* Memory, std::align_val_t, const std::nothrow_t&) noexcept { Driver::AllocationCounter::Release(Memory); }
+void operator delete[](void* Memory, std::align_val_t, const std::nothrow_t&) noexcept { Driver::AllocationCounter::Release(Memory); }
 
 namespace Driver {
 
@@ -461,13 +559,1066 @@ namespace Driver {
         std::cout << std::endl;
     }
 
+    // [DESC]: Build a Formula that turns 'InputQuantity' of 'Input' into 'OutputQuantity' of 'Output'.
+    static inline Formula MakeLink(const std::string& Input, unsigned int InputQuantity, const std::string& Output, unsigned int OutputQuantity)
+    {
+        std::string* InR = new (std::nothrow) std::string[1]{ Input };
+        std::string* OutR = new (std::nothrow) std::string[1]{ Output };
+        unsigned int* InQ = new (std::nothrow) unsigned int[1] {InputQuantity};
+        unsigned int* OutQ = new (std::nothrow) unsigned int[1] {OutputQuantity};
+        unsigned int* Result = new (std::nothrow) unsigned int [1] {0};
+
+        return Formula(InR, 1, InQ, 1, OutR, 1, OutQ, 1, Result, 0);
+    }
+
+    // [DESC]: Name of link 'Link' of chain 'Chain', e.g. "Ore2_3".
+    static inline std::string LinkName(const std::string& Prefix, size_t Chain, size_t Link)
+    {
+        return Prefix + std::to_string(Chain) + "_" + std::to_string(Link);
+    }
+
+    // [DESC]: Build a plan of 'Chains' independent chains of 'Length' links each, interleaved step by step.
+    // [NOTE]: Link i of a chain turns one unit of resource i into two of resource i + 1, so steps of the
+    //         same chain depend on each other and steps of different chains do not.
+    static inline ExecutablePlan MakeChains(const std::string& Prefix, size_t Chains, size_t Length)
+    {
+        ExecutablePlan Chained;
+        for (size_t Link = 0; Link < Length; Link++)
+        {
+            for (size_t Chain = 0; Chain < Chains; Chain++)
+            {
+                Chained.AddFormula(MakeLink(LinkName(Prefix, Chain, Link), 1, LinkName(Prefix, Chain, Link + 1), 2));
+            }
+        }
+        return Chained;
+    }
+
+    // [DESC]: Initial quantities for 'MakeChains(...)': 'Initial' units at the start of every chain, every
+    //         other link present and empty.
+    static inline std::unordered_map<std::string, size_t> ChainStock(const std::string& Prefix, size_t Chains, size_t Length, size_t Initial)
+    {
+        std::unordered_map<std::string, size_t> Quantities;
+        for (size_t Chain = 0; Chain < Chains; Chain++)
+        {
+            for (size_t Link = 0; Link <= Length; Link++) { Quantities[LinkName(Prefix, Chain, Link)] = Link == 0 ? Initial : 0; }
+        }
+        return Quantities;
+    }
+
+    // [DESC]: Contents of a stockpile by name, ordered, so stockpiles of different modes can be compared.
+    static inline std::map<std::string, size_t> Contents(const Stockpile& Source)
+    {
+        const std::unordered_map<std::string, size_t> Named = Source.GetResourcesMap();
+        return std::map<std::string, size_t>(Named.begin(), Named.end());
+    }
+
+    // [DESC]: Test the counter-based generator against the Philox4x32-10 known-answer vectors of the
+    //         Random123 reference implementation.
+    // [NOTE]: The first vector is also drawn through a stream (seed 0, plan 0, step 0, trial 0), whose
+    //         first block is the all-zero counter under the all-zero key.
+    // [THROW]: 'std::runtime_error' if a block differs from the reference
+    static inline void TestPhilox()
+    {
+        struct KnownAnswer
+        {
+            Philox4x32::CounterType Counter;
+            Philox4x32::KeyType Key;
+            Philox4x32::CounterType Expected;
+        };
+        const KnownAnswer Vectors[3] = {
+            { {0x00000000U, 0x00000000U, 0x00000000U, 0x00000000U}, {0x00000000U, 0x00000000U},
+              {0x6627e8d5U, 0xe169c58dU, 0xbc57ac4cU, 0x9b00dbd8U} },
+            { {0xffffffffU, 0xffffffffU, 0xffffffffU, 0xffffffffU}, {0xffffffffU, 0xffffffffU},
+              {0x408f276dU, 0x41c83b0eU, 0xa20bc7c6U, 0x6d5451fdU} },
+            { {0x243f6a88U, 0x85a308d3U, 0x13198a2eU, 0x03707344U}, {0xa4093822U, 0x299f31d0U},
+              {0xd16cfe09U, 0x94fdccebU, 0x5001e420U, 0x24126ea1U} } };
+
+        size_t Matching = 0;
+        for (const KnownAnswer& Vector : Vectors)
+        {
+            if (Philox4x32::Block(Vector.Counter, Vector.Key) == Vector.Expected) { Matching++; }
+        }
+
+        Philox4x32 Stream(0, 0, 0, 0);
+        bool StreamMatches = true;
+        for (std::uint32_t Word : Vectors[0].Expected) { StreamMatches = StreamMatches && Stream() == Word; }
+
+        TestOperators::PrintTestTag("<[PHILOX]>");
+        std::cout << "\t" << Matching << " of 3 known answers, stream " << std::boolalpha << StreamMatches << std::endl;
+
+        if (Matching != 3 || !StreamMatches)
+        {
+            throw std::runtime_error("[Driver]TestPhilox() [Philox4x32-10 differs from the reference]");
+        }
+    }
+
+    // [DESC]: Test that reading a plan leaves its compiled program valid and that every way of changing a
+    //         formula makes it stale.
+    // [NOTE]: A read through a const plan must not touch the book. A non-const 'operator[]' may write,
+    //         so it invalidates at once; a 'Formula&' kept across 'Compile(...)' and changed later is
+    //         caught by the recipes the book and the program pinned.
+    // [THROW]: 'std::runtime_error' if a read invalidated the program or a change went unnoticed
+    static inline void TestFormulaBook()
+    {
+        ExecutablePlan Chained = MakeChains("Book", 2, 3);
+        std::shared_ptr<Stockpile> Target = std::make_shared<Stockpile>(ChainStock("Book", 2, 3, 8));
+
+        CompiledPlan Program = Chained.Compile(*Target);
+        const ExecutablePlan& Reader = Chained;
+        const bool ReadKeeps = Reader[0].GetInputQuantities()[0] == 1 && Program.Matches(Chained);
+
+        Formula& Kept = Chained[0];
+        const bool AccessStales = !Program.Matches(Chained);
+
+        Program = Chained.Compile(*Target);
+        const bool Recompiled = Program.Matches(Chained);
+        ++Kept;
+        const bool EditStales = !Program.Matches(Chained) && Chained.GetFormulaBook().GetInputQuantities()[0] == 2;
+
+        bool Refused = false;
+        try { Chained.PlanApply(Program, Target); }
+        catch (const std::invalid_argument&) { Refused = true; }
+
+        TestOperators::PrintTestTag("<[FORMULA BOOK]>");
+        std::cout << "\tconst read keeps program " << std::boolalpha << ReadKeeps << ", operator[] stales it " << AccessStales
+                  << ", kept reference edit caught " << (Recompiled && EditStales) << ", stale program refused " << Refused << std::endl;
+
+        if (!ReadKeeps || !AccessStales || !Recompiled || !EditStales || !Refused)
+        {
+            throw std::runtime_error("[Driver]TestFormulaBook() [Program validity does not follow the plan]");
+        }
+    }
+
+    // [DESC]: Test that copying a plan leaks nothing when an allocation fails part way.
+    // [NOTE]: Every allocation the copy makes is failed once in turn. Each attempt must throw
+    //         'std::bad_alloc' and leave as many live blocks as before it, for the copy constructor and
+    //         for the constructor from a sequence. The formulas have more results than fit inline, so
+    //         copying each one allocates and a copy can fail after some formulas were copied.
+    // [THROW]: 'std::runtime_error' if a failed copy did not throw or leaked
+    static inline void TestPlanCopyFailure()
+    {
+        std::vector<Formula> Sequence;
+        for (size_t i = 0; i < 4; i++)
+        {
+            std::string* InR = new (std::nothrow) std::string[1]{ "CopyOre" };
+            std::string* OutR = new (std::nothrow) std::string[3]{ "CopyA", "CopyB", "CopyC" };
+            unsigned int* InQ = new (std::nothrow) unsigned int[1]{ 1 };
+            unsigned int* OutQ = new (std::nothrow) unsigned int[3]{ 1, 2, 3 };
+            unsigned int* Result = new (std::nothrow) unsigned int[3]{ 0, 0, 0 };
+            Sequence.push_back(Formula(InR, 1, InQ, 1, OutR, 3, OutQ, 3, Result, 0));
+        }
+        const Plan Source(Sequence.data(), Sequence.size());
+
+        const std::function<void()> Copies[2] = {
+            [&Source]() { Plan Copy(Source); },
+            [&Sequence]() { Plan Copy(Sequence.data(), Sequence.size()); } };
+
+        size_t Attempts = 0;
+        size_t Clean = 0;
+        for (const std::function<void()>& MakeCopy : Copies)
+        {
+            const std::size_t Before = AllocationCounter::Count.load();
+            MakeCopy();
+            const std::size_t Needed = AllocationCounter::Count.load() - Before;
+
+            for (std::size_t k = 1; k <= Needed; k++)
+            {
+                const std::size_t LiveBefore = AllocationCounter::Live.load();
+                bool Threw = false;
+                AllocationCounter::FailAt.store(AllocationCounter::Count.load() + k);
+                try { MakeCopy(); } catch (const std::bad_alloc&) { Threw = true; }
+                AllocationCounter::FailAt.store(0);
+
+                Attempts++;
+                if (Threw && AllocationCounter::Live.load() == LiveBefore) { Clean++; }
+            }
+        }
+
+        TestOperators::PrintTestTag("<[COPY FAILURE]>");
+        std::cout << "\t" << Clean << " of " << Attempts << " failed copies threw and leaked nothing" << std::endl;
+
+        if (Attempts == 0 || Clean != Attempts)
+        {
+            throw std::runtime_error("[Driver]TestPlanCopyFailure() [Failed copy leaked or did not throw]");
+        }
+    }
+
+    // [DESC]: Test the Monte-Carlo simulator and the step semantics it shares with 'PlanApply'.
+    // [NOTE]: Three steps turn one MonteOre into MonteBar but only two MonteOre are there, so every trial
+    //         ends with 0 MonteOre and the untouched MonteCoal: their mean and every percentile are
+    //         exact. MonteBar is random; its mean must be close to twice the mean yield of one step
+    //         ('ApplyBatch' over as many draws), its percentiles ordered, and the whole result the same on one and on four
+    //         threads. 'PlanApply' must withdraw the inputs, deposit what the formula realized, and
+    //         leave the stockpile alone once the inputs run short.
+    // [THROW]: 'std::runtime_error' if a statistic is off or a step moved the wrong quantities
+    static inline void TestMonteCarlo()
+    {
+        ExecutablePlan Smelting;
+        for (size_t i = 0; i < 3; i++) { Smelting.AddFormula(MakeLink("MonteOre", 1, "MonteBar", 4)); }
+        const Stockpile Initial(std::unordered_map<std::string, size_t>{{"MonteOre", 2}, {"MonteCoal", 9}, {"MonteBar", 0}});
+        ResourceRegistry& Registry = ResourceRegistry::Instance();
+
+        MonteCarloSimulator::Options Settings;
+        Settings.Trials = 20000;
+        Settings.Seed = 10;
+        Settings.Threads = 1;
+        const MonteCarloSimulator::Result Single = MonteCarloSimulator(Settings).Run(Smelting, Initial);
+        Settings.Threads = 4;
+        const MonteCarloSimulator::Result Parallel = MonteCarloSimulator(Settings).Run(Smelting, Initial);
+
+        bool SameOnThreads = Single.Resources.size() == Parallel.Resources.size();
+        for (size_t k = 0; k < Single.Resources.size() && SameOnThreads; k++)
+        {
+            const MonteCarloSimulator::ResourceStatistics& One = Single.Resources[k];
+            const MonteCarloSimulator::ResourceStatistics& Four = Parallel.Resources[k];
+            SameOnThreads = One.Resource == Four.Resource && One.Mean == Four.Mean && One.Variance == Four.Variance &&
+                            One.Minimum == Four.Minimum && One.Maximum == Four.Maximum && One.Percentiles == Four.Percentiles;
+        }
+
+        auto IsExactly = [&Single, &Registry](const std::string& Name, std::size_t Quantity) -> bool {
+            const MonteCarloSimulator::ResourceStatistics* Statistics = Single.Find(Registry.Intern(Name));
+            return Statistics != nullptr && Statistics -> Mean == static_cast<double>(Quantity) && Statistics -> Variance == 0.0 &&
+                   Statistics -> Minimum == Quantity && Statistics -> Maximum == Quantity &&
+                   Statistics -> Percentiles == std::vector<std::size_t>(Single.PercentileRanks.size(), Quantity);
+        };
+        const bool Exact = IsExactly("MonteOre", 0) && IsExactly("MonteCoal", 9);
+
+        Formula::BatchResult Batch{};
+        Xoshiro256StarStar Generator(10);
+        Smelting.GetFormula(0).ApplyBatch(Settings.Trials, Batch, Generator);
+        const double Expected = static_cast<double>(Batch.OutputTotals[0]) / static_cast<double>(Settings.Trials);
+        const MonteCarloSimulator::ResourceStatistics* Bar = Single.Find(Registry.Intern("MonteBar"));
+        const bool BarFits = Bar != nullptr && std::abs(Bar -> Mean - 2.0 * Expected) < 0.05 * 2.0 * Expected &&
+                             Bar -> Minimum <= Bar -> Percentiles[0] && Bar -> Percentiles[0] <= Bar -> Percentiles[1] &&
+                             Bar -> Percentiles[1] <= Bar -> Percentiles[2] && Bar -> Percentiles[2] <= Bar -> Maximum;
+
+        ExecutablePlan Step;
+        Step.AddFormula(MakeLink("MonteOre", 2, "MonteBar", 4));
+        Step.SetSeed(10);
+        std::shared_ptr<Stockpile> Target = std::make_shared<Stockpile>(std::unordered_map<std::string, size_t>{{"MonteOre", 5}, {"MonteBar", 1}});
+        bool StepsMove = true;
+        size_t Bars = 1;
+        for (size_t Round = 0; Round < 3; Round++)
+        {
+            Step.PlanApply(Target);
+            const bool Ran = Round < 2;
+            if (Ran) { Bars += Step.GetFormula(0).GetResultArray()[0]; }
+            StepsMove = StepsMove && Target -> GetResourceQuantity("MonteOre") == (Ran ? 3 - 2 * Round : 1) &&
+                        Target -> GetResourceQuantity("MonteBar") == Bars;
+        }
+
+        TestOperators::PrintTestTag("<[MONTE CARLO]>");
+        std::cout << "\t" << Single.Trials << " trials, MonteBar mean " << (Bar != nullptr ? Bar -> Mean : 0.0) << " (batch " << 2.0 * Expected
+                  << "), 1 and 4 threads agree " << std::boolalpha << SameOnThreads << ", exact stats " << Exact
+                  << ", PlanApply moves realized results " << StepsMove << std::endl;
+
+        if (!SameOnThreads || !Exact || !BarFits || !StepsMove)
+        {
+            throw std::runtime_error("[Driver]TestMonteCarlo() [Simulation statistics or step semantics are off]");
+        }
+    }
+
+    // [DESC]: Test that the Concurrent mode loses no units when many threads withdraw and deposit at once.
+    // [NOTE]: Every thread withdraws one unit at a time until the resource runs out, then the same threads
+    //         deposit everything back. The units taken must add up to the initial quantity, and the
+    //         quantity must be back where it started.
+    // [THROW]: 'std::runtime_error' if a unit was lost or counted twice
+    static inline void TestConcurrentStockpile()
+    {
+        constexpr size_t Threads = 4;
+        constexpr size_t InitialQuantity = 20000;
+
+        Stockpile SharedStockpile(std::unordered_map<std::string, size_t>{{"A1", InitialQuantity}}, Stockpile::StorageMode::Concurrent);
+        const ResourceId Resource = ResourceRegistry::Instance().Intern("A1");
+
+        std::vector<size_t> Taken(Threads, 0);
+        std::vector<std::thread> Workers;
+        for (size_t t = 0; t < Threads; t++)
+        {
+            Workers.emplace_back([&SharedStockpile, &Taken, Resource, t]() { while (SharedStockpile.Withdraw(Resource, 1)) { Taken[t]++; } });
+        }
+        for (std::thread& Worker : Workers) { Worker.join(); }
+
+        size_t TakenTotal = 0;
+        for (size_t Count : Taken) { TakenTotal += Count; }
+        const size_t Emptied = SharedStockpile.GetResourceQuantity(Resource);
+
+        Workers.clear();
+        for (size_t t = 0; t < Threads; t++)
+        {
+            Workers.emplace_back([&SharedStockpile, &Taken, Resource, t]() { for (size_t i = 0; i < Taken[t]; i++) { SharedStockpile.Deposit(Resource, 1); } });
+        }
+        for (std::thread& Worker : Workers) { Worker.join(); }
+
+        TestOperators::PrintTestTag("<[CONCURRENT]>");
+        std::cout << "\t" << Threads << " threads took " << TakenTotal << " of " << InitialQuantity << ", "
+                  << SharedStockpile.GetResourceQuantity(Resource) << " after depositing back" << std::endl;
+
+        if (TakenTotal != InitialQuantity || Emptied != 0 || SharedStockpile.GetResourceQuantity(Resource) != InitialQuantity)
+        {
+            throw std::runtime_error("[Driver]TestConcurrentStockpile() [Units lost or duplicated]");
+        }
+    }
+
+    // [DESC]: Test that 'TryConsume' takes all of a batch or nothing, in every storage mode.
+    // [NOTE]: The batch names one resource twice, so the check has to add both amounts up. The first batch
+    //         asks for one unit too many and must leave the stockpile untouched, the second takes
+    //         everything, and 'Produce' puts the same batch back.
+    // [THROW]: 'std::runtime_error' if a batch was applied in part
+    static inline void TestTryConsume()
+    {
+        const Stockpile::StorageMode Modes[] = { Stockpile::StorageMode::Map, Stockpile::StorageMode::Dense,
+                                                 Stockpile::StorageMode::Concurrent, Stockpile::StorageMode::Sharded,
+                                                 Stockpile::StorageMode::Versioned };
+        ResourceRegistry& Registry = ResourceRegistry::Instance();
+        const ResourceId Batch[3] = { Registry.Intern("A1"), Registry.Intern("B1"), Registry.Intern("A1") };
+
+        for (Stockpile::StorageMode Mode : Modes)
+        {
+            Stockpile BatchStockpile(std::unordered_map<std::string, size_t>{{"A1", 5}, {"B1", 1}}, Mode);
+
+            const unsigned int TooMuch[3] = { 2, 1, 4 };
+            const bool Refused = !BatchStockpile.TryConsume(Batch, TooMuch, 3) &&
+                                 BatchStockpile.GetResourceQuantity("A1") == 5 && BatchStockpile.GetResourceQuantity("B1") == 1;
+
+            const unsigned int Exact[3] = { 2, 1, 3 };
+            const bool Consumed = BatchStockpile.TryConsume(Batch, Exact, 3) &&
+                                  BatchStockpile.GetResourceQuantity("A1") == 0 && BatchStockpile.GetResourceQuantity("B1") == 0;
+
+            BatchStockpile.Produce(Batch, Exact, 3);
+            const bool Produced = BatchStockpile.GetResourceQuantity("A1") == 5 && BatchStockpile.GetResourceQuantity("B1") == 1;
+
+            TestOperators::PrintTestTag("<[ALL OR NOTHING]>");
+            std::cout << "\tmode " << static_cast<int>(Mode) << ": refused " << std::boolalpha << Refused
+                      << ", consumed " << Consumed << ", produced " << Produced << std::endl;
+
+            if (!Refused || !Consumed || !Produced)
+            {
+                throw std::runtime_error("[Driver]TestTryConsume() [Batch applied in part]");
+            }
+        }
+    }
+
+    // [DESC]: Apply a seeded chain plan for a few rounds on a stockpile of the given mode.
+    // [RETURN]: The contents afterwards; the same for every mode if the modes agree
+    static inline std::map<std::string, size_t> ApplySeededChains(Stockpile::StorageMode Mode)
+    {
+        constexpr size_t Chains = 4;
+        constexpr size_t Length = 6;
+        constexpr size_t Rounds = 3;
+
+        ExecutablePlan Chained = MakeChains("Mode", Chains, Length);
+        Chained.SetSeed(42);
+        std::shared_ptr<Stockpile> Target = std::make_shared<Stockpile>(ChainStock("Mode", Chains, Length, 8), Mode);
+        for (size_t Round = 0; Round < Rounds; Round++) { Chained.PlanApply(Target); }
+        return Contents(*Target);
+    }
+
+    // [DESC]: Test that the Sharded mode ends up where the Map mode does, and that concurrent deposits
+    //         spread over the shards add up.
+    // [NOTE]: The same seeded plan runs on both modes, so every draw and every step is the same.
+    // [THROW]: 'std::runtime_error' if the modes disagree or a deposit was lost
+    static inline void TestShardedStockpile()
+    {
+        const bool SameAsMap = ApplySeededChains(Stockpile::StorageMode::Sharded) == ApplySeededChains(Stockpile::StorageMode::Map);
+
+        constexpr size_t Threads = 4;
+        constexpr size_t Deposits = 10000;
+        Stockpile ShardedStockpile(std::unordered_map<std::string, size_t>{{"B1", 0}}, Stockpile::StorageMode::Sharded);
+        const ResourceId Resource = ResourceRegistry::Instance().Intern("B1");
+
+        std::vector<std::thread> Workers;
+        for (size_t t = 0; t < Threads; t++)
+        {
+            Workers.emplace_back([&ShardedStockpile, Resource]() { for (size_t i = 0; i < Deposits; i++) { ShardedStockpile.Deposit(Resource, 1); } });
+        }
+        for (std::thread& Worker : Workers) { Worker.join(); }
+        ShardedStockpile.Rebalance();
+        const size_t Total = ShardedStockpile.GetResourceQuantity(Resource);
+
+        TestOperators::PrintTestTag("<[SHARDED]>");
+        std::cout << "\tsame as Map " << std::boolalpha << SameAsMap << ", " << Total << " of "
+                  << Threads * Deposits << " deposits" << std::endl;
+
+        if (!SameAsMap || Total != Threads * Deposits)
+        {
+            throw std::runtime_error("[Driver]TestShardedStockpile() [Sharded mode disagrees with Map mode]");
+        }
+    }
+
+    // [DESC]: Test that every way of reading a stockpile sees every resource, and that a snapshot stays
+    //         as it was taken, in every storage mode.
+    // [NOTE]: The stockpile holds empty and filled resources, plus one interned only after it was built.
+    //         The iterator, 'ForEachResource' and 'Snapshot()' must each yield every non-zero resource
+    //         with its quantity. A snapshot taken before more deposits must not see them; the next one must.
+    // [THROW]: 'std::runtime_error' if a read missed a resource or a snapshot changed
+    static inline void TestStockpileIteration()
+    {
+        const Stockpile::StorageMode Modes[] = { Stockpile::StorageMode::Map, Stockpile::StorageMode::Dense,
+                                                 Stockpile::StorageMode::Concurrent, Stockpile::StorageMode::Sharded,
+                                                 Stockpile::StorageMode::Versioned };
+        ResourceRegistry& Registry = ResourceRegistry::Instance();
+
+        for (Stockpile::StorageMode Mode : Modes)
+        {
+            const std::string Late = "IterLate" + std::to_string(static_cast<int>(Mode));
+            Stockpile Resources(std::unordered_map<std::string, size_t>{{"IterA", 3}, {"IterB", 0}, {"IterC", 7}, {"IterD", 1}}, Mode);
+            Resources.Deposit(Registry.Intern(Late), 5);
+            const std::map<std::string, size_t> Filled = { {"IterA", 3}, {"IterC", 7}, {"IterD", 1}, {Late, 5} };
+
+            auto CoversFilled = [&Filled](const std::map<std::string, size_t>& Seen) -> bool {
+                for (const std::pair<const std::string, size_t>& Item : Seen)
+                {
+                    const auto Match = Filled.find(Item.first);
+                    if (Item.second != 0 && (Match == Filled.end() || Match -> second != Item.second)) { return false; }
+                }
+                for (const std::pair<const std::string, size_t>& Item : Filled)
+                {
+                    const auto Match = Seen.find(Item.first);
+                    if (Match == Seen.end() || Match -> second != Item.second) { return false; }
+                }
+                return true;
+            };
+
+            std::map<std::string, size_t> Iterated;
+            for (const std::pair<ResourceId, size_t> Item : Resources) { Iterated[Registry.GetName(Item.first)] = Item.second; }
+            std::map<std::string, size_t> Visited;
+            Resources.ForEachResource([&Visited, &Registry](ResourceId Resource, size_t Quantity) { Visited[Registry.GetName(Resource)] = Quantity; });
+
+            const std::shared_ptr<const StockpileSnapshot> Before = Resources.Snapshot();
+            std::map<std::string, size_t> Snapshotted;
+            for (const StockpileSnapshot::Entry& Item : *Before) { Snapshotted[Registry.GetName(Item.first)] = Item.second; }
+            const bool Covered = CoversFilled(Iterated) && CoversFilled(Visited) && CoversFilled(Snapshotted);
+
+            Resources.Deposit(Registry.Intern("IterA"), 10);
+            Resources.Deposit(Registry.Intern("IterFresh"), 2);
+            std::map<std::string, size_t> Kept;
+            for (const StockpileSnapshot::Entry& Item : *Before) { Kept[Registry.GetName(Item.first)] = Item.second; }
+            const std::shared_ptr<const StockpileSnapshot> After = Resources.Snapshot();
+            const bool Pinned = Kept == Snapshotted && Before -> GetResourceQuantity(Registry.Intern("IterA")) == 3 &&
+                                !Before -> HasResource(Registry.Intern("IterFresh")) &&
+                                After -> GetResourceQuantity(Registry.Intern("IterA")) == 13 &&
+                                After -> GetResourceQuantity(Registry.Intern("IterFresh")) == 2;
+
+            TestOperators::PrintTestTag("<[ITERATION]>");
+            std::cout << "\tmode " << static_cast<int>(Mode) << ": every resource seen " << std::boolalpha << Covered
+                      << ", snapshot unchanged by deposits " << Pinned << std::endl;
+
+            if (!Covered || !Pinned)
+            {
+                throw std::runtime_error("[Driver]TestStockpileIteration() [Iteration missed a resource or a snapshot changed]");
+            }
+        }
+    }
+
+    // [DESC]: Test that the Versioned mode matches the Map mode and that readers keep the version they
+    //         started on.
+    // [NOTE]: A snapshot taken before the plan runs must still show the initial quantities afterwards,
+    //         and a walk over the stockpile that adds resources as it goes must only see the resources
+    //         that were there when it began.
+    // [THROW]: 'std::runtime_error' if the modes disagree or a reader saw a later version
+    static inline void TestVersionedStockpile()
+    {
+        const bool SameAsMap = ApplySeededChains(Stockpile::StorageMode::Versioned) == ApplySeededChains(Stockpile::StorageMode::Map);
+
+        const std::unordered_map<std::string, size_t> Initial = ChainStock("Version", 2, 3, 8);
+        ExecutablePlan Chained = MakeChains("Version", 2, 3);
+        std::shared_ptr<Stockpile> Target = std::make_shared<Stockpile>(Initial, Stockpile::StorageMode::Versioned);
+
+        std::shared_ptr<const StockpileSnapshot> Before = Target -> Snapshot();
+        Chained.PlanApply(Target);
+        bool SnapshotHeld = Before -> Size() == Initial.size();
+        for (const StockpileSnapshot::Entry& Held : *Before)
+        {
+            SnapshotHeld = SnapshotHeld && Held.second == Initial.at(ResourceRegistry::Instance().GetName(Held.first));
+        }
+
+        size_t Walked = 0;
+        for (const auto& Held : *Target)
+        {
+            Target -> Deposit(ResourceRegistry::Instance().Intern("Fresh" + std::to_string(Held.first)), 1);
+            Walked++;
+        }
+        const bool WalkHeld = Walked == Initial.size();
+
+        TestOperators::PrintTestTag("<[VERSIONED]>");
+        std::cout << "\tsame as Map " << std::boolalpha << SameAsMap << ", snapshot held " << SnapshotHeld
+                  << ", walk held " << WalkHeld << std::endl;
+
+        if (!SameAsMap || !SnapshotHeld || !WalkHeld)
+        {
+            throw std::runtime_error("[Driver]TestVersionedStockpile() [Versioned mode disagrees or a reader moved]");
+        }
+    }
+
+    // [DESC]: Test that a compiled program leaves the stockpile exactly as the uncompiled 'PlanApply' does,
+    //         in every storage mode, also after the plan was edited.
+    // [NOTE]: Two copies of one seeded plan draw the same values, one runs uncompiled and one compiled.
+    //         After the same formula is replaced in both, the old program must be refused; a fresh one
+    //         must again match the uncompiled run.
+    // [THROW]: 'std::runtime_error' if the runs differ or a stale program ran
+    static inline void TestCompiledPlan()
+    {
+        constexpr size_t Chains = 3;
+        constexpr size_t Length = 4;
+        constexpr size_t Rounds = 3;
+        const Stockpile::StorageMode Modes[] = { Stockpile::StorageMode::Map, Stockpile::StorageMode::Dense,
+                                                 Stockpile::StorageMode::Concurrent, Stockpile::StorageMode::Sharded,
+                                                 Stockpile::StorageMode::Versioned };
+
+        for (Stockpile::StorageMode Mode : Modes)
+        {
+            ExecutablePlan Uncompiled = MakeChains("Comp", Chains, Length);
+            Uncompiled.SetSeed(16);
+            ExecutablePlan Compiled = Uncompiled;
+            std::shared_ptr<Stockpile> Expected = std::make_shared<Stockpile>(ChainStock("Comp", Chains, Length, 8), Mode);
+            std::shared_ptr<Stockpile> Target = std::make_shared<Stockpile>(ChainStock("Comp", Chains, Length, 8), Mode);
+
+            const CompiledPlan Program = Compiled.Compile(*Target);
+            for (size_t Round = 0; Round < Rounds; Round++)
+            {
+                Uncompiled.PlanApply(Expected);
+                Compiled.PlanApply(Program, Target);
+            }
+            const bool SameBefore = Contents(*Target) == Contents(*Expected);
+
+            const Formula Edited = MakeLink(LinkName("Comp", 1, 0), 3, LinkName("Comp", 1, 1), 5);
+            Uncompiled.ReplaceFormula(Edited, 1);
+            Compiled.ReplaceFormula(Edited, 1);
+            bool StaleRefused = false;
+            try { Compiled.PlanApply(Program, Target); }
+            catch (const std::invalid_argument&) { StaleRefused = true; }
+
+            const CompiledPlan Recompiled = Compiled.Compile(*Target);
+            for (size_t Round = 0; Round < Rounds; Round++)
+            {
+                Uncompiled.PlanApply(Expected);
+                Compiled.PlanApply(Recompiled, Target);
+            }
+            const bool SameAfter = Contents(*Target) == Contents(*Expected);
+
+            TestOperators::PrintTestTag("<[COMPILED]>");
+            std::cout << "\tmode " << static_cast<int>(Mode) << ": same as uncompiled " << std::boolalpha << SameBefore
+                      << ", stale program refused " << StaleRefused << ", same after edit and recompile " << SameAfter << std::endl;
+
+            if (!SameBefore || !StaleRefused || !SameAfter)
+            {
+                throw std::runtime_error("[Driver]TestCompiledPlan() [Compiled run differs from PlanApply or a stale program ran]");
+            }
+        }
+    }
+
+    // [DESC]: Test that applying a plan does not allocate, in every storage mode that updates in place.
+    // [NOTE]: The stockpile already holds every resource of the plan, so no step has to add one. The
+    //         uncompiled 'PlanApply' is measured from the first call, the compiled one after a warm-up
+    //         run that sizes its per-thread register file.
+    //         'Versioned' is left out on purpose, every change allocates a new version there.
+    //         First the hook itself is checked: aligned and nothrow allocations must be counted as well.
+    // [THROW]: 'std::runtime_error' if the hook misses an allocation or any step allocated
+    static inline void TestApplyAllocations()
+    {
+        const std::size_t HookBefore = AllocationCounter::Count.load();
+        const std::size_t LiveBefore = AllocationCounter::Live.load();
+        void* Aligned = ::operator new(64, std::align_val_t{64});
+        void* NoThrow = ::operator new(16, std::nothrow);
+        void* AlignedArray = ::operator new[](128, std::align_val_t{64}, std::nothrow);
+        const bool HookCounts = AllocationCounter::Count.load() - HookBefore == 3 && AllocationCounter::Live.load() - LiveBefore == 3 &&
+                                reinterpret_cast<std::uintptr_t>(Aligned) % 64 == 0 && reinterpret_cast<std::uintptr_t>(AlignedArray) % 64 == 0;
+        ::operator delete(Aligned, std::align_val_t{64});
+        ::operator delete(NoThrow, std::nothrow);
+        ::operator delete[](AlignedArray, std::align_val_t{64}, std::nothrow);
+        if (!HookCounts || AllocationCounter::Live.load() != LiveBefore)
+        {
+            throw std::runtime_error("[Driver]TestApplyAllocations() [Allocation hook missed an aligned or nothrow allocation]");
+        }
+
+        Formula FExm1; 
+        Formula FExm2;
+        Formula FExm3;
+        Formula FExm4;
+
+        Example::InitFormulas(FExm1, FExm2, FExm3, FExm4);
+        Formula FormulaSeq[4] = { FExm1, FExm2, FExm3, FExm4 };
+        ExecutablePlan ExPlanAllocTest(FormulaSeq, 4, 0);
+
+        constexpr size_t Rounds = 100;
+        constexpr size_t InitialQuantity = 1000000;
+        const Stockpile::StorageMode Modes[] = { Stockpile::StorageMode::Map, Stockpile::StorageMode::Dense,
+                                                 Stockpile::StorageMode::Concurrent, Stockpile::StorageMode::Sharded };
+
+        for (Stockpile::StorageMode Mode : Modes)
+        {
+            std::shared_ptr<Stockpile> AllocStockpile = std::make_shared<Stockpile>(std::unordered_map<std::string, size_t>{{FExm1.GetInputResourceName(0), InitialQuantity}}, Mode);
+            for (size_t i = 0; i < ExPlanAllocTest.GetSize(); i++)
+            {
+                const Formula::ResourceView Recipe = ExPlanAllocTest.GetFormula(i).GetView();
+                for (ResourceId Resource : Recipe.InputResources) { AllocStockpile -> Deposit(Resource, InitialQuantity); }
+                for (ResourceId Resource : Recipe.OutputResources) { AllocStockpile -> Deposit(Resource, 0); }
+            }
+
+            const std::size_t Before = AllocationCounter::Count.load();
+            for (size_t Round = 0; Round < Rounds; Round++) { ExPlanAllocTest.PlanApply(AllocStockpile); }
+            const std::size_t Uncompiled = AllocationCounter::Count.load() - Before;
+
+            const CompiledPlan Program = ExPlanAllocTest.Compile(*AllocStockpile);
+            ExPlanAllocTest.PlanApply(Program, AllocStockpile);
+            const std::size_t BeforeCompiled = AllocationCounter::Count.load();
+            for (size_t Round = 0; Round < Rounds; Round++) { ExPlanAllocTest.PlanApply(Program, AllocStockpile); }
+            const std::size_t Compiled = AllocationCounter::Count.load() - BeforeCompiled;
+
+            TestOperators::PrintTestTag("<[ZERO ALLOCATIONS]>");
+            std::cout << "\tmode " << static_cast<int>(Mode) << ", " << Rounds * ExPlanAllocTest.GetSize() << " steps: "
+                      << Uncompiled << " (PlanApply) / " << Compiled << " (compiled)" << std::endl;
+
+            if (Uncompiled != 0 || Compiled != 0)
+            {
+                throw std::runtime_error("[Driver]TestApplyAllocations() [PlanApply allocated]");
+            }
+        }
+    }
+
+    // [DESC]: Test that running independent steps in parallel gives what the sequential compiled run gives.
+    // [NOTE]: The plan is seeded, so the draws do not depend on which worker runs a step; pools of one,
+    //         two and four workers must all match the sequential run.
+    // [THROW]: 'std::runtime_error' if a parallel run differs
+    static inline void TestParallelApply()
+    {
+        constexpr size_t Chains = 8;
+        constexpr size_t Length = 6;
+        constexpr size_t Rounds = 3;
+        const std::unordered_map<std::string, size_t> Initial = ChainStock("Par", Chains, Length, 8);
+
+        ExecutablePlan Sequential = MakeChains("Par", Chains, Length);
+        Sequential.SetSeed(7);
+        std::shared_ptr<Stockpile> Expected = std::make_shared<Stockpile>(Initial, Stockpile::StorageMode::Dense);
+        const CompiledPlan SequentialProgram = Sequential.Compile(*Expected);
+        for (size_t Round = 0; Round < Rounds; Round++) { Sequential.PlanApply(SequentialProgram, Expected); }
+
+        const size_t PoolSizes[] = { 1, 2, 4 };
+        for (size_t Workers : PoolSizes)
+        {
+            WorkStealingPool Pool(Workers);
+            ExecutablePlan Parallel = MakeChains("Par", Chains, Length);
+            Parallel.SetSeed(7);
+            std::shared_ptr<Stockpile> Target = std::make_shared<Stockpile>(Initial, Stockpile::StorageMode::Dense);
+            const CompiledPlan Program = Parallel.Compile(*Target);
+            for (size_t Round = 0; Round < Rounds; Round++) { Parallel.PlanApply(Program, Target, Pool); }
+
+            const bool Same = Contents(*Target) == Contents(*Expected);
+            TestOperators::PrintTestTag("<[PARALLEL]>");
+            std::cout << "\t" << Workers << " workers, " << Program.GetGraph().EdgeCount() << " edges: same as sequential "
+                      << std::boolalpha << Same << std::endl;
+
+            if (!Same)
+            {
+                throw std::runtime_error("[Driver]TestParallelApply() [Parallel run differs from sequential run]");
+            }
+        }
+    }
+
+    // [DESC]: Test that 'PlanExecutor' applies many plans at once exactly like applying them one by one.
+    // [NOTE]: Every plan has its own seed and its own stockpile, half of them pinned ('Dense') and half
+    //         shared between workers ('Concurrent'), so the result of each one is known in advance.
+    // [THROW]: 'std::runtime_error' if a plan ended up somewhere else
+    static inline void TestPlanExecutor()
+    {
+        constexpr size_t PlanCount = 16;
+        const std::unordered_map<std::string, size_t> Initial = ChainStock("Exec", 2, 4, 8);
+
+        std::vector<ExecutablePlan> Expected(PlanCount, MakeChains("Exec", 2, 4));
+        std::vector<ExecutablePlan> Submitted(Expected);
+        std::vector<std::shared_ptr<Stockpile>> ExpectedStockpiles;
+        std::vector<std::future<std::shared_ptr<Stockpile>>> Done;
+
+        PlanExecutor Executor(4);
+        for (size_t k = 0; k < PlanCount; k++)
+        {
+            const Stockpile::StorageMode Mode = k % 2 == 0 ? Stockpile::StorageMode::Dense : Stockpile::StorageMode::Concurrent;
+            Expected[k].SetSeed(k);
+            Submitted[k].SetSeed(k);
+            ExpectedStockpiles.push_back(Expected[k].PlanApply(std::make_shared<Stockpile>(Initial, Mode)));
+            Done.push_back(Executor.Submit(Submitted[k], std::make_shared<Stockpile>(Initial, Mode)));
+        }
+
+        size_t Matching = 0;
+        for (size_t k = 0; k < PlanCount; k++)
+        {
+            if (Contents(*Done[k].get()) == Contents(*ExpectedStockpiles[k])) { Matching++; }
+        }
+
+        TestOperators::PrintTestTag("<[EXECUTOR]>");
+        std::cout << "\t" << Executor.GetWorkerCount() << " workers: " << Matching << " of " << PlanCount
+                  << " plans same as applied one by one" << std::endl;
+
+        if (Matching != PlanCount)
+        {
+            throw std::runtime_error("[Driver]TestPlanExecutor() [Executor result differs from PlanApply]");
+        }
+    }
+
+    // [DESC]: Test a pipeline of plans that wait for their inputs ('InputPolicy::Wait').
+    // [NOTE]: Stage k turns "Pipe0_k" into "Pipe0_k+1" on one shared stockpile. The stages are submitted
+    //         last first, so every stage but the first has to wait for the one before it; the result must
+    //         be what applying the stages in order gives.
+    //         'WaitIdle()' comes before the futures are read: a stage whose inputs never arrive only
+    //         gives up on a step while 'WaitIdle()' runs {[SEE]: PlanExecutor.h}.
+    // [THROW]: 'std::runtime_error' if a stage skipped a step it should have waited for
+    static inline void TestWaitPipeline()
+    {
+        constexpr size_t Stages = 8;
+        constexpr size_t StepsPerStage = 5;
+        const std::unordered_map<std::string, size_t> Initial = ChainStock("Pipe", 1, Stages, 5);
+
+        std::vector<ExecutablePlan> Pipeline(Stages);
+        for (size_t k = 0; k < Stages; k++)
+        {
+            for (size_t i = 0; i < StepsPerStage; i++) { Pipeline[k].AddFormula(MakeLink(LinkName("Pipe", 0, k), 1, LinkName("Pipe", 0, k + 1), 4)); }
+            Pipeline[k].SetSeed(k);
+        }
+        std::vector<ExecutablePlan> InOrder(Pipeline);
+
+        std::shared_ptr<Stockpile> Expected = std::make_shared<Stockpile>(Initial, Stockpile::StorageMode::Concurrent);
+        for (ExecutablePlan& Stage : InOrder) { Stage.PlanApply(Expected); }
+
+        std::shared_ptr<Stockpile> Target = std::make_shared<Stockpile>(Initial, Stockpile::StorageMode::Concurrent);
+        std::vector<std::future<std::shared_ptr<Stockpile>>> Done;
+        PlanExecutor Executor(4);
+        for (size_t k = Stages; k-- > 0;) { Done.push_back(Executor.Submit(Pipeline[k], Target, PlanExecutor::InputPolicy::Wait)); }
+        Executor.WaitIdle();
+        for (std::future<std::shared_ptr<Stockpile>>& Stage : Done) { Stage.get(); }
+
+        const bool Same = Contents(*Target) == Contents(*Expected);
+        TestOperators::PrintTestTag("<[WAIT PIPELINE]>");
+        std::cout << "\t" << Stages << " stages submitted in reverse, last stage made " << Target -> GetResourceQuantity(LinkName("Pipe", 0, Stages))
+                  << ": same as in order " << std::boolalpha << Same << std::endl;
+
+        if (!Same)
+        {
+            throw std::runtime_error("[Driver]TestWaitPipeline() [Waiting pipeline differs from running in order]");
+        }
+    }
+
+    // [DESC]: Test that 'ThroughputPlanner' finds the optimum of a program small enough to solve by hand.
+    // [NOTE]: 10 Ore and at most 7 applications; formula 0 turns 1 Ore into E0 Bar, formula 1 turns 2 Ore
+    //         into E1 Bar (expected yields), and a Coal formula has no path to Bar. With E0 < E1 < 2 * E0
+    //         both limits bind: x0 + 2 x1 = 10 and x0 + x1 = 7 give x0 = 4, x1 = 3, so the bound and the
+    //         expected output are 4 * E0 + 3 * E1 and the Coal formula is never scheduled.
+    // [THROW]: 'std::runtime_error' if the schedule or the bound is not the hand-derived optimum
+    static inline void TestThroughputPlanner()
+    {
+        ExecutablePlan Candidates;
+        Candidates.AddFormula(MakeLink("PlanOre", 1, "PlanBar", 4));
+        Candidates.AddFormula(MakeLink("PlanOre", 2, "PlanBar", 6));
+        Candidates.AddFormula(MakeLink("PlanCoal", 1, "PlanSlag", 1));
+        double E0 = 0.0;
+        double E1 = 0.0;
+        Candidates.GetFormula(0).ExpectedOutputs(&E0);
+        Candidates.GetFormula(1).ExpectedOutputs(&E1);
+
+        const Stockpile Start(std::unordered_map<std::string, size_t>{{"PlanOre", 10}, {"PlanCoal", 5}});
+        ThroughputPlanner Planner;
+        const ThroughputPlanner::Schedule Best = Planner.Optimize(Candidates, Start, "PlanBar", 7);
+
+        size_t Counts[3] = { 0, 0, 0 };
+        for (const ThroughputPlanner::Entry& Step : Best.Steps) { Counts[Step.Formula] += Step.Repetitions; }
+        const double Optimum = 4 * E0 + 3 * E1;
+        const bool Premise = E0 < E1 && E1 < 2 * E0;
+        const bool Optimal = std::abs(Best.Bound - Optimum) < 1e-9 && std::abs(Best.ExpectedOutput - Optimum) < 1e-9;
+        const bool Counted = Counts[0] == 4 && Counts[1] == 3 && Counts[2] == 0 && Best.Applications == 7;
+
+        TestOperators::PrintTestTag("<[THROUGHPUT]>");
+        std::cout << "\tbound " << Best.Bound << ", expected " << Best.ExpectedOutput << " (hand-derived " << Optimum
+                  << "), counts " << Counts[0] << "/" << Counts[1] << "/" << Counts[2] << std::endl;
+
+        if (!Premise || !Optimal || !Counted)
+        {
+            throw std::runtime_error("[Driver]TestThroughputPlanner() [Schedule differs from the hand-derived optimum]");
+        }
+    }
+
+    // [DESC]: Build a Formula that turns one unit each of 'Left' and 'Right' into one unit of 'Output'.
+    static inline Formula MakeJoin(const std::string& Left, const std::string& Right, const std::string& Output)
+    {
+        std::string* InR = new (std::nothrow) std::string[2]{ Left, Right };
+        std::string* OutR = new (std::nothrow) std::string[1]{ Output };
+        unsigned int* InQ = new (std::nothrow) unsigned int[2] {1, 1};
+        unsigned int* OutQ = new (std::nothrow) unsigned int[1] {1};
+        unsigned int* Result = new (std::nothrow) unsigned int [1] {0};
+
+        return Formula(InR, 2, InQ, 2, OutR, 1, OutQ, 1, Result, 0);
+    }
+
+    // [DESC]: Test reachability and chain costs of 'ResourceGraph' on a catalog small enough to solve by hand.
+    // [NOTE]: With Ore and Coal in stock: Iron and Coke cost 1, Steel = 1 + Iron + Coke = 3, Wire = 2 and
+    //         Motor = 1 + Wire + Steel = 6, but its chain applies the shared Iron formula once (5 formulas).
+    //         Ring needs Gold, which nothing makes. Depositing Scrap opens a one-step route to Steel, so
+    //         Motor drops to 4 with the chain {Ore->Iron, Iron->Wire, Scrap->Steel, Motor}.
+    // [THROW]: 'std::runtime_error' if an answer differs from the hand-derived one
+    static inline void TestResourceGraph()
+    {
+        ResourceRegistry& Registry = ResourceRegistry::Instance();
+        ExecutablePlan Catalog;
+        Catalog.AddFormula(MakeLink("GraphOre", 1, "GraphIron", 1));
+        Catalog.AddFormula(MakeLink("GraphCoal", 1, "GraphCoke", 1));
+        Catalog.AddFormula(MakeJoin("GraphIron", "GraphCoke", "GraphSteel"));
+        Catalog.AddFormula(MakeLink("GraphScrap", 1, "GraphSteel", 1));
+        Catalog.AddFormula(MakeLink("GraphSteel", 1, "GraphGear", 1));
+        Catalog.AddFormula(MakeLink("GraphIron", 1, "GraphWire", 1));
+        Catalog.AddFormula(MakeJoin("GraphWire", "GraphSteel", "GraphMotor"));
+        Catalog.AddFormula(MakeLink("GraphGold", 1, "GraphRing", 1));
+
+        ResourceGraph Graph;
+        Graph.AddPlan(Catalog);
+        Stockpile Stock(std::unordered_map<std::string, size_t>{{"GraphOre", 5}, {"GraphCoal", 5}, {"GraphScrap", 0}});
+        const ResourceId Steel = Registry.Intern("GraphSteel");
+        const ResourceId Motor = Registry.Intern("GraphMotor");
+
+        const bool Reachable = Graph.CanProduce(Registry.Intern("GraphGear"), Stock) && Graph.CanProduce(Registry.Intern("GraphOre"), Stock) &&
+                               !Graph.CanProduce(Registry.Intern("GraphRing"), Stock) && !Graph.CanProduce(Registry.Intern("GraphScrap"), Stock);
+        const bool Costed = Graph.GetChainCost(Registry.Intern("GraphOre"), Stock) == 0 && Graph.GetChainCost(Steel, Stock) == 3 &&
+                            Graph.GetChainCost(Motor, Stock) == 6 && Graph.GetChainCost(Registry.Intern("GraphRing"), Stock) == ResourceGraph::Unreachable;
+        const std::vector<size_t> Chain = Graph.GetChain(Motor, Stock);
+        auto Position = [&Chain](size_t Index) -> size_t { return static_cast<size_t>(std::find(Chain.begin(), Chain.end(), Index) - Chain.begin()); };
+        const bool Chained = Chain.size() == 5 && Chain.back() == 6 && Position(0) < Position(2) && Position(1) < Position(2) &&
+                             Position(0) < Position(5) && Position(3) == Chain.size() && Position(4) == Chain.size();
+
+        Stock.Deposit(Registry.Intern("GraphScrap"), 1);
+        std::vector<size_t> Shortcut = Graph.GetChain(Motor, Stock);
+        const bool ShortcutLast = !Shortcut.empty() && Shortcut.back() == 6;
+        std::sort(Shortcut.begin(), Shortcut.end());
+        const bool Lowered = Graph.GetChainCost(Steel, Stock) == 1 && Graph.GetChainCost(Motor, Stock) == 4 &&
+                             ShortcutLast && Shortcut == std::vector<size_t>{0, 3, 5, 6};
+
+        Graph.SetSources(Stock);
+        Stock.Withdraw(Registry.Intern("GraphScrap"), 1);
+        const bool Pinned = Graph.GetChainCost(Motor) == 4 && Graph.CanProduce(Steel);
+        const ResourceId OreOnly[1] = { Registry.Intern("GraphOre") };
+        Graph.SetSources(Span<const ResourceId>(OreOnly, 1));
+        const bool Listed = Graph.GetChainCost(Registry.Intern("GraphWire")) == 2 && Graph.GetChain(Registry.Intern("GraphWire")).size() == 2 &&
+                            !Graph.CanProduce(Motor) && !Graph.CanProduce(Registry.Intern("GraphCoke"));
+
+        TestOperators::PrintTestTag("<[RESOURCE GRAPH]>");
+        std::cout << "\treachable " << std::boolalpha << Reachable << ", costs " << Costed << ", chain of "
+                  << Chain.size() << " " << Chained << ", Scrap lowers Motor to 4 " << Lowered << ", lookups after SetSources "
+                  << (Pinned && Listed) << std::endl;
+
+        if (!Reachable || !Costed || !Chained || !Lowered || !Pinned || !Listed)
+        {
+            throw std::runtime_error("[Driver]TestResourceGraph() [Graph answer differs from the hand-derived one]");
+        }
+    }
+
+    // [DESC]: Test that a replay kept up to date edit by edit always matches replaying the whole trial.
+    // [NOTE]: A seeded sequence of random edits (a step replaced by a link between any two chain
+    //         resources, or an initial quantity set) is applied to one replay. After every edit a new
+    //         replay of the edited plan from the current initial quantities must agree on every
+    //         quantity and on which steps ran.
+    // [THROW]: 'std::runtime_error' if the incremental replay drifts from the full one
+    static inline void TestPlanReplay()
+    {
+        constexpr size_t Chains = 3;
+        constexpr size_t Length = 6;
+        constexpr size_t Edits = 200;
+
+        ExecutablePlan WhatIf = MakeChains("Replay", Chains, Length);
+        WhatIf.SetCounterKey(23, 1);
+        std::unordered_map<std::string, size_t> Current = ChainStock("Replay", Chains, Length, 4);
+        PlanReplay Incremental(WhatIf, Stockpile(Current));
+
+        std::vector<std::string> Names;
+        for (const std::pair<const std::string, size_t>& Item : Current) { Names.push_back(Item.first); }
+        std::sort(Names.begin(), Names.end());
+
+        std::mt19937 Generator(23);
+        auto Pick = [&Generator](size_t Count) -> size_t { return std::uniform_int_distribution<size_t>(0, Count - 1)(Generator); };
+
+        size_t Agreeing = 0;
+        for (size_t Edit = 0; Edit < Edits; Edit++)
+        {
+            if (Pick(2) == 0)
+            {
+                const Formula Replacement = MakeLink(Names[Pick(Names.size())], static_cast<unsigned int>(1 + Pick(3)),
+                                                     Names[Pick(Names.size())], static_cast<unsigned int>(1 + Pick(4)));
+                Incremental.ReplaceFormula(Replacement, Pick(WhatIf.GetSize()));
+            }
+            else
+            {
+                const std::string& Name = Names[Pick(Names.size())];
+                Current[Name] = Pick(11);
+                Incremental.SetInitialQuantity(Name, Current[Name]);
+            }
+
+            PlanReplay Full(WhatIf, Stockpile(Current));
+            bool Same = true;
+            for (const std::string& Name : Names) { Same = Same && Incremental.GetQuantity(Name) == Full.GetQuantity(Name); }
+            for (size_t Step = 0; Step < WhatIf.GetSize(); Step++) { Same = Same && Incremental.StepRan(Step) == Full.StepRan(Step); }
+            if (Same) { Agreeing++; }
+        }
+
+        TestOperators::PrintTestTag("<[REPLAY]>");
+        std::cout << "\t" << Agreeing << " of " << Edits << " random edits match a full replay" << std::endl;
+
+        if (Agreeing != Edits)
+        {
+            throw std::runtime_error("[Driver]TestPlanReplay() [Incremental replay differs from a full replay]");
+        }
+    }
+
+    // [DESC]: Test that a checkpointed run can be loaded back, and resumed after a torn last record.
+    // [NOTE]: The log of a finished run must load to the state the run ended in. The log is then cut
+    //         a few bytes short, as a crash in the middle of a write leaves it; loading must fall back to
+    //         the record before, and resuming from there must end where the uninterrupted run ended.
+    // [THROW]: 'std::runtime_error' if a loaded or resumed run differs
+    static inline void TestCheckpointResume()
+    {
+        constexpr size_t Interval = 7;
+        const std::string Path = (std::filesystem::temp_directory_path() / "DriverCheckpoint.ckp").string();
+        const std::unordered_map<std::string, size_t> Initial = ChainStock("Ckpt", 4, 15, 8);
+
+        ExecutablePlan Checkpointed = MakeChains("Ckpt", 4, 15);
+        Checkpointed.SetSeed(24);
+
+        std::shared_ptr<Stockpile> Expected = std::make_shared<Stockpile>(Initial);
+        {
+            PlanCheckpoint Log(Path);
+            Checkpointed.PlanApply(Expected, Log, Interval);
+        }
+
+        PlanCheckpoint::Restored Whole = PlanCheckpoint::Load(Path);
+        const bool Loaded = Contents(*Whole.Resources) == Contents(*Expected) && Whole.Plan.GetStep() == Checkpointed.GetStep();
+
+        std::vector<char> Bytes;
+        {
+            std::ifstream File(Path, std::ios::binary);
+            Bytes.assign(std::istreambuf_iterator<char>(File), std::istreambuf_iterator<char>());
+        }
+        {
+            std::ofstream File(Path, std::ios::binary | std::ios::trunc);
+            File.write(Bytes.data(), static_cast<std::streamsize>(Bytes.size() - 3));
+        }
+
+        PlanCheckpoint::Restored Torn = PlanCheckpoint::Load(Path);
+        const size_t TornRecords = Torn.Records;
+        {
+            PlanCheckpoint Log(Path);
+            Torn.Plan.PlanApply(Torn.Resources, Log, Interval);
+        }
+        const bool Resumed = TornRecords < Whole.Records && Contents(*Torn.Resources) == Contents(*Expected) &&
+                              Torn.Plan.GetStep() == Checkpointed.GetStep();
+        std::filesystem::remove(Path);
+
+        TestOperators::PrintTestTag("<[CHECKPOINT]>");
+        std::cout << "\t" << Whole.Records << " records, loaded " << std::boolalpha << Loaded << ", torn tail resumed from "
+                  << TornRecords << " records: " << Resumed << std::endl;
+
+        if (!Loaded || !Resumed)
+        {
+            throw std::runtime_error("[Driver]TestCheckpointResume() [Restored run differs from the original]");
+        }
+    }
+
+    // [DESC]: Test that an archive gives back the plan and stockpile it was written from, and that a cut
+    //         or damaged file is refused when opened.
+    // [NOTE]: The plan is applied first so the levels and results it stores are not all zero.
+    // [THROW]: 'std::runtime_error' if the round trip differs or a bad file was accepted
+    static inline void TestPlanArchive()
+    {
+        const std::string Path = (std::filesystem::temp_directory_path() / "DriverArchive.rca").string();
+
+        ExecutablePlan Original = MakeChains("Arch", 3, 4);
+        Original.SetSeed(25);
+        std::shared_ptr<Stockpile> Resources = Original.PlanApply(std::make_shared<Stockpile>(ChainStock("Arch", 3, 4, 8), Stockpile::StorageMode::Dense));
+        PlanArchive::Write(Path, Original, *Resources);
+
+        bool RoundTrip = false;
+        {
+            PlanArchive Archive(Path);
+            ExecutablePlan Restored;
+            Archive.AppendTo(Restored);
+            std::shared_ptr<Stockpile> RestoredResources = Archive.ToStockpile();
+
+            RoundTrip = Restored.GetSize() == Original.GetSize() && RestoredResources -> GetStorageMode() == Stockpile::StorageMode::Dense &&
+                        Contents(*RestoredResources) == Contents(*Resources);
+            for (size_t i = 0; i < Original.GetSize() && RoundTrip; i++)
+            {
+                const Formula& Expected = Original.GetFormula(i);
+                const Formula& Actual = Restored.GetFormula(i);
+                RoundTrip = Expected == Actual && Expected.GetProficiencyLevel() == Actual.GetProficiencyLevel() &&
+                            Expected.GetResultArray()[0] == Actual.GetResultArray()[0];
+            }
+        }
+
+        const std::string ModePath = (std::filesystem::temp_directory_path() / "DriverArchiveModes.rca").string();
+        auto KeepsMode = [&ModePath](const Stockpile& Saved) -> bool {
+            PlanArchive::Write(ModePath, Plan(), Saved);
+            PlanArchive Archive(ModePath);
+            std::shared_ptr<Stockpile> Loaded = Archive.ToStockpile();
+            return Loaded -> GetStorageMode() == Saved.GetStorageMode() && Contents(*Loaded) == Contents(Saved);
+        };
+        Stockpile EmptySharded;
+        EmptySharded.CopyFrom(Stockpile(), Stockpile::StorageMode::Sharded);
+        const bool ModesKept = KeepsMode(EmptySharded) &&
+                               KeepsMode(Stockpile(ChainStock("Arch", 3, 4, 8), Stockpile::StorageMode::Versioned));
+        std::filesystem::remove(ModePath);
+
+        std::vector<char> Bytes;
+        {
+            std::ifstream File(Path, std::ios::binary);
+            Bytes.assign(std::istreambuf_iterator<char>(File), std::istreambuf_iterator<char>());
+        }
+        auto Refused = [&Path](const std::vector<char>& Damaged, size_t Length) -> bool {
+            {
+                std::ofstream File(Path, std::ios::binary | std::ios::trunc);
+                File.write(Damaged.data(), static_cast<std::streamsize>(Length));
+            }
+            try { PlanArchive Archive(Path); } catch (std::runtime_error&) { return true; }
+            return false;
+        };
+
+        std::vector<char> BadMagic(Bytes);
+        BadMagic[0] = 'X';
+        const bool RefusedTruncated = Refused(Bytes, Bytes.size() / 2) && Refused(Bytes, 16);
+        const bool RefusedHeader = Refused(BadMagic, BadMagic.size());
+        std::filesystem::remove(Path);
+
+        TestOperators::PrintTestTag("<[ARCHIVE]>");
+        std::cout << "\t" << Bytes.size() << " bytes, round trip " << std::boolalpha << RoundTrip << ", modes kept " << ModesKept
+                  << ", truncated refused " << RefusedTruncated << ", bad header refused " << RefusedHeader << std::endl;
+
+        if (!RoundTrip || !ModesKept || !RefusedTruncated || !RefusedHeader)
+        {
+            throw std::runtime_error("[Driver]TestPlanArchive() [Archive round trip or validation failed]");
+        }
+    }
+
 //[DESC]: Entry point of the program.
 //    - This function serves as the starting point of the program and controls the program's
 //      execution flow.
 //[NOTE]: Exceptions 'e' is re-throw to propagate it
 inline void InitAndRun()
 {
-    try{ Example::Instance().Run(); } catch (std::exception& Error)
+    try{
+        Example::Instance().Run();
+        TestPhilox();
+        TestFormulaBook();
+        TestPlanCopyFailure();
+        TestMonteCarlo();
+        TestConcurrentStockpile();
+        TestTryConsume();
+        TestShardedStockpile();
+        TestStockpileIteration();
+        TestVersionedStockpile();
+        TestCompiledPlan();
+        TestApplyAllocations();
+        TestParallelApply();
+        TestPlanExecutor();
+        TestWaitPipeline();
+        TestThroughputPlanner();
+        TestResourceGraph();
+        TestPlanReplay();
+        TestCheckpointResume();
+        TestPlanArchive();
+    } catch (std::exception& Error)
     {
         std::cout << "{Error}: " << Error.what () << std::endl;
         throw Error;
@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <new>
 
+#include <atomic>
 #include <memory>
 #include <iostream>
 
@@ -28,42 +29,115 @@
 
 namespace ResourceConversion
 {
+//[DESC]: Allocate uninitialized storage for 'Count' Formulas.
+//
+//[PARAM]: Count The number of slots.
+//
+//[PRE]: None.
+//
+//[POST]: None, no Formula is constructed.
+//
+//[RETURN]: Raw storage for 'Count' Formulas, nullptr if 'Count' is 0.
+inline Formula* Plan::AllocateFormulas (size_t Count)
+{
+  if (Count == 0) { return nullptr; }
+  return static_cast<Formula*>(::operator new (sizeof (Formula) * Count));
+}
+
+//[DESC]: Destroy the first 'Count' Formulas of 'Formulas' and release the storage.
+//
+//[PARAM]: Formulas Storage returned by 'AllocateFormulas(...)', or nullptr.
+//[PARAM]: Count The number of constructed Formulas at the front of the storage.
+//
+//[PRE]: Exactly the slots [0, Count) hold live Formulas.
+//
+//[POST]: The Formulas are destroyed and the storage is released.
+inline void Plan::ReleaseFormulas (Formula* Formulas, size_t Count)
+{
+  if (Formulas == nullptr) { return; }
+  std::destroy_n (Formulas, Count);
+  ::operator delete (Formulas);
+}
+
+//[DESC]: Copy 'Count' Formulas into new storage for 'NewCapacity' Formulas.
+//
+//[PARAM]: Formulas The Formulas to copy.
+//[PARAM]: Count The number of Formulas to copy.
+//[PARAM]: NewCapacity The number of slots of the new storage, at least 'Count'.
+//
+//[PRE]: 'Formulas' holds at least 'Count' live Formulas.
+//
+//[POST]: The slots [0, Count) of the new storage hold copies, the rest is raw storage.
+//
+//[RETURN]: The new storage, nullptr if 'NewCapacity' is 0.
+//
+//[THROW]: Whatever copying a Formula throws. The copies made so far are destroyed and the storage
+//         is released, so nothing leaks and the caller is left as it was.
+inline Formula* Plan::CopyFormulas (const Formula* Formulas, size_t Count, size_t NewCapacity)
+{
+  Formula* NewFormulaArray = AllocateFormulas (NewCapacity);
+  try
+  {
+    std::uninitialized_copy_n (Formulas, Count, NewFormulaArray);
+  }
+  catch (...)
+  {
+    ReleaseFormulas (NewFormulaArray, 0);
+    throw;
+  }
+  return NewFormulaArray;
+}
+
 //[DESC]: Resize the Plan to accommodate a new capacity.
 //
 //[PARAM]: NewCapacity The new capacity for the Plan.
 //
-//[PRE]: NewCapacity should be greater than or equal to the current Size.
+//[PRE]: None.
 //
 //[POST]: The Plan's capacity will be updated to NewCapacity.
-//        The Plan's Size remains unchanged, and the existing data is preserved.
-//        FormulaArray points to a new array of size NewCapacity containing the same data.
+//        The Formulas are move-constructed into the new storage, nothing is deep copied. If
+//        NewCapacity is below the current Size, the Formulas past it are dropped and Size shrinks
+//        to NewCapacity; otherwise Size remains unchanged.
+//
+//[NOTE]: Slots in [Size, Capacity) are raw storage, no Formula is constructed there.
 inline void Plan::ResizePlan (size_t NewCapacity)
 {
-  Formula* NewFormulaArray = new (std::nothrow) Formula[NewCapacity];
-  for (size_t i = 0; i < Size; ++i)
+  const size_t Kept = std::min (Size, NewCapacity);
+  Formula* NewFormulaArray = AllocateFormulas (NewCapacity);
+  if (Kept != 0)
   {
-    NewFormulaArray[i] = FormulaArray[i];
+    std::uninitialized_move_n (FormulaArray, Kept, NewFormulaArray);
   }
-  delete[] FormulaArray;
+  ReleaseFormulas (FormulaArray, Size);
+
   FormulaArray = NewFormulaArray;
-  Size = Capacity;
+  Size = Kept;
   Capacity = NewCapacity;
+  InvalidateBook ();
+}
+
+//[DESC]: The capacity to grow to once the Plan is full.
+//
+//[RETURN]: Twice the current capacity, at least 2.
+inline size_t Plan::GrowthCapacity () const
+{
+  constexpr size_t MinimumCapacity = 2;
+  return std::max (MinimumCapacity, Capacity * 2);
 }
 
 //[DESC]: Clears the Plan by releasing allocated resources and resetting its size and capacity to 0.
 //
 //[PRE]: None.
 //
-//[POST]: All allocated memory for FormulaArray is freed, and FormulaArray is set to nullptr.
-//        The Size and Capacity of the Plan are both set to 0.
+//[POST]: All Formulas are destroyed, the storage for FormulaArray is freed, and FormulaArray is set
+//        to nullptr. The Size and Capacity of the Plan are both set to 0.
 inline void Plan::ClearPlan ()
 {
-  if (FormulaArray != nullptr)
-  {
-    delete[] FormulaArray;
-  }
+  ReleaseFormulas (FormulaArray, Size);
   FormulaArray = nullptr;
   Size = Capacity = 0;
+  Book.Clear ();
+  InvalidateBook ();
 }
 
 //[DESC]: Copies data from another Plan into this Plan.
@@ -74,15 +148,20 @@ inline void Plan::ClearPlan ()
 //
 //[POST]: This Plan will contain a deep copy of the data from the 'other' Plan,
 //       including the same Size and Capacity.
+//
+//[THROW]: Whatever copying a Formula throws, before this Plan was changed {[SEE]: CopyFormulas(...)}
 inline void Plan::CopyPlanData (const Plan& other)
 {
+  Formula* NewFormulaArray = CopyFormulas (other.FormulaArray, other.Size, other.Capacity);
+
+  FormulaArray = NewFormulaArray;
   Size = other.Size;
   Capacity = other.Capacity;
-  FormulaArray = new (std::nothrow) Formula[Capacity];
-  for (size_t i = 0; i < Size; ++i)
-  {
-    FormulaArray[i] = other.FormulaArray[i];
-  }
+  Seed = other.Seed;
+  ApplyRound = other.ApplyRound;
+  PlanId = other.PlanId;
+  Mode = other.Mode;
+  InvalidateBook ();
 }
 
 //[DESC]: Resets this Plan by transferring ownership of data from another Plan.
@@ -98,22 +177,36 @@ inline void Plan::ResetPlan ()
     Capacity = 0;
     Size = 0;
     FormulaArray = nullptr;
+    Seed = 0;
+    ApplyRound = 0;
+    PlanId = 0;
+    Mode = RandomMode::ThreadLocal;
+    Book.Clear ();
+    InvalidateBook ();
 }
 
-//[DESC]: Reassigns data from another Plan object by swapping data members.
+//[DESC]: Reassigns data from another Plan object by taking over its data members.
 //
 //[PARAM LIST]:
 //      other - The Plan object from which data will be reassigned.
 //
 //[PRE]: The 'other' Plan object should be properly initialized.
 //
-//[POST]: The data, including FormulaArray, Size, and Capacity, is swapped between 'this' Plan object
-//        and 'other'.
-inline void Plan::ReassignData(Plan&& other) const
+//[POST]: The data, including FormulaArray, Size, Capacity and the seed, is owned by 'this' Plan
+//        object. 'other' becomes an empty Plan with no data.
+inline void Plan::ReassignData(Plan&& other)
 {
-  other.FormulaArray = FormulaArray;
-  other.Size = Size;
-  other.Capacity = Capacity;
+  FormulaArray = other.FormulaArray;
+  Size = other.Size;
+  Capacity = other.Capacity;
+  Seed = other.Seed;
+  ApplyRound = other.ApplyRound;
+  PlanId = other.PlanId;
+  Mode = other.Mode;
+  Book = std::move (other.Book);
+  BookIsStale = other.BookIsStale;
+  Revision = other.Revision;
+  other.ResetPlan ();
 }
 
 //[DESC]: Swaps data with another Plan object.
@@ -128,8 +221,15 @@ inline void Plan::ReassignData(Plan&& other) const
 inline void Plan::SwapData(Plan&& other)
 {
   std::swap(other.FormulaArray, FormulaArray);
-  std::swap(other.Size, other.Size);
+  std::swap(other.Size, Size);
   std::swap(other.Capacity, Capacity);
+  std::swap(other.Seed, Seed);
+  std::swap(other.ApplyRound, ApplyRound);
+  std::swap(other.PlanId, PlanId);
+  std::swap(other.Mode, Mode);
+  std::swap(other.Book, Book);
+  std::swap(other.BookIsStale, BookIsStale);
+  std::swap(other.Revision, Revision);
 }
 
 //[DESC]: Constructs an empty Plan with an initial Capacity of 2.
@@ -137,12 +237,12 @@ inline void Plan::SwapData(Plan&& other)
 //[PRE]: None.
 //
 //[POST]: An empty Plan object is created with Capacity set to 2.
-//       The Size is initialized to 0, and an array of Capacity elements is allocated.
+//       The Size is initialized to 0, and storage for Capacity elements is allocated.
 Plan::Plan ()
 {
   Capacity = 2;
   Size = 0;
-  FormulaArray = new (std::nothrow) Formula[Capacity];
+  FormulaArray = AllocateFormulas (Capacity);
 }
 
 //[DESC]: Constructs a Plan object with an initial sequence of Formulas and a specified initial size.
@@ -155,19 +255,18 @@ Plan::Plan ()
 //
 //[POST]: A Plan object is constructed with Capacity set to InitialSize.
 //        The Size is initialized to InitialSize, and the data is copied from InitialSequence.
+//
+//[THROW]: std::invalid_argument if InitialSize is 0.
+//[THROW]: Whatever copying a Formula throws, nothing is leaked {[SEE]: CopyFormulas(...)}
 Plan::Plan (Formula* InitialSequence, size_t InitialSize)
 {
   if(InitialSize <= 0)
   {
     throw std::invalid_argument("[P]Plan(...): [Size cannot be non-positive]");
   }
-  Capacity = InitialSize;
+  FormulaArray = CopyFormulas (InitialSequence, InitialSize, InitialSize);
   Size = InitialSize;
-  FormulaArray = new (std::nothrow) Formula[Capacity];
-  for (size_t i = 0; i < Size; ++i)
-  {
-    FormulaArray[i] = InitialSequence[i];
-  }
+  Capacity = InitialSize;
 }
 
 //[DESC]: Destructor for the Plan class.
@@ -227,7 +326,6 @@ Plan::Plan (const Plan& other)
 Plan::Plan (Plan&& other) noexcept
 {
   ReassignData(std::move(other));
-  ResetPlan ();
 }
 
 //[DESC]: Move assignment operator for the Plan class.
@@ -256,26 +354,77 @@ Plan::Plan (Plan&& other) noexcept
 //
 //[PRE]: None.
 //
-//[POST]: If adding the Formula exceeds the Capacity, the Plan is resized to accommodate it.
-//        The new Formula is added to the end of the Plan, and the Size is updated accordingly.
+//[POST]: If adding the Formula exceeds the Capacity, the Plan grows geometrically to accommodate
+//        it. A copy of the new Formula is added to the end of the Plan, and the Size is updated
+//        accordingly.
+//
+//[NOTE]: 'NewFormula' may refer to a Formula of this Plan, it is copied before the storage moves.
 void Plan::AddFormula (const Formula &NewFormula) {
   if (Size >= Capacity) {
-    ResizePlan (Capacity * 2);
+    Formula Copy (NewFormula);
+    ResizePlan (GrowthCapacity ());
+    ::new (static_cast<void*>(FormulaArray + Size)) Formula (std::move (Copy));
+  } else {
+    ::new (static_cast<void*>(FormulaArray + Size)) Formula (NewFormula);
   }
-  FormulaArray[Size++] = NewFormula;
+  ++Size;
+  InvalidateBook ();
+}
+
+//[DESC]: Add a new Formula to the Plan, taking over its data.
+//
+//[PARAM]: NewFormula The Formula to be moved into the Plan.
+//
+//[PRE]: None.
+//
+//[POST]: Same as 'AddFormula(const Formula&)', 'NewFormula' is left empty.
+void Plan::AddFormula (Formula &&NewFormula) {
+  if (Size >= Capacity) {
+    Formula Moved (std::move (NewFormula));
+    ResizePlan (GrowthCapacity ());
+    ::new (static_cast<void*>(FormulaArray + Size)) Formula (std::move (Moved));
+  } else {
+    ::new (static_cast<void*>(FormulaArray + Size)) Formula (std::move (NewFormula));
+  }
+  ++Size;
+  InvalidateBook ();
+}
+
+//[DESC]: Make room for at least 'NewCapacity' Formulas.
+//
+//[PARAM]: NewCapacity The number of Formulas the Plan should hold without growing.
+//
+//[PRE]: None.
+//
+//[POST]: Capacity is at least NewCapacity. The Size and the Formulas are unchanged.
+void Plan::Reserve (size_t NewCapacity)
+{
+  if (NewCapacity > Capacity) { ResizePlan (NewCapacity); }
+}
+
+//[DESC]: Release the storage the Plan does not use.
+//
+//[PRE]: None.
+//
+//[POST]: Capacity equals Size. The Formulas are unchanged.
+void Plan::ShrinkToFit ()
+{
+  if (Capacity > Size) { ResizePlan (Size); }
 }
 
 //[DESC]: Remove the last Formula from the Plan.
 //
 //[PRE]: The Size of the Plan should be greater than 0.
 //
-//[POST]: The last Formula is removed from the Plan, and the Size is decremented.
+//[POST]: The last Formula is destroyed, and the Size is decremented.
 //
 //[THROW]: std::invalid_argument if the Size is less than or equal to 0.
 void Plan::RemoveLastFormula ()
 {
   if (Size <= 0) { throw std::invalid_argument ("[P]RemoveLastFomrula(): [Plan size is less than or equal to 0]"); }
+  std::destroy_at (FormulaArray + Size - 1);
   --Size;
+  InvalidateBook ();
 }
 
 //[DESC]: Replace the Formula at the specified index with a new Formula.
@@ -290,8 +439,9 @@ void Plan::RemoveLastFormula ()
 //[THROW]: std::out_of_range if Index is out of range.
 void Plan::ReplaceFormula (const Formula& NewFormula, const size_t &Index)
 {
-  if (Index > Size) { throw std::out_of_range ("[P]ReplaceFomrula(...): [Index is Out of Bounds"); }
+  if (Index >= Size) { throw std::out_of_range ("[P]ReplaceFomrula(...): [Index is Out of Bounds"); }
   FormulaArray[Index] = NewFormula;
+  InvalidateBook ();
 }
 
 //[DESC]: Apply all Formulas in the Plan.
@@ -307,8 +457,253 @@ void Plan::PlanApply ()
 
   for (size_t i = 0; i < Size; ++i)
   {
-    FormulaArray[i].Apply ();
+    ApplyFormulaAt (i);
+  }
+  FinishApplyRound ();
+}
+
+//[DESC]: Apply a single Formula of the Plan with the engine that belongs to its step.
+//
+//[PARAM]: Index The index of the Formula to apply.
+//
+//[PRE]: Index should be within the valid range [0, Size - 1].
+//
+//[POST]: The Formula at Index is applied. A seeded Plan draws from the stream (Seed, ApplyRound,
+//        Index), a counter-based Plan treats the round as the trial index {[SEE]: 'ApplyAt(...)'},
+//        otherwise the draw comes from the calling thread's engine.
+//
+//[NOTE]: The engine is rebuilt for every step, so the result of a step does not depend on how many
+//        draws the other steps made.
+void Plan::ApplyFormulaAt (size_t Index)
+{
+  switch (Mode)
+  {
+    case RandomMode::Seeded:
+    {
+      Xoshiro256StarStar Generator = Xoshiro256StarStar::ForStream (SplitMix64::Mix (Seed, ApplyRound), Index);
+      FormulaArray[Index].Apply (Generator);
+      break;
+    }
+    case RandomMode::CounterBased:
+    {
+      Philox4x32 Generator = CounterEngine (Index, static_cast<std::uint32_t>(ApplyRound));
+      FormulaArray[Index].Apply (Generator);
+      break;
+    }
+    case RandomMode::ThreadLocal:
+    default:
+      FormulaArray[Index].Apply ();
+      break;
+  }
+}
+
+//[DESC]: Marks the end of one pass over the Plan.
+//
+//[PRE]: None.
+//
+//[POST]: A seeded or counter-based Plan moves on to the next round, so repeated passes draw fresh
+//        values.
+//
+//[NOTE]: Called by every 'PlanApply' overload. A scheduler that applies the steps one by one calls it
+//        after the last step {[SEE]: ExecutablePlan::ApplyStepTo(...)}.
+void Plan::FinishApplyRound ()
+{
+  if (Mode != RandomMode::ThreadLocal) { ++ApplyRound; }
+}
+
+//[DESC]: Build the counter-based engine of one step and trial.
+//
+//[PARAM]: Index The step index.
+//[PARAM]: Trial The trial index.
+//
+//[RETURN]: The 'Philox4x32' stream keyed by (Seed, PlanId, Index, Trial).
+inline Philox4x32 Plan::CounterEngine (size_t Index, std::uint32_t Trial) const
+{
+  return Philox4x32 (Seed, PlanId, static_cast<std::uint32_t>(Index), Trial);
+}
+
+//[DESC]: Make every following application of the Plan reproducible.
+//
+//[PARAM]: Seed_ The root seed of the simulation.
+//
+//[PRE]: None.
+//
+//[POST]: The Plan is seeded and its round counter starts over, so two Plans with the same Formulas
+//        and the same seed produce identical results.
+void Plan::SetSeed (std::uint64_t Seed_)
+{
+  Seed = Seed_;
+  ApplyRound = 0;
+  PlanId = 0;
+  Mode = RandomMode::Seeded;
+}
+
+//[DESC]: Switch the Plan to the counter-based generator.
+//
+//[PARAM]: Seed_ The root seed of the simulation.
+//[PARAM]: PlanId_ Distinguishes Plans that share a seed.
+//
+//[PRE]: None.
+//
+//[POST]: Every draw of the Plan is a pure function of (Seed_, PlanId_, step, trial). 'PlanApply()'
+//        uses its round counter, which starts over, as the trial index.
+void Plan::SetCounterKey (std::uint64_t Seed_, std::uint32_t PlanId_)
+{
+  Seed = Seed_;
+  ApplyRound = 0;
+  PlanId = PlanId_;
+  Mode = RandomMode::CounterBased;
+}
+
+//[DESC]: Go back to drawing from the calling thread's engine.
+//
+//[PRE]: None.
+//
+//[POST]: The Plan is no longer seeded.
+void Plan::ClearSeed ()
+{
+  Seed = 0;
+  ApplyRound = 0;
+  PlanId = 0;
+  Mode = RandomMode::ThreadLocal;
+}
+
+//[DESC]: Check whether the Plan draws from a reproducible stream.
+//
+//[RETURN]: True if 'SetSeed(...)' or 'SetCounterKey(...)' was called and not cleared since.
+bool Plan::HasSeed () const
+{
+  return Mode != RandomMode::ThreadLocal;
+}
+
+//[DESC]: Capture where the draws of the Plan stand.
+//
+//[PRE]: None.
+//
+//[RETURN]: The seed, plan id, round counter and mode. Restoring it makes the following applications
+//          draw exactly what they would have drawn now (not for 'ThreadLocal', which has no state).
+Plan::RandomState Plan::GetRandomState () const
+{
+  RandomState State;
+  State.Seed = Seed;
+  State.ApplyRound = ApplyRound;
+  State.PlanId = PlanId;
+  State.Mode = Mode;
+  return State;
+}
+
+//[DESC]: Continue drawing from a captured state {[SEE]: 'GetRandomState()'}.
+//
+//[PARAM]: State The captured state.
+//
+//[PRE]: None.
+//
+//[POST]: The Plan draws as the Plan that 'State' was captured from did at that point.
+void Plan::RestoreRandomState (const RandomState& State)
+{
+  Seed = State.Seed;
+  ApplyRound = State.ApplyRound;
+  PlanId = State.PlanId;
+  Mode = State.Mode;
+}
+
+//[DESC]: Apply one step of the Plan for a given trial.
+//
+//[PARAM]: Index The index of the Formula to apply.
+//[PARAM]: Trial The trial index.
+//
+//[PRE]: The Plan is counter-based {[SEE]: 'SetCounterKey(...)'}.
+//
+//[POST]: The Formula at Index is applied with the stream (Seed, PlanId, Index, Trial). The draw does
+//        not depend on which thread calls, or on which other steps and trials ran before.
+//
+//[THROW]: std::out_of_range if Index is out of range.
+//         std::logic_error if the Plan is not counter-based.
+void Plan::ApplyAt (size_t Index, std::uint32_t Trial)
+{
+  if (Index >= Size) { throw std::out_of_range ("[P]ApplyAt(...): [Index is Out of Bounds]"); }
+  if (Mode != RandomMode::CounterBased) { throw std::logic_error ("[P]ApplyAt(...): [Plan is not counter-based]"); }
+
+  Philox4x32 Generator = CounterEngine (Index, Trial);
+  FormulaArray[Index].Apply (Generator);
+}
+
+//[DESC]: Compute one step of the Plan for a given trial without modifying it.
+//
+//[PARAM]: Index The index of the Formula to evaluate.
+//[PARAM]: Trial The trial index.
+//[PARAM]: Destination Receives the produced quantities of the Formula at Index.
+//
+//[PRE]: The Plan is counter-based {[SEE]: 'SetCounterKey(...)'}.
+//       Destination holds at least 'GetOutputResourcesSize()' values.
+//
+//[POST]: Destination holds the quantities the step produces in this trial. The Plan is unchanged,
+//        so any number of threads may evaluate it at the same time.
+//
+//[THROW]: std::out_of_range if Index is out of range.
+//         std::logic_error if the Plan is not counter-based.
+//
+//[RETURN]: The outcome of the step.
+Formula::Outcome Plan::EvaluateAt (size_t Index, std::uint32_t Trial, unsigned int* Destination) const
+{
+  if (Index >= Size) { throw std::out_of_range ("[P]EvaluateAt(...): [Index is Out of Bounds]"); }
+  if (Mode != RandomMode::CounterBased) { throw std::logic_error ("[P]EvaluateAt(...): [Plan is not counter-based]"); }
+
+  Philox4x32 Generator = CounterEngine (Index, Trial);
+  return FormulaArray[Index].Evaluate (Generator, Destination);
+}
+
+//[DESC]: Draw a revision stamp that no Plan has used before.
+//
+//[PRE]: None.
+//
+//[POST]: The process-wide counter moved on, safe to call from any thread.
+//
+//[RETURN]: The new stamp, never 0.
+std::uint64_t Plan::NewRevision ()
+{
+  static std::atomic<std::uint64_t> NextRevision{1};
+  return NextRevision.fetch_add (1, std::memory_order_relaxed);
+}
+
+//[DESC]: Get the packed, structure-of-arrays copy of the Plan's recipes.
+//
+//[PRE]: None.
+//
+//[POST]: If any Formula changed since the last call, the book is rebuilt from 'FormulaArray'.
+//
+//[RETURN]: The book, row i describes 'FormulaArray[i]'. The reference stays valid until the Plan is
+//          modified.
+//
+//[NOTE]: Rebuilding writes the 'mutable' cache, concurrent callers must not share a stale Plan.
+//        A recipe changed through a reference kept from the non-const 'operator[]' is caught too:
+//        the book pins every recipe, so the change detaches the Formula from the pinned one.
+const FormulaBook& Plan::GetFormulaBook () const
+{
+  if (BookIsStale || !Book.Describes (FormulaArray, Size))
+  {
+    Book.Build (FormulaArray, Size);
+    BookIsStale = false;
   }
+  return Book;
+}
+
+//[DESC]: Read-only access to one Formula of the Plan.
+//
+//[PARAM]: Index The index of the Formula.
+//
+//[PRE]: None.
+//
+//[POST]: None. Unlike 'operator[]' the packed book is not invalidated, so any number of threads may
+//        read the Plan at the same time.
+//
+//[THROW]: std::out_of_range if Index is out of range.
+//
+//[RETURN]: The Formula at Index.
+const Formula& Plan::GetFormula (size_t Index) const
+{
+  if (Index >= Size) { throw std::out_of_range ("[P]GetFormula(...): [Index out of range]"); }
+  return FormulaArray[Index];
 }
 
 //[DESC]: Displays the values of formulas in the Plan, including the input and output resources and
@@ -361,49 +756,59 @@ inline bool Plan::PlanArraysAreEqual(const Plan& other) const
 }
 
 // [DESC]: This function pushes default values into an array of Formula objects.
-// [PRE]: The array FormulaArray has been initialized and has a size of at least 'Size'.
-// [POST]: Default values have been added to the FormulaArray starting from index 'OldSize' 
-//         up to 'Size - 1'.
-// [NOTE]: This is used to fill uninitialized or newly extended parts of the array with 
-//         default values.
-inline void Plan::PushDefaultValueInArray(size_t OldSize) 
-{
-  Formula DefaultObject = Formula();
-  for(size_t i = OldSize; i < Size; i++)
+// [PRE]: Capacity is at least 'NewSize'.
+// [POST]: Default Formulas have been constructed in the FormulaArray starting from index 'Size' 
+//         up to 'NewSize - 1', and Size is 'NewSize'.
+// [NOTE]: This is used to fill newly extended parts of the array with default values.
+inline void Plan::PushDefaultValueInArray(size_t NewSize) 
+{
+  for(; Size < NewSize; Size++)
   {
-    FormulaArray[i] = DefaultObject;
+    ::new (static_cast<void*>(FormulaArray + Size)) Formula ();
   }
+  InvalidateBook ();
 }
 //[DESC]: Concatenates the FormulaArray of the current Plan object with the FormulaArray of 
 //        another Plan object.
 //[PRE]:  Both the current Plan object and the 'other' Plan object must be properly initialized.
-//        The current Plan object's FormulaArray must have enough capacity to accommodate 
-//        the concatenation.
-//[POST]: The FormulaArray of the current Plan object is extended with the contents of the 
-//        'other' Plan object's FormulaArray.
+//[POST]: The FormulaArray of the current Plan object is extended with copies of the 
+//        'other' Plan object's Formulas, growing the storage if needed.
 //[PARAM]: other - A reference to another Plan object whose FormulaArray you want to concatenate 
 //         with the current Plan object's FormulaArray.
 inline void Plan::ConcatinateArrays(const Plan& other)
 {
-  size_t OldSize = Size;
-  size_t SizeOfNewArray = Size + other.Size;
-  ResizePlan(SizeOfNewArray);
+  const size_t OtherSize = other.Size;
+  Reserve(Size + OtherSize);
 
-  for(size_t i = OldSize - 1; i < Size - 1; i++)
-  {
-    FormulaArray[i] = other.FormulaArray[i];
-  }
+  std::uninitialized_copy_n(other.FormulaArray, OtherSize, FormulaArray + Size);
+  Size += OtherSize;
+  InvalidateBook ();
+}
+
+//[DESC]: Read-only access to the Formula at the specified index.
+//[PARAM]: Index The index of the Formula to access.
+//[PRE]: Index should be within the valid range [0, Size - 1].
+//[POST]: Returns a const reference of the 'Formula' at 'Index'. The packed book and the revision
+//        are left alone, so compiled programs stay valid and readers may share the Plan.
+//
+//[THROW]: std::out_of_range if Index is out of range.
+const Formula& Plan::operator[](size_t Index) const
+{
+  if (Index >= Size) { throw std::out_of_range ("[P]operator[](...): [Index out of range]"); }
+  return FormulaArray[Index];
 }
 
 //[DESC]: Access the Formula at the specified index.
 //[PARAM]: Index The index of the Formula to access.
 //[PRE]: Index should be within the valid range [0, Size - 1].
-//[POST]: Returns a reference of the 'Formula' at 'Index'
+//[POST]: Returns a reference of the 'Formula' at 'Index'. The book is marked stale and the revision
+//        replaced, since the caller may change the Formula through it.
 //
 //[THROW]: std::out_of_range if Index is out of range.
-Formula& Plan::operator[](size_t Index) const
+Formula& Plan::operator[](size_t Index)
 {
   if (Index >= Size) { throw std::out_of_range ("[P]operator[](...): [Index out of range]"); }
+  InvalidateBook ();
   return FormulaArray[Index];
 }
 
@@ -538,9 +943,8 @@ Plan Plan::operator+(size_t NewSize)
 {
   
   if(NewSize < Size) {throw std::invalid_argument("[P]operator+(...) [Invalid NewSize]");}  
-  size_t OldSize = this -> Size;
-  ResizePlan(NewSize);
-  PushDefaultValueInArray(OldSize);
+  Reserve(NewSize);
+  PushDefaultValueInArray(NewSize);
 
   return *this;
 }
@@ -584,6 +988,7 @@ Plan Plan::operator++(int DummyParameter)
   {
     FormulaArray[i].operator++(DummyParameter);
   }
+  InvalidateBook ();
   return OldState;
 }
 
@@ -603,6 +1008,7 @@ Plan Plan::operator--(int DummyParameter)
   {
     FormulaArray[i].operator--(DummyParameter);
   }
+  InvalidateBook ();
   return OldState;
 }
 
@@ -617,7 +1023,8 @@ Plan& Plan::operator++()
   for(size_t i = 0; i < Size; i++)
   {
     FormulaArray[i].operator++();
-  }    
+  }
+  InvalidateBook ();    
   return *this;
 }
 
@@ -632,7 +1039,8 @@ Plan& Plan::operator--()
   for(size_t i = 0; i < Size; i++)
   {
     FormulaArray[i].operator--();
-  }    
+  }
+  InvalidateBook ();    
   return *this;
 }
 
@@ -650,6 +1058,7 @@ Plan& Plan::operator+=(unsigned int IncrementValue)
   {
     FormulaArray[i].operator+=(IncrementValue);
   }
+  InvalidateBook ();
   return *this;
 }
 
@@ -667,6 +1076,7 @@ Plan& Plan::operator-=(unsigned int DecrementValue)
   {
     FormulaArray[i].operator-=(DecrementValue);
   }
+  InvalidateBook ();
   return *this;
 }
 
@@ -15,11 +15,19 @@
 //           - 1.0 [27/10/2023]: Optimisation and Impored Move Semantics
 //           - 2.0 [28/10/2023]: Debugging
 //           - 3.0 [28/10/2023]: Documentation
+//           - 4.0 [16/10/2026]: Random state can be saved and restored {[SEE]: PlanCheckpoint.h}
 //
 //[INVARIANT]: Capacity is the capacity for FormulaArray and should be greater than or equal to 2.
 //[INVARIANT]: Size of Plan and should be greater than or equal to 1.
 //[INVARIANT]: FormulaArray is a dynamic array to store Formula objects.
-//[INVARAINT]: FormulaArray cannot be nullptr
+//[INVARAINT]: FormulaArray cannot be nullptr unless Capacity is 0
+//[INVARIANT]: FormulaArray is raw storage for Capacity Formulas, only the slots [0, Size) hold
+//             constructed Formulas. Growth move-constructs the Formulas into the new storage.
+//[INVARIANT]: Unless 'BookIsStale' is set, 'Book' row i describes 'FormulaArray[i]' as long as the
+//             Formula still uses the recipe the book pinned. Every method that can change a Formula
+//             (including the non-const 'operator[]', which hands out a mutable reference) marks the
+//             book stale; a change made later through a kept reference detaches the recipe, which
+//             'GetFormulaBook()' notices.
 //
 //[MOVE SEMANTICS]
 //{
@@ -69,6 +77,21 @@
 //
 //        [EXTERNAL]:
 //          - 'Formula' class {[SEE]: Formula.h}
+//          - 'Xoshiro256StarStar', 'Philox4x32' {[SEE]: RandomEngine.h}
+//          - 'FormulaBook' class {[SEE]: FormulaBook.h}
+//
+//[SEEDING]
+//{
+// Plan Object(...);
+// Object.SetSeed(42);   -> every 'PlanApply()' from here on is reproducible
+// Object.PlanApply();   -> round 0, step i draws from stream (42, 0, i)
+// Object.PlanApply();   -> round 1, step i draws from stream (42, 1, i)
+// Object.ClearSeed();   -> back to the per-thread engine
+//
+// Object.SetCounterKey(42, PlanId);        -> counter-based, no hidden state per draw
+// Object.ApplyAt(Step, Trial);             -> same result on any thread, in any order
+// Object.EvaluateAt(Step, Trial, Buffer);  -> same, without touching the Formula
+//}
 //
 //[NAMESPACE]: Might be deemed unnecessary, but despite the distinctive function names, global
 //             namespace pollution is still in the picture.
@@ -79,30 +102,69 @@
 #define Plan_h
 
 #include "Formula.h"
+#include "FormulaBook.h"
 
 namespace ResourceConversion
 {
   class Plan
   {
+  public:
+    //[DESC]: Where 'PlanApply()' draws its random values from.
+    //        - ThreadLocal: the calling thread's engine, not reproducible.
+    //        - Seeded: one 'Xoshiro256StarStar' stream per (seed, round, step).
+    //        - CounterBased: 'Philox4x32' keyed by (seed, plan id, step, trial), order independent.
+    enum class RandomMode { ThreadLocal, Seeded, CounterBased };
+
+    //[DESC]: Everything that decides the draws of the following applications {[SEE]: PlanCheckpoint.h}
+    struct RandomState
+    {
+      std::uint64_t Seed = 0;
+      std::uint64_t ApplyRound = 0;
+      std::uint32_t PlanId = 0;
+      RandomMode Mode = RandomMode::ThreadLocal;
+    };
+
   private:
     bool ShouldPrintValues = true;
 
+    static inline Formula* AllocateFormulas (size_t Count);
+    static inline void ReleaseFormulas (Formula* Formulas, size_t Count);
+    static inline Formula* CopyFormulas (const Formula* Formulas, size_t Count, size_t NewCapacity);
     inline void ResizePlan (size_t NewCapacity);
+    inline size_t GrowthCapacity () const;
       
     inline void ClearPlan ();
     inline void CopyPlanData (const Plan& other);
     inline void ResetPlan ();
-    inline void ReassignData(Plan&& other) const;
+    inline void ReassignData(Plan&& other);
     inline void SwapData(Plan&& other);
 
     inline bool PlanArraysAreEqual(const Plan& other) const;
-    inline void PushDefaultValueInArray(size_t OldSize); 
+    inline void PushDefaultValueInArray(size_t NewSize); 
     inline void ConcatinateArrays(const Plan& other);
 
+    std::uint64_t Seed = 0;
+    std::uint64_t ApplyRound = 0;
+    std::uint32_t PlanId = 0;
+    RandomMode Mode = RandomMode::ThreadLocal;
+
+    //[NOTE]: Packed copy of the recipes, rebuilt lazily by 'GetFormulaBook()' after any change
+    mutable FormulaBook Book = FormulaBook ();
+    mutable bool BookIsStale = true;
+
+    //[NOTE]: Unique across all Plans, replaced whenever the book goes stale {[SEE]: 'CompiledPlan'}
+    static std::uint64_t NewRevision ();
+    std::uint64_t Revision = NewRevision ();
+    inline void InvalidateBook () { BookIsStale = true; Revision = NewRevision (); }
+
+    inline Philox4x32 CounterEngine (size_t Index, std::uint32_t Trial) const;
+
   protected:
     size_t Capacity = 2;
     size_t Size = 1;
     Formula* FormulaArray = nullptr;
+
+    void ApplyFormulaAt (size_t Index);
       
   public:
     Plan ();
@@ -117,12 +179,34 @@ namespace ResourceConversion
     Plan& operator=(Plan&& other);
 
     virtual void AddFormula (const Formula &NewFormula);
+    virtual void AddFormula (Formula &&NewFormula);
     virtual void RemoveLastFormula ();
     virtual void ReplaceFormula (const Formula& NewFormula, const size_t &Index);
 
+    void Reserve (size_t NewCapacity);
+    void ShrinkToFit ();
+    inline size_t GetSize () const { return Size; }
+    inline size_t GetCapacity () const { return Capacity; }
+
     virtual void PlanApply ();
+    void FinishApplyRound ();
     void PlanDisplayValues(const bool PrintResultArray = false) const;
 
+    void SetSeed (std::uint64_t Seed_);
+    void SetCounterKey (std::uint64_t Seed_, std::uint32_t PlanId_);
+    void ClearSeed ();
+    bool HasSeed () const;
+    RandomMode GetRandomMode () const { return Mode; }
+    RandomState GetRandomState () const;
+    void RestoreRandomState (const RandomState& State);
+
+    const FormulaBook& GetFormulaBook () const;
+    inline std::uint64_t GetRevision () const { return Revision; }
+    const Formula& GetFormula (size_t Index) const;
+
+    void ApplyAt (size_t Index, std::uint32_t Trial);
+    Formula::Outcome EvaluateAt (size_t Index, std::uint32_t Trial, unsigned int* Destination) const;
+
     //[OPERATORS]
     bool operator!=(const Plan& other) const;
     bool operator==(const Plan& other) const;
@@ -133,7 +217,8 @@ namespace ResourceConversion
     bool operator<=(const Plan& other) const;
     bool operator>=(const Plan& other) const;
 
-    Formula& operator[](size_t Index) const;
+    const Formula& operator[](size_t Index) const;
+    Formula& operator[](size_t Index);
     
     Plan operator+(const Plan& other);
 
@@ -0,0 +1,520 @@
+//[FILE]: PlanArchive.cpp
+//[DESC]: This file contains the implementation of the 'PlanArchive' class {[SEE]: PlanArchive.h}
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: The header is written first and read by copy; every section is read in place.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PLAN_ARCHIVE_MMAP 1
+#endif
+
+#include "PlanArchive.h"
+
+namespace ResourceConversion
+{
+  namespace
+  {
+    constexpr char Magic[4] = {'R', 'C', 'A', 'T'};
+    constexpr std::uint32_t FormatVersion = 1;
+    constexpr std::uint32_t ByteOrderMark = 0x01020304u;
+    constexpr std::uint32_t NoStockpile = 0xFFFFFFFFu;
+    constexpr std::uint32_t Unnamed = 0xFFFFFFFFu;
+    constexpr size_t Alignment = 8;
+
+    enum SectionIndex : size_t
+    {
+      NameOffsets, NameChars, InputOffsets, InputNames, InputQuantities, OutputOffsets, OutputNames,
+      OutputQuantities, Levels, Results, StockpileNames, StockpileQuantities, SectionCount
+    };
+
+    struct Section
+    {
+      std::uint64_t Offset;
+      std::uint64_t Bytes;
+    };
+
+    struct Header
+    {
+      char Magic[4];
+      std::uint32_t Version;
+      std::uint32_t ByteOrder;
+      std::uint32_t StockpileMode;
+      std::uint64_t FileSize;
+      std::uint64_t NameCount;
+      std::uint64_t FormulaCount;
+      std::uint64_t InputCount;
+      std::uint64_t OutputCount;
+      std::uint64_t StockpileCount;
+      Section Sections[SectionCount];
+    };
+    static_assert(std::is_trivially_copyable<Header>::value && sizeof(Header) % Alignment == 0, "[PA] the header is copied as bytes");
+
+    inline size_t Padded(size_t Bytes) { return (Bytes + Alignment - 1) / Alignment * Alignment; }
+
+    //[DESC]: Element size of every section, 1 for the name characters
+    constexpr size_t ElementSize[SectionCount] = {
+      sizeof(std::uint64_t), sizeof(char), sizeof(std::uint64_t), sizeof(std::uint32_t), sizeof(std::uint32_t),
+      sizeof(std::uint64_t), sizeof(std::uint32_t), sizeof(std::uint32_t), sizeof(std::uint32_t), sizeof(std::uint32_t),
+      sizeof(std::uint32_t), sizeof(std::uint64_t)};
+
+    template<typename T> inline const T* At(const char* Base, const Section& Where)
+    {
+      return reinterpret_cast<const T*>(Base + Where.Offset);
+    }
+  }
+
+  //[DESC]: Open an archive and map it for reading
+  //[PARAM]: 'Path' The file of the archive
+  //[PRE]: None
+  //[POST]: The sections can be read in place. Only the header and the extent of every section were
+  //        checked {[SEE]: Verify()}
+  //[THROW]: 'std::runtime_error' If the file cannot be read, is not an archive of this version and byte
+  //         order, or a section lies outside the file
+  PlanArchive::PlanArchive(const std::string& Path)
+  {
+    Open(Path);
+    try
+    {
+      Bind();
+    }
+    catch(...)
+    {
+      Release();
+      throw;
+    }
+  }
+
+  //[DESC]: Destructor for the 'PlanArchive' class
+  //[PRE]: None
+  //[POST]: The mapping is released, every view of the archive is invalid
+  PlanArchive::~PlanArchive() { Release(); }
+
+  //[DESC]: Move constructor, the mapping changes owner
+  //[PRE]: None
+  //[POST]: 'other' is closed, views of the archive stay valid
+  //[THROW]: Tagged as noexcept
+  PlanArchive::PlanArchive(PlanArchive&& other) noexcept
+    : Base(other.Base), Length(other.Length), Mapped(other.Mapped), Buffer(std::move(other.Buffer)), Sections(other.Sections)
+  {
+    other.Base = nullptr;
+    other.Length = 0;
+    other.Mapped = false;
+    other.Sections = Layout();
+  }
+
+  //[DESC]: Move assignment operator, the mapping changes owner
+  //[PRE]: None
+  //[POST]: The archive held before is released, 'other' is closed
+  //[THROW]: Tagged as noexcept
+  PlanArchive& PlanArchive::operator=(PlanArchive&& other) noexcept
+  {
+    if(this != &other)
+    {
+      Release();
+      Base = other.Base;
+      Length = other.Length;
+      Mapped = other.Mapped;
+      Buffer = std::move(other.Buffer);
+      Sections = other.Sections;
+      other.Base = nullptr;
+      other.Length = 0;
+      other.Mapped = false;
+      other.Sections = Layout();
+    }
+    return *this;
+  }
+
+  //[DESC]: Map the file, or read it where mapping is not available
+  //[PARAM]: 'Path' The file of the archive
+  //[PRE]: Nothing is open
+  //[POST]: 'Base' points to 'Length' bytes of the file
+  //[THROW]: 'std::runtime_error' If the file cannot be read
+  void PlanArchive::Open(const std::string& Path)
+  {
+#ifdef PLAN_ARCHIVE_MMAP
+    const int File = ::open(Path.c_str(), O_RDONLY);
+    if(File < 0) { throw std::runtime_error("[PA]PlanArchive(...) [Cannot read the archive]"); }
+    struct stat Info;
+    if(::fstat(File, &Info) != 0 || Info.st_size <= 0)
+    {
+      ::close(File);
+      throw std::runtime_error("[PA]PlanArchive(...) [Cannot read the archive]");
+    }
+    Length = static_cast<size_t>(Info.st_size);
+    void* Mapping = ::mmap(nullptr, Length, PROT_READ, MAP_PRIVATE, File, 0);
+    ::close(File);
+    if(Mapping == MAP_FAILED)
+    {
+      Length = 0;
+      throw std::runtime_error("[PA]PlanArchive(...) [Cannot read the archive]");
+    }
+    Base = static_cast<const char*>(Mapping);
+    Mapped = true;
+#else
+    std::ifstream File(Path, std::ios::binary | std::ios::ate);
+    if(!File) { throw std::runtime_error("[PA]PlanArchive(...) [Cannot read the archive]"); }
+    Length = static_cast<size_t>(File.tellg());
+    Buffer.assign((Length + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t), 0);
+    File.seekg(0);
+    if(!File.read(reinterpret_cast<char*>(Buffer.data()), static_cast<std::streamsize>(Length)))
+    {
+      throw std::runtime_error("[PA]PlanArchive(...) [Cannot read the archive]");
+    }
+    Base = reinterpret_cast<const char*>(Buffer.data());
+#endif
+  }
+
+  //[DESC]: Check the header and point 'Sections' into the file
+  //[PRE]: 'Base' holds the file
+  //[POST]: Every section lies inside the file, starts aligned and has the size its count implies; the
+  //        offset tables start at 0 and end at the length of their rows
+  //[THROW]: 'std::runtime_error' If any of this does not hold
+  void PlanArchive::Bind()
+  {
+    Header Head;
+    if(Length < sizeof(Header)) { throw std::runtime_error("[PA]PlanArchive(...) [Not an archive]"); }
+    std::memcpy(&Head, Base, sizeof(Header));
+    if(std::memcmp(Head.Magic, Magic, sizeof(Magic)) != 0) { throw std::runtime_error("[PA]PlanArchive(...) [Not an archive]"); }
+    if(Head.ByteOrder != ByteOrderMark) { throw std::runtime_error("[PA]PlanArchive(...) [Archive was written in another byte order]"); }
+    if(Head.Version != FormatVersion) { throw std::runtime_error("[PA]PlanArchive(...) [Unsupported archive version]"); }
+    if(Head.FileSize != Length) { throw std::runtime_error("[PA]PlanArchive(...) [Archive is truncated]"); }
+    if(Head.StockpileMode != NoStockpile && Head.StockpileMode > static_cast<std::uint32_t>(Stockpile::StorageMode::Versioned))
+    {
+      throw std::runtime_error("[PA]PlanArchive(...) [Malformed archive]");
+    }
+
+    if(Head.NameCount >= Length || Head.FormulaCount >= Length) { throw std::runtime_error("[PA]PlanArchive(...) [Malformed archive]"); }
+
+    const std::uint64_t Counts[SectionCount] = {
+      Head.NameCount + 1, 0, Head.FormulaCount + 1, Head.InputCount, Head.InputCount, Head.FormulaCount + 1, Head.OutputCount,
+      Head.OutputCount, Head.FormulaCount, Head.OutputCount, Head.StockpileCount, Head.StockpileCount};
+    for(size_t s = 0; s < SectionCount; s++)
+    {
+      const Section& Where = Head.Sections[s];
+      const bool Inside = Where.Offset >= sizeof(Header) && Where.Offset % Alignment == 0 && Where.Offset <= Length &&
+                          Where.Bytes <= Length - Where.Offset;
+      const bool Sized = s == NameChars || (Counts[s] <= Length / ElementSize[s] && Where.Bytes == Counts[s] * ElementSize[s]);
+      if(!Inside || !Sized) { throw std::runtime_error("[PA]PlanArchive(...) [Malformed archive]"); }
+    }
+
+    Layout Bound;
+    Bound.NameCount = static_cast<size_t>(Head.NameCount);
+    Bound.FormulaCount = static_cast<size_t>(Head.FormulaCount);
+    Bound.InputCount = static_cast<size_t>(Head.InputCount);
+    Bound.OutputCount = static_cast<size_t>(Head.OutputCount);
+    Bound.StockpileCount = static_cast<size_t>(Head.StockpileCount);
+    Bound.NameBytes = static_cast<size_t>(Head.Sections[NameChars].Bytes);
+    Bound.HasStockpile = Head.StockpileMode != NoStockpile;
+    Bound.Mode = Bound.HasStockpile ? static_cast<Stockpile::StorageMode>(Head.StockpileMode) : Stockpile::StorageMode::Map;
+    Bound.NameOffsets = At<std::uint64_t>(Base, Head.Sections[NameOffsets]);
+    Bound.NameChars = At<char>(Base, Head.Sections[NameChars]);
+    Bound.InputOffsets = At<std::uint64_t>(Base, Head.Sections[InputOffsets]);
+    Bound.InputNames = At<std::uint32_t>(Base, Head.Sections[InputNames]);
+    Bound.InputQuantities = At<std::uint32_t>(Base, Head.Sections[InputQuantities]);
+    Bound.OutputOffsets = At<std::uint64_t>(Base, Head.Sections[OutputOffsets]);
+    Bound.OutputNames = At<std::uint32_t>(Base, Head.Sections[OutputNames]);
+    Bound.OutputQuantities = At<std::uint32_t>(Base, Head.Sections[OutputQuantities]);
+    Bound.Levels = At<std::uint32_t>(Base, Head.Sections[Levels]);
+    Bound.Results = At<std::uint32_t>(Base, Head.Sections[Results]);
+    Bound.StockpileNames = At<std::uint32_t>(Base, Head.Sections[StockpileNames]);
+    Bound.StockpileQuantities = At<std::uint64_t>(Base, Head.Sections[StockpileQuantities]);
+
+    const bool Ends = Bound.NameOffsets[0] == 0 && Bound.NameOffsets[Bound.NameCount] == Bound.NameBytes &&
+                      Bound.InputOffsets[0] == 0 && Bound.InputOffsets[Bound.FormulaCount] == Bound.InputCount &&
+                      Bound.OutputOffsets[0] == 0 && Bound.OutputOffsets[Bound.FormulaCount] == Bound.OutputCount;
+    if(!Ends) { throw std::runtime_error("[PA]PlanArchive(...) [Malformed archive]"); }
+    Sections = Bound;
+  }
+
+  //[DESC]: Unmap the file, or drop the copy read into memory
+  //[PRE]: None
+  //[POST]: Nothing is open
+  void PlanArchive::Release()
+  {
+#ifdef PLAN_ARCHIVE_MMAP
+    if(Mapped && Base != nullptr) { ::munmap(const_cast<char*>(Base), Length); }
+#endif
+    Buffer.clear();
+    Buffer.shrink_to_fit();
+    Base = nullptr;
+    Length = 0;
+    Mapped = false;
+    Sections = Layout();
+  }
+
+  //[DESC]: Check the contents of every section
+  //[PRE]: None
+  //[POST]: Every offset table is in order and every name index is in range, so the accessors and
+  //        'AppendTo(...)' / 'ToStockpile()' never read outside the file. Levels are in the range
+  //        applying can reach. No name appears twice in the name table and no resource twice in the
+  //        stockpile, so nothing is silently merged when objects are built.
+  //[THROW]: 'std::runtime_error' If the archive is malformed or holds a duplicate
+  void PlanArchive::Verify() const
+  {
+    const Layout& L = Sections;
+    bool Valid = true;
+    for(size_t i = 0; i < L.NameCount && Valid; i++) { Valid = L.NameOffsets[i] <= L.NameOffsets[i + 1]; }
+    for(size_t i = 0; i < L.FormulaCount && Valid; i++)
+    {
+      Valid = L.InputOffsets[i] <= L.InputOffsets[i + 1] && L.OutputOffsets[i] <= L.OutputOffsets[i + 1] && L.Levels[i] <= 6;
+    }
+    for(size_t j = 0; j < L.InputCount && Valid; j++) { Valid = L.InputNames[j] < L.NameCount; }
+    for(size_t j = 0; j < L.OutputCount && Valid; j++) { Valid = L.OutputNames[j] < L.NameCount; }
+    for(size_t j = 0; j < L.StockpileCount && Valid; j++) { Valid = L.StockpileNames[j] < L.NameCount; }
+    if(!Valid) { throw std::runtime_error("[PA]Verify() [Malformed archive]"); }
+
+    std::unordered_set<std::string_view> Distinct;
+    Distinct.reserve(L.NameCount);
+    for(std::uint32_t i = 0; i < L.NameCount; i++)
+    {
+      if(!Distinct.insert(GetName(i)).second) { throw std::runtime_error("[PA]Verify() [Duplicate resource name]"); }
+    }
+    std::vector<char> Stocked(L.NameCount, 0);
+    for(size_t j = 0; j < L.StockpileCount; j++)
+    {
+      if(Stocked[L.StockpileNames[j]]++ != 0) { throw std::runtime_error("[PA]Verify() [Duplicate stockpile entry]"); }
+    }
+  }
+
+  //[DESC]: Name of a resource of the archive
+  //[PARAM]: 'Index' Index into the name table, as found in the name sections
+  //[PRE]: 'Index' < 'NameCount()'
+  //[RETURN]: The name, viewing the mapped file
+  //[THROW]: 'std::out_of_range' If 'Index' is out of range
+  std::string_view PlanArchive::GetName(std::uint32_t Index) const
+  {
+    if(Index >= Sections.NameCount) { throw std::out_of_range("[PA]GetName(...) [Index out of range]"); }
+    const size_t Begin = static_cast<size_t>(Sections.NameOffsets[Index]);
+    return std::string_view(Sections.NameChars + Begin, static_cast<size_t>(Sections.NameOffsets[Index + 1]) - Begin);
+  }
+
+  //[DESC]: Intern every name of the archive
+  //[PRE]: The archive was verified, or comes from a trusted source
+  //[POST]: Every name is in the 'ResourceRegistry'
+  //[RETURN]: The 'ResourceId' of every name index
+  std::vector<ResourceId> PlanArchive::ResolveNames() const
+  {
+    ResourceRegistry& Registry = ResourceRegistry::Instance();
+    std::vector<ResourceId> Ids(Sections.NameCount);
+    for(std::uint32_t i = 0; i < Sections.NameCount; i++) { Ids[i] = Registry.Intern(std::string(GetName(i))); }
+    return Ids;
+  }
+
+  //[DESC]: Append the formulas of the archive to a plan
+  //[PARAM]: 'Destination' The plan, an 'ExecutablePlan' gets them as steps that did not run yet
+  //[PRE]: None
+  //[POST]: 'Destination' ends with the archived formulas in order, with their levels and results. Names are
+  //        interned once per archive, not once per formula.
+  //[THROW]: 'std::runtime_error' If the archive is malformed {[SEE]: Verify()}
+  void PlanArchive::AppendTo(Plan& Destination) const
+  {
+    Verify();
+    const std::vector<ResourceId> Ids = ResolveNames();
+    std::vector<ResourceId> InputIds, OutputIds;
+
+    Destination.Reserve(Destination.GetSize() + Sections.FormulaCount);
+    for(size_t i = 0; i < Sections.FormulaCount; i++)
+    {
+      InputIds.clear();
+      OutputIds.clear();
+      for(size_t j = InputBegin(i); j < InputEnd(i); j++) { InputIds.push_back(Ids[Sections.InputNames[j]]); }
+      for(size_t j = OutputBegin(i); j < OutputEnd(i); j++) { OutputIds.push_back(Ids[Sections.OutputNames[j]]); }
+
+      const Formula::ResourceView Recipe{Span<const ResourceId>(InputIds.data(), InputIds.size()),
+                                         Span<const unsigned int>(Sections.InputQuantities + InputBegin(i), InputIds.size()),
+                                         Span<const ResourceId>(OutputIds.data(), OutputIds.size()),
+                                         Span<const unsigned int>(Sections.OutputQuantities + OutputBegin(i), OutputIds.size())};
+      Formula Restored(Recipe);
+      Restored.RestoreProgress(GetLevel(i), Sections.Results + OutputBegin(i));
+      Destination.AddFormula(std::move(Restored));
+    }
+  }
+
+  //[DESC]: Build the archived stockpile
+  //[PRE]: The archive holds a stockpile
+  //[POST]: None, the archive is only read
+  //[RETURN]: A stockpile in the archived storage mode with the archived quantities, also when it is empty
+  //[THROW]: 'std::runtime_error' If the archive holds no stockpile or is malformed {[SEE]: Verify()}
+  //[NOTE]: Names are interned straight from the name table and the quantities deposited by id into a
+  //        'Dense' stockpile, which is converted once if the archived mode is another one.
+  std::shared_ptr<Stockpile> PlanArchive::ToStockpile() const
+  {
+    if(!Sections.HasStockpile) { throw std::runtime_error("[PA]ToStockpile() [Archive holds no stockpile]"); }
+    Verify();
+
+    std::shared_ptr<Stockpile> Restored = std::make_shared<Stockpile>();
+    if(Sections.StockpileCount == 0)
+    {
+      Restored -> CopyFrom(Stockpile(), Sections.Mode);
+      return Restored;
+    }
+
+    ResourceRegistry& Registry = ResourceRegistry::Instance();
+    Stockpile Staging;
+    Staging.CopyFrom(Stockpile(), Stockpile::StorageMode::Dense);
+    for(size_t j = 0; j < Sections.StockpileCount; j++)
+    {
+      const ResourceId Resource = Registry.Intern(std::string(GetName(Sections.StockpileNames[j])));
+      Staging.Deposit(Resource, static_cast<size_t>(Sections.StockpileQuantities[j]));
+    }
+    if(Sections.Mode == Stockpile::StorageMode::Dense) { return std::make_shared<Stockpile>(std::move(Staging)); }
+
+    Restored -> CopyFrom(Staging, Sections.Mode);
+    return Restored;
+  }
+
+  //[DESC]: Write the formulas of a plan to an archive
+  //[PARAM]: 'Path' The file, replaced if it exists
+  //[PARAM]: 'Formulas' The plan
+  //[PRE]: None
+  //[POST]: 'PlanArchive(Path)' reads the formulas back, with their levels and results
+  //[THROW]: 'std::runtime_error' If the file cannot be written
+  void PlanArchive::Write(const std::string& Path, const Plan& Formulas) { WriteFile(Path, Formulas, nullptr); }
+
+  //[DESC]: Write the formulas of a plan and a stockpile to an archive
+  //[PARAM]: 'Path' The file, replaced if it exists
+  //[PARAM]: 'Formulas' The plan, may be empty to store only the stockpile
+  //[PARAM]: 'Resources' The stockpile
+  //[PRE]: No other thread changes either while the archive is written
+  //[POST]: 'PlanArchive(Path)' reads both back
+  //[THROW]: 'std::runtime_error' If the file cannot be written
+  void PlanArchive::Write(const std::string& Path, const Plan& Formulas, const Stockpile& Resources)
+  {
+    WriteFile(Path, Formulas, &Resources);
+  }
+
+  //[DESC]: Lay out the sections and write them after the header
+  //[PARAM]: 'Path' The file, replaced if it exists
+  //[PARAM]: 'Formulas' The plan
+  //[PARAM]: 'Resources' The stockpile, or nullptr for none
+  //[PRE]: None
+  //[POST]: The archive is written to a new file that replaces 'Path' in one rename, so a reader sees the
+  //        old archive or the new one, never a part
+  //[THROW]: 'std::runtime_error' If the file cannot be written
+  void PlanArchive::WriteFile(const std::string& Path, const Plan& Formulas, const Stockpile* Resources)
+  {
+    //[NOTE]: Names are numbered in order of first use, formulas first, then the stockpile
+    std::vector<std::uint32_t> LocalOf;
+    std::vector<ResourceId> Names;
+    auto NameOf = [&LocalOf, &Names](ResourceId Resource) -> std::uint32_t {
+      if(Resource >= LocalOf.size()) { LocalOf.resize(static_cast<size_t>(Resource) + 1, Unnamed); }
+      if(LocalOf[Resource] == Unnamed)
+      {
+        LocalOf[Resource] = static_cast<std::uint32_t>(Names.size());
+        Names.push_back(Resource);
+      }
+      return LocalOf[Resource];
+    };
+
+    const size_t Count = Formulas.GetSize();
+    std::vector<std::uint64_t> InOffsets(1, 0), OutOffsets(1, 0), NameOffsetTable(1, 0), StockQuantities;
+    std::vector<std::uint32_t> InNames, InQuantities, OutNames, OutQuantities, LevelTable, ResultTable, StockNames;
+    InOffsets.reserve(Count + 1);
+    OutOffsets.reserve(Count + 1);
+    LevelTable.reserve(Count);
+    for(size_t i = 0; i < Count; i++)
+    {
+      const Formula& Current = Formulas.GetFormula(i);
+      const Formula::ResourceView Recipe = Current.GetView();
+      for(size_t j = 0; j < Recipe.InputResources.size(); j++)
+      {
+        InNames.push_back(NameOf(Recipe.InputResources[j]));
+        InQuantities.push_back(Recipe.InputQuantities[j]);
+      }
+      for(size_t j = 0; j < Recipe.OutputResources.size(); j++)
+      {
+        OutNames.push_back(NameOf(Recipe.OutputResources[j]));
+        OutQuantities.push_back(Recipe.OutputQuantities[j]);
+        ResultTable.push_back(Current.GetResultArray() != nullptr ? Current.GetResultArray()[j] : 0u);
+      }
+      InOffsets.push_back(InNames.size());
+      OutOffsets.push_back(OutNames.size());
+      LevelTable.push_back(Current.GetProficiencyLevel());
+    }
+    if(Resources != nullptr)
+    {
+      Resources->ForEachResource([&](ResourceId Resource, size_t Quantity) {
+        StockNames.push_back(NameOf(Resource));
+        StockQuantities.push_back(Quantity);
+      });
+    }
+
+    std::string NameText;
+    ResourceRegistry& Registry = ResourceRegistry::Instance();
+    for(ResourceId Resource : Names)
+    {
+      NameText += Registry.GetName(Resource);
+      NameOffsetTable.push_back(NameText.size());
+    }
+
+    const std::pair<const void*, size_t> Contents[SectionCount] = {
+      {NameOffsetTable.data(), NameOffsetTable.size() * sizeof(std::uint64_t)},
+      {NameText.data(), NameText.size()},
+      {InOffsets.data(), InOffsets.size() * sizeof(std::uint64_t)},
+      {InNames.data(), InNames.size() * sizeof(std::uint32_t)},
+      {InQuantities.data(), InQuantities.size() * sizeof(std::uint32_t)},
+      {OutOffsets.data(), OutOffsets.size() * sizeof(std::uint64_t)},
+      {OutNames.data(), OutNames.size() * sizeof(std::uint32_t)},
+      {OutQuantities.data(), OutQuantities.size() * sizeof(std::uint32_t)},
+      {LevelTable.data(), LevelTable.size() * sizeof(std::uint32_t)},
+      {ResultTable.data(), ResultTable.size() * sizeof(std::uint32_t)},
+      {StockNames.data(), StockNames.size() * sizeof(std::uint32_t)},
+      {StockQuantities.data(), StockQuantities.size() * sizeof(std::uint64_t)}};
+
+    Header Head;
+    std::memset(&Head, 0, sizeof(Header));
+    std::memcpy(Head.Magic, Magic, sizeof(Magic));
+    Head.Version = FormatVersion;
+    Head.ByteOrder = ByteOrderMark;
+    Head.StockpileMode = Resources != nullptr ? static_cast<std::uint32_t>(Resources->GetStorageMode()) : NoStockpile;
+    Head.NameCount = Names.size();
+    Head.FormulaCount = Count;
+    Head.InputCount = InNames.size();
+    Head.OutputCount = OutNames.size();
+    Head.StockpileCount = StockNames.size();
+    size_t Offset = sizeof(Header);
+    for(size_t s = 0; s < SectionCount; s++)
+    {
+      Head.Sections[s] = Section{Offset, Contents[s].second};
+      Offset += Padded(Contents[s].second);
+    }
+    Head.FileSize = Offset;
+
+    const std::string Staging = Path + ".tmp";
+    {
+      std::ofstream File(Staging, std::ios::binary | std::ios::trunc);
+      const char Padding[Alignment] = {};
+      File.write(reinterpret_cast<const char*>(&Head), sizeof(Header));
+      for(size_t s = 0; s < SectionCount; s++)
+      {
+        File.write(static_cast<const char*>(Contents[s].first), static_cast<std::streamsize>(Contents[s].second));
+        File.write(Padding, static_cast<std::streamsize>(Padded(Contents[s].second) - Contents[s].second));
+      }
+      if(!File.flush()) { throw std::runtime_error("[PA]Write(...) [Cannot write the archive]"); }
+    }
+    if(std::rename(Staging.c_str(), Path.c_str()) != 0)
+    {
+      std::remove(Staging.c_str());
+      throw std::runtime_error("[PA]Write(...) [Cannot write the archive]");
+    }
+  }
+}//[NAMESPACE]: ResourceConversion
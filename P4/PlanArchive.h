@@ -0,0 +1,177 @@
+//[FILE]: PlanArchive.h
+//[DESC]: This file defines the 'PlanArchive' class, a versioned binary file holding a catalog of formulas
+//        (the formulas of a 'Plan', in order) and optionally a 'Stockpile'. The file is laid out the way
+//        it is used, so opening it maps it into memory and reads it in place; nothing is parsed and
+//        nothing is allocated per formula:
+//
+//          Header       "RCAT" Version ByteOrder FileSize Counts Sections[12] {Offset, Bytes}
+//          Names        NameOffsets [0, 4, 9, ...]       NameChars "IronSteel..."
+//          Inputs       InputOffsets [0, 2, 5, ...]      InputNames [0, 3, ...]  InputQuantities [2, 1, ...]
+//          Outputs      OutputOffsets, OutputNames, OutputQuantities, Results
+//          Formulas     Levels [0, 3, ...]
+//          Stockpile    StockpileNames [1, 4, ...]       StockpileQuantities [500, 20, ...]
+//
+//        The formula sections are the compressed rows of 'FormulaBook', with resources given as indices
+//        into the name table of the file (a 'ResourceId' only means something in one process). Every
+//        section starts on an 8-byte boundary, so the offsets and quantities can be read through plain
+//        pointers into the mapping.
+//
+//        Opening checks the header and that every section lies inside the file, which costs the same for
+//        ten formulas or ten million. 'Verify()' checks the contents (offsets in order, names in range,
+//        no name or stockpile entry twice) in one pass; 'AppendTo(...)' and 'ToStockpile()' verify first
+//        and then build objects.
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: While open, 'Sections' points into the mapped (or read) file and every section it points
+//             to lies inside it.
+//
+//[USAGE]
+//{
+// PlanArchive::Write("catalog.rca", Catalog, *StockpilePtr);    -> written once
+//
+// PlanArchive Archive("catalog.rca");                            -> mapped, used in place
+// for(size_t j = Archive.InputBegin(i); j < Archive.InputEnd(i); j++)
+// {
+//   Archive.GetName(Archive.GetInputNames()[j]);  Archive.GetInputQuantities()[j];
+// }
+//
+// ExecutablePlan Production;
+// Archive.AppendTo(Production);                                  -> only when objects are needed
+// std::shared_ptr<Stockpile> StockpilePtr = Archive.ToStockpile();
+//}
+//
+//[NOTE]: An 'ExecutablePlan' is stored as its formulas (recipe, level, results); its step and the
+//        completed steps are progress, which 'PlanCheckpoint' records {[SEE]: PlanCheckpoint.h}.
+//[NOTE]: Numbers are written in the byte order of the machine; an archive from a machine of the other
+//        byte order is refused when opened.
+//[NOTE]: Files are mapped where the operating system supports it (POSIX 'mmap'); elsewhere the file is
+//        read into memory once, with the same layout.
+//[NOTE]: A mapped archive must not be rewritten while open; 'Write(...)' replaces the file with a new one,
+//        which leaves open archives on the old one.
+//
+//[DEPENDENCIES]:
+//       [INTERNAL]:
+//          - Member, Helper, Utility methods
+//          - Private Data Members
+//
+//        [EXTERNAL]:
+//          - 'Plan', 'Formula' {[SEE]: Plan.h, Formula.h}
+//          - 'Stockpile' class {[SEE]: Stockpile.h}
+//          - 'Span' {[SEE]: Span.h}
+//
+//[NAMESPACE]: {ResourceConversion} Encapsulates the 'Formula', 'Plan', 'ExecutablePlan', 'Stockpile'
+//             and supporting classes.
+#ifndef PlanArchive_h
+#define PlanArchive_h
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Plan.h"
+#include "ResourceRegistry.h"
+#include "Span.h"
+#include "Stockpile.h"
+
+namespace ResourceConversion
+{
+  class PlanArchive
+  {
+    private:
+    //[NOTE]: Counts and section pointers of an open archive, empty when closed or moved from
+    struct Layout
+    {
+      size_t NameCount = 0;
+      size_t FormulaCount = 0;
+      size_t InputCount = 0;
+      size_t OutputCount = 0;
+      size_t StockpileCount = 0;
+      size_t NameBytes = 0;
+      bool HasStockpile = false;
+      Stockpile::StorageMode Mode = Stockpile::StorageMode::Map;
+
+      const std::uint64_t* NameOffsets = nullptr;
+      const char* NameChars = nullptr;
+      const std::uint64_t* InputOffsets = nullptr;
+      const std::uint32_t* InputNames = nullptr;
+      const std::uint32_t* InputQuantities = nullptr;
+      const std::uint64_t* OutputOffsets = nullptr;
+      const std::uint32_t* OutputNames = nullptr;
+      const std::uint32_t* OutputQuantities = nullptr;
+      const std::uint32_t* Levels = nullptr;
+      const std::uint32_t* Results = nullptr;
+      const std::uint32_t* StockpileNames = nullptr;
+      const std::uint64_t* StockpileQuantities = nullptr;
+    };
+
+    const char* Base = nullptr;
+    size_t Length = 0;
+    bool Mapped = false;
+    //[NOTE]: Holds the file where it cannot be mapped, as words so the sections stay aligned
+    std::vector<std::uint64_t> Buffer = std::vector<std::uint64_t>();
+    Layout Sections = Layout();
+
+    void Open(const std::string& Path);
+    void Bind();
+    void Release();
+    static void WriteFile(const std::string& Path, const Plan& Formulas, const Stockpile* Resources);
+
+    public:
+    explicit PlanArchive(const std::string& Path);
+    ~PlanArchive();
+
+    PlanArchive(const PlanArchive& other) = delete;
+    PlanArchive& operator=(const PlanArchive& other) = delete;
+    PlanArchive(PlanArchive&& other) noexcept;
+    PlanArchive& operator=(PlanArchive&& other) noexcept;
+
+    static void Write(const std::string& Path, const Plan& Formulas);
+    static void Write(const std::string& Path, const Plan& Formulas, const Stockpile& Resources);
+
+    void Verify() const;
+
+    inline size_t FormulaCount() const { return Sections.FormulaCount; }
+    inline size_t NameCount() const { return Sections.NameCount; }
+    std::string_view GetName(std::uint32_t Index) const;
+
+    inline size_t InputBegin(size_t Index) const { return static_cast<size_t>(Sections.InputOffsets[Index]); }
+    inline size_t InputEnd(size_t Index) const { return static_cast<size_t>(Sections.InputOffsets[Index + 1]); }
+    inline size_t OutputBegin(size_t Index) const { return static_cast<size_t>(Sections.OutputOffsets[Index]); }
+    inline size_t OutputEnd(size_t Index) const { return static_cast<size_t>(Sections.OutputOffsets[Index + 1]); }
+
+    inline const std::uint32_t* GetInputNames() const { return Sections.InputNames; }
+    inline const std::uint32_t* GetInputQuantities() const { return Sections.InputQuantities; }
+    inline const std::uint32_t* GetOutputNames() const { return Sections.OutputNames; }
+    inline const std::uint32_t* GetOutputQuantities() const { return Sections.OutputQuantities; }
+    inline unsigned int GetLevel(size_t Index) const { return Sections.Levels[Index]; }
+    inline Span<const std::uint32_t> GetResults(size_t Index) const
+    {
+      return Span<const std::uint32_t>(Sections.Results + OutputBegin(Index), OutputEnd(Index) - OutputBegin(Index));
+    }
+
+    inline bool HasStockpile() const { return Sections.HasStockpile; }
+    inline Stockpile::StorageMode GetStorageMode() const { return Sections.Mode; }
+    inline Span<const std::uint32_t> GetStockpileNames() const
+    {
+      return Span<const std::uint32_t>(Sections.StockpileNames, Sections.StockpileCount);
+    }
+    inline Span<const std::uint64_t> GetStockpileQuantities() const
+    {
+      return Span<const std::uint64_t>(Sections.StockpileQuantities, Sections.StockpileCount);
+    }
+
+    std::vector<ResourceId> ResolveNames() const;
+    void AppendTo(Plan& Destination) const;
+    std::shared_ptr<Stockpile> ToStockpile() const;
+  };
+}//[NAMESPACE]: ResourceConversion
+#endif /*PlanArchive_h*/
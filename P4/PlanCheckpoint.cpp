@@ -0,0 +1,548 @@
+//[FILE]: PlanCheckpoint.cpp
+//[DESC]: This file contains the implementation of the 'PlanCheckpoint' class {[SEE]: PlanCheckpoint.h}
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: Every record ends with the names it introduced, so a record is written in one pass; the
+//             reader resolves names once the whole log is read.
+
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "PlanCheckpoint.h"
+
+namespace ResourceConversion
+{
+  namespace
+  {
+    constexpr char Magic[4] = {'R', 'C', 'K', 'P'};
+    constexpr std::uint32_t FormatVersion = 1;
+
+    template<typename T> inline void Put(std::vector<char>& Buffer, T Value)
+    {
+      const size_t At = Buffer.size();
+      Buffer.resize(At + sizeof(T));
+      std::memcpy(Buffer.data() + At, &Value, sizeof(T));
+    }
+
+    //[NOTE]: FNV-1a, enough to tell a record cut short or overwritten by a crash from a good one
+    std::uint32_t Checksum(const char* Data, size_t Size)
+    {
+      std::uint32_t Hash = 2166136261u;
+      for(size_t i = 0; i < Size; i++)
+      {
+        Hash ^= static_cast<unsigned char>(Data[i]);
+        Hash *= 16777619u;
+      }
+      return Hash;
+    }
+
+    //[DESC]: Bounds-checked cursor over one record
+    struct Reader
+    {
+      const char* Data = nullptr;
+      size_t Size = 0;
+      size_t At = 0;
+
+      template<typename T> T Get()
+      {
+        if(Size - At < sizeof(T)) { throw std::runtime_error("[PC]Load(...) [Malformed record]"); }
+        T Value;
+        std::memcpy(&Value, Data + At, sizeof(T));
+        At += sizeof(T);
+        return Value;
+      }
+
+      //[DESC]: Read the length of an array whose elements take at least 'BytesEach' bytes of the record, so
+      //        a damaged length is rejected before anything is allocated for it
+      template<typename T> size_t GetCount(size_t BytesEach)
+      {
+        const T Count = Get<T>();
+        if(Count > (Size - At) / BytesEach) { throw std::runtime_error("[PC]Load(...) [Malformed record]"); }
+        return static_cast<size_t>(Count);
+      }
+
+      //[DESC]: Read an enumerator stored as one byte, 'Last' is the value of the last enumerator
+      std::uint8_t GetEnum(std::uint8_t Last)
+      {
+        const std::uint8_t Value = Get<std::uint8_t>();
+        if(Value > Last) { throw std::runtime_error("[PC]Load(...) [Malformed record]"); }
+        return Value;
+      }
+
+      std::string GetString()
+      {
+        const std::uint32_t Length = Get<std::uint32_t>();
+        if(Size - At < Length) { throw std::runtime_error("[PC]Load(...) [Malformed record]"); }
+        std::string Value(Data + At, Length);
+        At += Length;
+        return Value;
+      }
+    };
+
+    //[DESC]: What the records replayed so far describe, resources as indices of 'Names'
+    struct Image
+    {
+      struct FormulaImage
+      {
+        std::vector<std::uint32_t> InputNames = std::vector<std::uint32_t>();
+        std::vector<unsigned int> InputQuantities = std::vector<unsigned int>();
+        std::vector<std::uint32_t> OutputNames = std::vector<std::uint32_t>();
+        std::vector<unsigned int> OutputQuantities = std::vector<unsigned int>();
+        unsigned int Level = 0;
+        std::vector<unsigned int> Results = std::vector<unsigned int>();
+      };
+
+      std::vector<std::string> Names = std::vector<std::string>();
+      Plan::RandomState Random = Plan::RandomState();
+      unsigned int Step = 0;
+      std::vector<FormulaImage> Formulas = std::vector<FormulaImage>();
+      std::unique_ptr<bool[]> Completed = nullptr;
+      Stockpile::StorageMode Mode = Stockpile::StorageMode::Map;
+      std::unordered_map<std::uint32_t, size_t> Quantities = std::unordered_map<std::uint32_t, size_t>();
+
+      void ReadNames(Reader& Record)
+      {
+        const std::uint32_t Count = Record.Get<std::uint32_t>();
+        for(std::uint32_t i = 0; i < Count; i++) { Names.push_back(Record.GetString()); }
+      }
+
+      void ReadFull(Reader& Record)
+      {
+        Names.clear();
+        Quantities.clear();
+
+        Random.Seed = Record.Get<std::uint64_t>();
+        Random.ApplyRound = Record.Get<std::uint64_t>();
+        Random.PlanId = Record.Get<std::uint32_t>();
+        Random.Mode = static_cast<Plan::RandomMode>(Record.GetEnum(static_cast<std::uint8_t>(Plan::RandomMode::CounterBased)));
+        Step = Record.Get<std::uint32_t>();
+
+        //[NOTE]: A formula takes at least its two sizes and its level, an input or output its name and quantity
+        Formulas.assign(Record.GetCount<std::uint64_t>(3 * sizeof(std::uint32_t)), FormulaImage());
+        for(FormulaImage& Current : Formulas)
+        {
+          Current.InputNames.resize(Record.GetCount<std::uint32_t>(2 * sizeof(std::uint32_t)));
+          Current.InputQuantities.resize(Current.InputNames.size());
+          Current.OutputNames.resize(Record.GetCount<std::uint32_t>(2 * sizeof(std::uint32_t)));
+          Current.OutputQuantities.resize(Current.OutputNames.size());
+          Current.Results.resize(Current.OutputNames.size());
+
+          for(size_t j = 0; j < Current.InputNames.size(); j++)
+          {
+            Current.InputNames[j] = Record.Get<std::uint32_t>();
+            Current.InputQuantities[j] = Record.Get<unsigned int>();
+          }
+          for(size_t j = 0; j < Current.OutputNames.size(); j++)
+          {
+            Current.OutputNames[j] = Record.Get<std::uint32_t>();
+            Current.OutputQuantities[j] = Record.Get<unsigned int>();
+          }
+          Current.Level = Record.Get<unsigned int>();
+          for(unsigned int& Result : Current.Results) { Result = Record.Get<unsigned int>(); }
+        }
+
+        Completed.reset(new bool[Formulas.size()]());
+        for(size_t i = 0; i < Formulas.size(); i += 8)
+        {
+          const std::uint8_t Bits = Record.Get<std::uint8_t>();
+          for(size_t b = 0; b < 8 && i + b < Formulas.size(); b++) { Completed[i + b] = (Bits >> b) & 1u; }
+        }
+
+        Mode = static_cast<Stockpile::StorageMode>(Record.GetEnum(static_cast<std::uint8_t>(Stockpile::StorageMode::Versioned)));
+        const std::uint64_t Count = Record.Get<std::uint64_t>();
+        for(std::uint64_t i = 0; i < Count; i++)
+        {
+          const std::uint32_t Name = Record.Get<std::uint32_t>();
+          Quantities[Name] = Record.Get<std::uint64_t>();
+        }
+        ReadNames(Record);
+      }
+
+      void ReadDelta(Reader& Record)
+      {
+        auto Index = [this](std::uint64_t Value) -> size_t {
+          if(Value >= Formulas.size()) { throw std::runtime_error("[PC]Load(...) [Malformed record]"); }
+          return static_cast<size_t>(Value);
+        };
+
+        Random.ApplyRound = Record.Get<std::uint64_t>();
+        Step = Record.Get<std::uint32_t>();
+
+        const std::uint64_t Changed = Record.Get<std::uint64_t>();
+        for(std::uint64_t i = 0; i < Changed; i++)
+        {
+          FormulaImage& Current = Formulas[Index(Record.Get<std::uint64_t>())];
+          Current.Level = Record.Get<unsigned int>();
+          for(unsigned int& Result : Current.Results) { Result = Record.Get<unsigned int>(); }
+        }
+
+        const std::uint64_t Flipped = Record.Get<std::uint64_t>();
+        for(std::uint64_t i = 0; i < Flipped; i++)
+        {
+          const size_t At = Index(Record.Get<std::uint64_t>());
+          Completed[At] = Record.Get<std::uint8_t>() != 0;
+        }
+
+        const std::uint64_t Count = Record.Get<std::uint64_t>();
+        for(std::uint64_t i = 0; i < Count; i++)
+        {
+          const std::uint32_t Name = Record.Get<std::uint32_t>();
+          Quantities[Name] = Record.Get<std::uint64_t>();
+        }
+        ReadNames(Record);
+      }
+
+      const std::string& NameOf(std::uint32_t Index) const
+      {
+        if(Index >= Names.size()) { throw std::runtime_error("[PC]Load(...) [Malformed record]"); }
+        return Names[Index];
+      }
+
+      template<typename T> static T* Release(std::vector<T>& Values)
+      {
+        T* Array = new T[Values.size()];
+        std::copy(Values.begin(), Values.end(), Array);
+        return Array;
+      }
+
+      void Build(PlanCheckpoint::Restored& Result) const
+      {
+        for(const FormulaImage& Current : Formulas)
+        {
+          std::vector<std::string> Inputs, Outputs;
+          for(std::uint32_t Name : Current.InputNames) { Inputs.push_back(NameOf(Name)); }
+          for(std::uint32_t Name : Current.OutputNames) { Outputs.push_back(NameOf(Name)); }
+          std::vector<unsigned int> InputQuantities = Current.InputQuantities, OutputQuantities = Current.OutputQuantities;
+
+          Formula Restored(Release(Inputs), Inputs.size(), Release(InputQuantities), InputQuantities.size(),
+                           Release(Outputs), Outputs.size(), Release(OutputQuantities), OutputQuantities.size(), nullptr, 0);
+          Restored.RestoreProgress(Current.Level, Current.Results.data());
+          Result.Plan.AddFormula(std::move(Restored));
+        }
+        Result.Plan.RestoreRandomState(Random);
+        Result.Plan.RestoreProgress(Step, Span<const bool>(Completed.get(), Formulas.size()));
+
+        std::unordered_map<std::string, size_t> Contents;
+        for(const auto& [Name, Quantity] : Quantities) { Contents[NameOf(Name)] = Quantity; }
+        if(Contents.empty())
+        {
+          Result.Resources = std::make_shared<Stockpile>();
+          if(Mode != Stockpile::StorageMode::Map) { Result.Resources -> CopyFrom(Stockpile(), Mode); }
+        }
+        else { Result.Resources = std::make_shared<Stockpile>(Contents, Mode); }
+      }
+    };
+  }
+
+  //[DESC]: Constructor
+  //[PARAM]: 'Path_' The file of the log
+  //[PRE]: None
+  //[POST]: Nothing is written until the first record, which replaces whatever 'Path_' held
+  PlanCheckpoint::PlanCheckpoint(const std::string& Path_) : Path(Path_) {}
+
+  //[DESC]: Give a resource an index in the name table of the log
+  //[PARAM]: 'Resource' The resource
+  //[PRE]: None
+  //[POST]: A resource seen for the first time is queued to be named at the end of the current record
+  //[RETURN]: Its index
+  std::uint32_t PlanCheckpoint::NameOf(ResourceId Resource)
+  {
+    if(Resource >= LocalOf.size()) { LocalOf.resize(static_cast<size_t>(Resource) + 1, Unnamed); }
+    if(LocalOf[Resource] == Unnamed)
+    {
+      LocalOf[Resource] = NameCount++;
+      NewNames.push_back(Resource);
+    }
+    return LocalOf[Resource];
+  }
+
+  //[DESC]: End the current record with the names it introduced
+  //[PRE]: None
+  //[POST]: 'NewNames' is empty
+  void PlanCheckpoint::WriteNames()
+  {
+    ResourceRegistry& Registry = ResourceRegistry::Instance();
+    Put<std::uint32_t>(Payload, static_cast<std::uint32_t>(NewNames.size()));
+    for(ResourceId Resource : NewNames)
+    {
+      const std::string& Name = Registry.GetName(Resource);
+      Put<std::uint32_t>(Payload, static_cast<std::uint32_t>(Name.size()));
+      Payload.insert(Payload.end(), Name.begin(), Name.end());
+    }
+    NewNames.clear();
+  }
+
+  //[DESC]: Frame the current payload as a record and write it
+  //[PARAM]: 'File' The open log
+  //[PARAM]: 'Kind' Full image or delta
+  //[PRE]: None
+  //[POST]: The record is in the file and flushed to the operating system
+  //[THROW]: 'std::runtime_error' If the file cannot be written
+  void PlanCheckpoint::Append(std::ofstream& File, RecordKind Kind)
+  {
+    const std::uint32_t KindValue = static_cast<std::uint32_t>(Kind);
+    const std::uint64_t Size = Payload.size();
+    const std::uint32_t Sum = Checksum(Payload.data(), Payload.size());
+
+    File.write(reinterpret_cast<const char*>(&KindValue), sizeof(KindValue));
+    File.write(reinterpret_cast<const char*>(&Size), sizeof(Size));
+    File.write(Payload.data(), static_cast<std::streamsize>(Payload.size()));
+    File.write(reinterpret_cast<const char*>(&Sum), sizeof(Sum));
+    File.flush();
+    if(!File) { throw std::runtime_error("[PC]Record(...) [Cannot write the checkpoint]"); }
+  }
+
+  //[DESC]: Start a new log with a full image
+  //[PARAM]: 'Source' The plan
+  //[PARAM]: 'Resources' Its stockpile
+  //[PRE]: None
+  //[POST]: 'Path' holds the header and one full record, the previous log is replaced in one rename
+  //[THROW]: 'std::runtime_error' If the file cannot be written, the previous log is left in place
+  void PlanCheckpoint::WriteFull(const ExecutablePlan& Source, const Stockpile& Resources)
+  {
+    std::fill(LocalOf.begin(), LocalOf.end(), Unnamed);
+    NameCount = 0;
+    NewNames.clear();
+    Payload.clear();
+
+    const Plan::RandomState Random = Source.GetRandomState();
+    Put<std::uint64_t>(Payload, Random.Seed);
+    Put<std::uint64_t>(Payload, Random.ApplyRound);
+    Put<std::uint32_t>(Payload, Random.PlanId);
+    Put<std::uint8_t>(Payload, static_cast<std::uint8_t>(Random.Mode));
+    Put<std::uint32_t>(Payload, Source.GetStep());
+
+    const size_t Count = Source.GetSize();
+    Put<std::uint64_t>(Payload, Count);
+    LastOffsets.assign(1, 0);
+    LastFormulas.clear();
+    for(size_t i = 0; i < Count; i++)
+    {
+      const Formula& Current = Source.GetFormula(i);
+      const Formula::ResourceView Recipe = Current.GetView();
+      Put<std::uint32_t>(Payload, static_cast<std::uint32_t>(Recipe.InputResources.size()));
+      Put<std::uint32_t>(Payload, static_cast<std::uint32_t>(Recipe.OutputResources.size()));
+      for(size_t j = 0; j < Recipe.InputResources.size(); j++)
+      {
+        Put<std::uint32_t>(Payload, NameOf(Recipe.InputResources[j]));
+        Put<unsigned int>(Payload, Recipe.InputQuantities[j]);
+      }
+      for(size_t j = 0; j < Recipe.OutputResources.size(); j++)
+      {
+        Put<std::uint32_t>(Payload, NameOf(Recipe.OutputResources[j]));
+        Put<unsigned int>(Payload, Recipe.OutputQuantities[j]);
+      }
+
+      LastFormulas.push_back(Current.GetProficiencyLevel());
+      for(size_t j = 0; j < Recipe.OutputResources.size(); j++) { LastFormulas.push_back(Current.GetResultArray()[j]); }
+      for(size_t j = LastOffsets.back(); j < LastFormulas.size(); j++) { Put<unsigned int>(Payload, LastFormulas[j]); }
+      LastOffsets.push_back(LastFormulas.size());
+    }
+
+    LastCompleted.assign(Count, 0);
+    for(size_t i = 0; i < Count; i += 8)
+    {
+      std::uint8_t Bits = 0;
+      for(size_t b = 0; b < 8 && i + b < Count; b++)
+      {
+        LastCompleted[i + b] = Source.IsCompleted(i + b) ? 1 : 0;
+        Bits = static_cast<std::uint8_t>(Bits | (LastCompleted[i + b] << b));
+      }
+      Put<std::uint8_t>(Payload, Bits);
+    }
+
+    Put<std::uint8_t>(Payload, static_cast<std::uint8_t>(Resources.GetStorageMode()));
+    const size_t CountAt = Payload.size();
+    Put<std::uint64_t>(Payload, 0);
+    std::uint64_t Stored = 0;
+    std::fill(LastQuantities.begin(), LastQuantities.end(), Absent);
+    Resources.ForEachResource([this, &Stored](ResourceId Resource, size_t Quantity) {
+      if(Resource >= LastQuantities.size()) { LastQuantities.resize(static_cast<size_t>(Resource) + 1, Absent); }
+      LastQuantities[Resource] = Quantity;
+      Put<std::uint32_t>(Payload, NameOf(Resource));
+      Put<std::uint64_t>(Payload, Quantity);
+      Stored++;
+    });
+    std::memcpy(Payload.data() + CountAt, &Stored, sizeof(Stored));
+    WriteNames();
+
+    const std::string Staging = Path + ".tmp";
+    {
+      std::ofstream File(Staging, std::ios::binary | std::ios::trunc);
+      File.write(Magic, sizeof(Magic));
+      File.write(reinterpret_cast<const char*>(&FormatVersion), sizeof(FormatVersion));
+      Append(File, RecordKind::Full);
+    }
+
+    if(Out.is_open()) { Out.close(); }
+    if(std::rename(Staging.c_str(), Path.c_str()) != 0)
+    {
+      HasImage = false;
+      throw std::runtime_error("[PC]Record(...) [Cannot replace the checkpoint]");
+    }
+    Out.open(Path, std::ios::binary | std::ios::app);
+    if(!Out)
+    {
+      HasImage = false;
+      throw std::runtime_error("[PC]Record(...) [Cannot write the checkpoint]");
+    }
+
+    HasImage = true;
+    LastRevision = Source.GetRevision();
+    LastMode = Resources.GetStorageMode();
+    LastRound = Random.ApplyRound;
+    LastStep = Source.GetStep();
+    ImageBytes = Payload.size();
+    DeltaBytes = 0;
+  }
+
+  //[DESC]: Append what changed since the last record
+  //[PARAM]: 'Source' The plan, with the formulas of the last full image
+  //[PARAM]: 'Resources' Its stockpile
+  //[PRE]: The log holds an image of 'Source', whose step did not go back and whose round did not move
+  //[POST]: The log replays to the current state
+  //[NOTE]: Only the formulas of the steps taken since the last record are compared, so a delta costs the
+  //        steps it covers and a pass over the stockpile, not a pass over the whole plan.
+  //[THROW]: 'std::runtime_error' If the file cannot be written
+  void PlanCheckpoint::WriteDelta(const ExecutablePlan& Source, const Stockpile& Resources)
+  {
+    Payload.clear();
+    Put<std::uint64_t>(Payload, Source.GetRandomState().ApplyRound);
+    Put<std::uint32_t>(Payload, Source.GetStep());
+
+    size_t CountAt = Payload.size();
+    std::uint64_t Count = 0;
+    Put<std::uint64_t>(Payload, 0);
+    const size_t First = LastStep;
+    const size_t End = Source.GetStep();
+    for(size_t i = First; i < End; i++)
+    {
+      const Formula& Current = Source.GetFormula(i);
+      unsigned int* Last = LastFormulas.data() + LastOffsets[i];
+      const size_t Outputs = LastOffsets[i + 1] - LastOffsets[i] - 1;
+      if(Last[0] == Current.GetProficiencyLevel() && std::equal(Last + 1, Last + 1 + Outputs, Current.GetResultArray())) { continue; }
+
+      Last[0] = Current.GetProficiencyLevel();
+      std::copy(Current.GetResultArray(), Current.GetResultArray() + Outputs, Last + 1);
+      Put<std::uint64_t>(Payload, i);
+      for(size_t j = 0; j <= Outputs; j++) { Put<unsigned int>(Payload, Last[j]); }
+      Count++;
+    }
+    std::memcpy(Payload.data() + CountAt, &Count, sizeof(Count));
+
+    CountAt = Payload.size();
+    Count = 0;
+    Put<std::uint64_t>(Payload, 0);
+    for(size_t i = First; i < End; i++)
+    {
+      const char Completed = Source.IsCompleted(i) ? 1 : 0;
+      if(Completed == LastCompleted[i]) { continue; }
+      LastCompleted[i] = Completed;
+      Put<std::uint64_t>(Payload, i);
+      Put<std::uint8_t>(Payload, static_cast<std::uint8_t>(Completed));
+      Count++;
+    }
+    std::memcpy(Payload.data() + CountAt, &Count, sizeof(Count));
+
+    CountAt = Payload.size();
+    Count = 0;
+    Put<std::uint64_t>(Payload, 0);
+    Resources.ForEachResource([this, &Count](ResourceId Resource, size_t Quantity) {
+      if(Resource >= LastQuantities.size()) { LastQuantities.resize(static_cast<size_t>(Resource) + 1, Absent); }
+      if(LastQuantities[Resource] == Quantity) { return; }
+      LastQuantities[Resource] = Quantity;
+      Put<std::uint32_t>(Payload, NameOf(Resource));
+      Put<std::uint64_t>(Payload, Quantity);
+      Count++;
+    });
+    std::memcpy(Payload.data() + CountAt, &Count, sizeof(Count));
+    WriteNames();
+
+    Append(Out, RecordKind::Delta);
+    LastRound = Source.GetRandomState().ApplyRound;
+    LastStep = Source.GetStep();
+    DeltaBytes += Payload.size();
+  }
+
+  //[DESC]: Record the current state of a plan and its stockpile
+  //[PARAM]: 'Source' The plan
+  //[PARAM]: 'Resources' Its stockpile
+  //[PRE]: No other thread changes either while the record is written
+  //[POST]: 'Load(Path)' returns this state. A delta is appended; a full image replaces the log the first
+  //        time, when the plan changed shape or storage mode, when its step went back or its round moved
+  //        other than by finishing the run, and once the deltas outgrew the image
+  //[THROW]: 'std::runtime_error' If the file cannot be written
+  void PlanCheckpoint::Record(const ExecutablePlan& Source, const Stockpile& Resources)
+  {
+    //[NOTE]: A run that took the last steps since the previous record and closed its round is still a
+    //        delta, any other round change may have touched formulas outside those steps
+    const std::uint64_t Round = Source.GetRandomState().ApplyRound;
+    const bool Finished = Round == LastRound + 1 && LastStep < Source.GetStep() && Source.GetStep() == Source.GetSize();
+    const bool NeedsImage = !HasImage || Source.GetRevision() != LastRevision || Source.GetSize() + 1 != LastOffsets.size() ||
+                            Source.GetStep() < LastStep || (Round != LastRound && !Finished) ||
+                            Resources.GetStorageMode() != LastMode || DeltaBytes > ImageBytes;
+    if(NeedsImage) { WriteFull(Source, Resources); }
+    else { WriteDelta(Source, Resources); }
+  }
+
+  //[DESC]: Rebuild a plan and its stockpile from a log
+  //[PARAM]: 'Path' The file of the log
+  //[PRE]: None
+  //[POST]: None, the log is only read
+  //[RETURN]: The state of the last good record {[SEE]: PlanCheckpoint.h}
+  //[THROW]: 'std::runtime_error' If the file cannot be read, is not a checkpoint, holds no good full image,
+  //         or a record that passed its checksum does not parse
+  PlanCheckpoint::Restored PlanCheckpoint::Load(const std::string& Path)
+  {
+    std::ifstream File(Path, std::ios::binary);
+    if(!File) { throw std::runtime_error("[PC]Load(...) [Cannot read the checkpoint]"); }
+    const std::vector<char> Bytes((std::istreambuf_iterator<char>(File)), std::istreambuf_iterator<char>());
+
+    constexpr size_t HeaderSize = sizeof(Magic) + sizeof(FormatVersion);
+    std::uint32_t Version = 0;
+    if(Bytes.size() >= HeaderSize) { std::memcpy(&Version, Bytes.data() + sizeof(Magic), sizeof(Version)); }
+    if(Bytes.size() < HeaderSize || std::memcmp(Bytes.data(), Magic, sizeof(Magic)) != 0 || Version != FormatVersion)
+    {
+      throw std::runtime_error("[PC]Load(...) [Not a checkpoint]");
+    }
+
+    Image State;
+    Restored Result;
+    constexpr size_t FrameSize = sizeof(std::uint32_t) + sizeof(std::uint64_t) + sizeof(std::uint32_t);
+    size_t At = HeaderSize;
+    while(Bytes.size() - At >= FrameSize)
+    {
+      std::uint32_t Kind = 0;
+      std::uint64_t Size = 0;
+      std::memcpy(&Kind, Bytes.data() + At, sizeof(Kind));
+      std::memcpy(&Size, Bytes.data() + At + sizeof(Kind), sizeof(Size));
+      if(Size > Bytes.size() - At - FrameSize) { break; }
+
+      const char* Data = Bytes.data() + At + sizeof(Kind) + sizeof(Size);
+      std::uint32_t Sum = 0;
+      std::memcpy(&Sum, Data + Size, sizeof(Sum));
+      if(Sum != Checksum(Data, static_cast<size_t>(Size))) { break; }
+
+      Reader Record{Data, static_cast<size_t>(Size), 0};
+      if(Kind == static_cast<std::uint32_t>(RecordKind::Full)) { State.ReadFull(Record); }
+      else if(Kind == static_cast<std::uint32_t>(RecordKind::Delta) && Result.Records > 0) { State.ReadDelta(Record); }
+      else { throw std::runtime_error("[PC]Load(...) [Malformed record]"); }
+
+      Result.Records++;
+      At += FrameSize + static_cast<size_t>(Size);
+    }
+
+    if(Result.Records == 0) { throw std::runtime_error("[PC]Load(...) [No complete record]"); }
+    State.Build(Result);
+    return Result;
+  }
+}//[NAMESPACE]: ResourceConversion
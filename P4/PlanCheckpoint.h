@@ -0,0 +1,150 @@
+//[FILE]: PlanCheckpoint.h
+//[DESC]: This file defines the 'PlanCheckpoint' class, an append-only binary log of the progress of an
+//        'ExecutablePlan' and its 'Stockpile', so a long run can be resumed after a crash
+//        {[SEE]: ExecutablePlan::PlanApply(..., Log, Interval)}.
+//
+//        The file is a header followed by records. A record is a full image or the changes since the
+//        previous record:
+//
+//          "RCKP" Version
+//          [Kind | PayloadSize | Payload | Checksum]     Full:  names, random state, step, formulas
+//          [Kind | PayloadSize | Payload | Checksum]            (recipe, level, results), completion
+//          ...                                                  bitmap, stockpile
+//                                                        Delta: new names, round, step, formulas whose
+//                                                               level or results changed, newly
+//                                                               completed steps, changed quantities
+//
+//        Resources are written by name (a 'ResourceId' only means something in one process) and
+//        referred to by their index in the name table of the log.
+//
+//        A delta looks at the formulas of the steps taken since the previous record and at the
+//        stockpile, and writes a few bytes per change, so recording every few steps stays cheap. Once
+//        the deltas outgrow the full image, or the plan changed otherwise (its revision moved, its round
+//        moved other than by finishing the run, its step went back), the next record is a full image
+//        written to a new file that replaces the log in one rename, so the log never holds more than
+//        about twice one image.
+//
+//        'Load(...)' replays the records in order. A record cut short or damaged by a crash fails its
+//        checksum; it and everything after it is ignored, the state of the last good record is
+//        returned.
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: After a record, 'Last...' hold exactly what the log replays to, and 'LocalOf' names every
+//             resource the log mentions.
+//
+//[USAGE]
+//{
+// PlanCheckpoint Log("run.ckp");
+// PlanObj.PlanApply(StockpilePtr, Log, 100);                    -> a record every 100 steps
+//
+// PlanCheckpoint::Restored Resumed = PlanCheckpoint::Load("run.ckp");   -> after a crash
+// PlanCheckpoint Continued("run.ckp");
+// Resumed.Plan.PlanApply(Resumed.Resources, Continued, 100);    -> carries on from the last record
+//}
+//
+//[NOTE]: Records are flushed to the operating system, so they survive the process crashing; surviving
+//        a power loss would also need the file synced to disk, which the standard library cannot do.
+//[NOTE]: Between two records a plan is expected to move on only by taking its steps (the checkpointed
+//        'PlanApply(...)' or 'PlanApply()'). A formula changed any other way without touching the
+//        revision or the round (e.g. 'ApplyAt(...)') is only captured by the next full image.
+//[NOTE]: Seeded and counter-based plans resume with exactly the draws the interrupted run would have
+//        made. A 'ThreadLocal' plan has no state to save and draws fresh values after resuming.
+//[NOTE]: Numbers are written in the byte order of the machine, a log is read back on the same kind of
+//        machine.
+//
+//[DEPENDENCIES]:
+//       [INTERNAL]:
+//          - Member, Helper, Utility methods
+//          - Private Data Members
+//
+//        [EXTERNAL]:
+//          - 'ExecutablePlan' class {[SEE]: ExecutablePlan.h}
+//          - 'Stockpile' class {[SEE]: Stockpile.h}
+//          - 'std::ofstream'
+//
+//[NAMESPACE]: {ResourceConversion} Encapsulates the 'Formula', 'Plan', 'ExecutablePlan', 'Stockpile'
+//             and supporting classes.
+#ifndef PlanCheckpoint_h
+#define PlanCheckpoint_h
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ExecutablePlan.h"
+#include "ResourceRegistry.h"
+#include "Stockpile.h"
+
+namespace ResourceConversion
+{
+  class PlanCheckpoint
+  {
+    public:
+    //[DESC]: Outcome of 'Load(...)'
+    //        - 'Plan' and 'Resources' as of the last good record
+    //        - 'Records' the number of records replayed
+    struct Restored
+    {
+      ExecutablePlan Plan = ExecutablePlan();
+      std::shared_ptr<Stockpile> Resources = nullptr;
+      size_t Records = 0;
+    };
+
+    private:
+    enum class RecordKind : std::uint32_t { Full = 1, Delta = 2 };
+
+    static constexpr std::uint32_t Unnamed = 0xFFFFFFFFu;
+    static constexpr size_t Absent = static_cast<size_t>(-1);
+
+    std::string Path = std::string();
+    std::ofstream Out = std::ofstream();
+    std::vector<char> Payload = std::vector<char>();
+
+    //[NOTE]: Name table of the log, by 'ResourceId'; 'NameCount' names were written so far
+    std::vector<std::uint32_t> LocalOf = std::vector<std::uint32_t>();
+    std::uint32_t NameCount = 0;
+    std::vector<ResourceId> NewNames = std::vector<ResourceId>();
+
+    //[NOTE]: What the log replays to. Formula i owns 'LastFormulas[LastOffsets[i] .. LastOffsets[i + 1])':
+    //        its level, then its results.
+    bool HasImage = false;
+    std::uint64_t LastRevision = 0;
+    Stockpile::StorageMode LastMode = Stockpile::StorageMode::Map;
+    std::uint64_t LastRound = 0;
+    unsigned int LastStep = 0;
+    std::vector<size_t> LastOffsets = std::vector<size_t>();
+    std::vector<unsigned int> LastFormulas = std::vector<unsigned int>();
+    std::vector<char> LastCompleted = std::vector<char>();
+    std::vector<size_t> LastQuantities = std::vector<size_t>();
+
+    size_t ImageBytes = 0;
+    size_t DeltaBytes = 0;
+
+    std::uint32_t NameOf(ResourceId Resource);
+    void WriteNames();
+    void WriteFull(const ExecutablePlan& Source, const Stockpile& Resources);
+    void WriteDelta(const ExecutablePlan& Source, const Stockpile& Resources);
+    void Append(std::ofstream& File, RecordKind Kind);
+
+    public:
+    explicit PlanCheckpoint(const std::string& Path_);
+
+    PlanCheckpoint(const PlanCheckpoint& other) = delete;
+    PlanCheckpoint& operator=(const PlanCheckpoint& other) = delete;
+
+    void Record(const ExecutablePlan& Source, const Stockpile& Resources);
+    static Restored Load(const std::string& Path);
+
+    inline const std::string& GetPath() const { return Path; }
+  };
+}//[NAMESPACE]: ResourceConversion
+#endif /*PlanCheckpoint_h*/
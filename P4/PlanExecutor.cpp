@@ -0,0 +1,367 @@
+//[FILE]: PlanExecutor.cpp
+//[DESC]: This file contains the implementation of the 'PlanExecutor' class {[SEE]: PlanExecutor.h}
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//          - 1.1 [16/10/2026] - Jobs that wait for their inputs
+//
+//[INVARIANT]: A worker only sleeps after announcing itself in 'Sleepers' and re-checking 'HasWork(...)'
+//             under 'SleepLock'; 'Enqueue(...)' publishes the job before it looks at 'Sleepers', so a
+//             job is never left behind with every worker asleep.
+//[INVARIANT]: A job parks only after adding itself to 'ParkedCount' and re-checking 'Epoch'; a producing
+//             step moves 'Epoch' before it looks at 'ParkedCount', so a parked job is never left behind
+//             after a production it waited for.
+//[INVARIANT]: 'LotLock' is taken before a lot's 'Lock', a lot's 'Lock' before a worker's 'Lock'.
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "PlanExecutor.h"
+
+namespace ResourceConversion
+{
+  //[DESC]: Default constructor
+  //[PRE]: None
+  //[POST]: An executor with one worker per hardware thread is constructed, the workers are started
+  PlanExecutor::PlanExecutor() : PlanExecutor(0) {}
+
+  //[DESC]: Constructor
+  //[PARAM]: 'Workers_' The number of worker threads, 0 for one per hardware thread
+  //[PRE]: None
+  //[POST]: The workers are started and sleep until the first job arrives
+  PlanExecutor::PlanExecutor(size_t Workers_)
+    : WorkerCount((Workers_ != 0) ? Workers_ : std::max<size_t>(1, std::thread::hardware_concurrency()))
+  {
+    Workers = std::make_unique<Worker[]>(WorkerCount);
+    Threads.reserve(WorkerCount);
+    for(size_t i = 0; i < WorkerCount; i++) { Threads.emplace_back(&PlanExecutor::WorkerMain, this, i); }
+  }
+
+  //[DESC]: Destructor
+  //[PRE]: None
+  //[POST]: Every submitted job finished (futures and callbacks are served), the workers were joined
+  PlanExecutor::~PlanExecutor()
+  {
+    WaitIdle();
+    {
+      std::lock_guard<std::mutex> Guard(SleepLock);
+      Stopping = true;
+    }
+    WorkAvailable.notify_all();
+    for(std::thread& Thread : Threads) { Thread.join(); }
+  }
+
+  //[DESC]: Pick the home worker of a stockpile
+  //[RETURN]: The same worker for every job on 'Target'
+  size_t PlanExecutor::HomeOf(const Stockpile* Target) const
+  {
+    const std::uint64_t Address = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(Target));
+    return static_cast<size_t>(((Address >> 4) * 0x9E3779B97F4A7C15ULL) >> 32) % WorkerCount;
+  }
+
+  //[DESC]: Put a job at the end of a worker's deque and wake sleeping workers
+  //[PARAM]: 'Self' The worker whose deque receives the job
+  //[POST]: The job is visible to its owner, and to thieves unless it is pinned
+  void PlanExecutor::Enqueue(size_t Self, Job* Task)
+  {
+    {
+      std::lock_guard<std::mutex> Guard(Workers[Self].Lock);
+      (Task -> Pinned ? Workers[Self].Pinned : Workers[Self].Shared).push_back(Task);
+    }
+    (Task -> Pinned ? Workers[Self].PinnedCount : SharedCount).fetch_add(1);
+
+    if(Sleepers.load() != 0)
+    {
+      std::lock_guard<std::mutex> Guard(SleepLock);
+      WorkAvailable.notify_all();
+    }
+  }
+
+  //[DESC]: Take the oldest job of the worker's own deques, pinned jobs first
+  //[RETURN]: The job, 'nullptr' if both deques are empty
+  PlanExecutor::Job* PlanExecutor::Pop(size_t Self)
+  {
+    Worker& Own = Workers[Self];
+    std::lock_guard<std::mutex> Guard(Own.Lock);
+
+    std::deque<Job*>& Source = !Own.Pinned.empty() ? Own.Pinned : Own.Shared;
+    if(Source.empty()) { return nullptr; }
+
+    Job* Task = Source.front();
+    Source.pop_front();
+    (Task -> Pinned ? Own.PinnedCount : SharedCount).fetch_sub(1);
+    return Task;
+  }
+
+  //[DESC]: Take the newest shared job of another worker, visiting the others round-robin
+  //[RETURN]: The job, 'nullptr' if no other worker has a shared job
+  PlanExecutor::Job* PlanExecutor::Steal(size_t Self)
+  {
+    for(size_t Offset = 1; Offset < WorkerCount; Offset++)
+    {
+      Worker& Victim = Workers[(Self + Offset) % WorkerCount];
+      std::lock_guard<std::mutex> Guard(Victim.Lock);
+      if(Victim.Shared.empty()) { continue; }
+
+      Job* Task = Victim.Shared.back();
+      Victim.Shared.pop_back();
+      SharedCount.fetch_sub(1);
+      return Task;
+    }
+    return nullptr;
+  }
+
+  //[DESC]: Check whether a worker could find a job right now
+  //[RETURN]: True if some worker holds a shared job or this worker holds a pinned one
+  bool PlanExecutor::HasWork(size_t Self) const
+  {
+    return SharedCount.load() != 0 || Workers[Self].PinnedCount.load() != 0;
+  }
+
+  //[DESC]: Block until there is work for this worker or the executor stops
+  //[RETURN]: False if the worker should exit
+  bool PlanExecutor::Sleep(size_t Self)
+  {
+    Sleepers.fetch_add(1);
+    std::unique_lock<std::mutex> Guard(SleepLock);
+    WorkAvailable.wait(Guard, [this, Self]() { return Stopping || HasWork(Self); });
+    Sleepers.fetch_sub(1);
+    return !Stopping || HasWork(Self);
+  }
+
+  //[DESC]: Run steps of a job, as many as possible while no other job waits on this worker
+  //[POST]: The job finished, is parked, or it is back at the end of this worker's deque
+  void PlanExecutor::RunStep(size_t Self, Job* Task)
+  {
+    Lot& Parking = *Task -> Parking;
+    while(true)
+    {
+      const std::uint64_t Seen = Parking.Epoch.load();
+      bool Ran = false;
+      try
+      {
+        Ran = Task -> Plan -> ApplyStepTo(Task -> NextStep, *Task -> Target);
+      }
+      catch(...)
+      {
+        Finish(Task, std::current_exception());
+        return;
+      }
+
+      if(Ran)
+      {
+        Parking.Epoch.fetch_add(1);
+        if(Parking.ParkedCount.load() != 0) { Wake(Parking); }
+      }
+      else if(Task -> Policy == InputPolicy::Wait)
+      {
+        const ParkResult Result = Park(Task, Seen);
+        if(Result == ParkResult::Parked) { return; }
+        if(Result == ParkResult::Retry) { continue; }
+      }
+
+      if(++Task -> NextStep == Task -> Plan -> GetSize())
+      {
+        Task -> Plan -> FinishApplyRound();
+        Finish(Task, nullptr);
+        return;
+      }
+
+      bool OthersWaiting = false;
+      {
+        std::lock_guard<std::mutex> Guard(Workers[Self].Lock);
+        OthersWaiting = !Workers[Self].Pinned.empty() || !Workers[Self].Shared.empty();
+      }
+      if(OthersWaiting)
+      {
+        Enqueue(Self, Task);
+        return;
+      }
+    }
+  }
+
+  //[DESC]: Park a job whose next step found its inputs short
+  //[PARAM]: 'Seen' The 'Epoch' of the lot read before the step was tried
+  //[RETURN]: 'Parked' if the job now waits in its lot, 'Retry' if something was produced meanwhile, 'Skip'
+  //          if 'WaitIdle()' runs and every other job on the stockpile is parked too (nothing could
+  //          ever wake it)
+  PlanExecutor::ParkResult PlanExecutor::Park(Job* Task, std::uint64_t Seen)
+  {
+    Lot& Parking = *Task -> Parking;
+    std::lock_guard<std::mutex> Guard(Parking.Lock);
+
+    const size_t Parked = Parking.ParkedCount.fetch_add(1) + 1;
+    if(Parking.Epoch.load() != Seen)
+    {
+      Parking.ParkedCount.fetch_sub(1);
+      return ParkResult::Retry;
+    }
+    if(Parked == Parking.Users && Draining.load() != 0)
+    {
+      Parking.ParkedCount.fetch_sub(1);
+      return ParkResult::Skip;
+    }
+    Parking.Parked.push_back(Task);
+    return ParkResult::Parked;
+  }
+
+  //[DESC]: Put every job parked in a lot back on the home worker of its stockpile
+  //[POST]: The lot is empty, the jobs retry their step
+  void PlanExecutor::Wake(Lot& Parking)
+  {
+    std::lock_guard<std::mutex> Guard(Parking.Lock);
+    for(Job* Task : Parking.Parked) { Enqueue(HomeOf(Task -> Target.get()), Task); }
+    Parking.Parked.clear();
+    Parking.ParkedCount.store(0);
+  }
+
+  //[DESC]: Drop a finished job from the lot of its stockpile
+  //[POST]: The lot is gone if it has no users left. If only parked jobs are left while 'WaitIdle()' runs,
+  //        they are woken so the last of them can skip its step.
+  void PlanExecutor::Release(Job* Task)
+  {
+    std::lock_guard<std::mutex> Guard(LotLock);
+    Lot& Parking = *Task -> Parking;
+    bool Stalled = false;
+    {
+      std::lock_guard<std::mutex> LotGuard(Parking.Lock);
+      Parking.Users--;
+      Stalled = (Parking.Users != 0 && Parking.Users == Parking.ParkedCount.load() && Draining.load() != 0);
+    }
+
+    if(Parking.Users == 0) { Lots.erase(Task -> Target.get()); }
+    else if(Stalled) { Wake(Parking); }
+  }
+
+  //[DESC]: Report the end of a job and release it
+  //[PARAM]: 'Error' The exception a step threw, 'nullptr' on success
+  //[POST]: The callback ran or the future is ready, 'WaitIdle()' callers are woken after the last job
+  void PlanExecutor::Finish(Job* Task, std::exception_ptr Error)
+  {
+    if(Task -> Parking != nullptr) { Release(Task); }
+    if(Task -> Done != nullptr) { Task -> Done(Task -> Target, Error); }
+    else if(Error != nullptr) { Task -> Promise.set_exception(Error); }
+    else { Task -> Promise.set_value(Task -> Target); }
+    delete Task;
+
+    if(InFlight.fetch_sub(1) == 1)
+    {
+      std::lock_guard<std::mutex> Guard(SleepLock);
+      AllDone.notify_all();
+    }
+  }
+
+  //[DESC]: Body of a worker thread
+  //[PARAM]: 'Self' The index of the worker
+  void PlanExecutor::WorkerMain(size_t Self)
+  {
+    while(true)
+    {
+      Job* Task = Pop(Self);
+      if(Task == nullptr) { Task = Steal(Self); }
+
+      if(Task != nullptr) { RunStep(Self, Task); }
+      else if(!Sleep(Self)) { return; }
+    }
+  }
+
+  //[DESC]: Fill in a new job and hand it to the home worker of its stockpile
+  //[PRE]: The caller already took the future of 'Task', if it needs one
+  //[THROW]: 'std::invalid_argument' If 'Target' is null, 'Task' is released in that case
+  void PlanExecutor::Start(ExecutablePlan& Plan, std::shared_ptr<Stockpile>&& Target, InputPolicy Policy, Job* Task)
+  {
+    if(Target == nullptr)
+    {
+      delete Task;
+      throw std::invalid_argument("[PE]Submit(...) [Target must not be NULL]");
+    }
+
+    const Stockpile::StorageMode Mode = Target -> GetStorageMode();
+    Task -> Plan = &Plan;
+    Task -> Pinned = (Mode == Stockpile::StorageMode::Map || Mode == Stockpile::StorageMode::Dense);
+    Task -> Policy = Policy;
+    Task -> Target = std::move(Target);
+    InFlight.fetch_add(1);
+
+    if(Plan.GetSize() == 0)
+    {
+      Plan.FinishApplyRound();
+      Finish(Task, nullptr);
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> Guard(LotLock);
+      Lot& Parking = Lots.try_emplace(Task -> Target.get()).first -> second;
+      std::lock_guard<std::mutex> LotGuard(Parking.Lock);
+      Parking.Users++;
+      Task -> Parking = &Parking;
+    }
+    Enqueue(HomeOf(Task -> Target.get()), Task);
+  }
+
+  //[DESC]: Apply a plan to a stockpile on the executor
+  //[PARAM]: 'Plan' The plan, it must stay alive and untouched until the job finished
+  //[PARAM]: 'Target' The stockpile
+  //[PARAM]: 'Policy' Whether a step with short inputs is skipped or waits for them {[SEE]: InputPolicy}
+  //[PRE]: 'Plan' is not part of another unfinished job
+  //[POST]: The job is queued, its steps run in plan order. With 'InputPolicy::Skip' this is exactly
+  //        'Plan.PlanApply(Target)'.
+  //[THROW]: 'std::invalid_argument' If 'Target' is null
+  //[RETURN]: Becomes ready with 'Target' when every step ran, or with the exception a step threw
+  std::future<std::shared_ptr<Stockpile>> PlanExecutor::Submit(ExecutablePlan& Plan, std::shared_ptr<Stockpile> Target, InputPolicy Policy)
+  {
+    Job* Task = new Job();
+    std::future<std::shared_ptr<Stockpile>> Result = Task -> Promise.get_future();
+    Start(Plan, std::move(Target), Policy, Task);
+    return Result;
+  }
+
+  //[DESC]: Apply a plan to a stockpile on the executor and call back when it is done
+  //[PARAM]: 'Done' Called once on a worker thread with 'Target' and the exception a step threw ('nullptr'
+  //         on success). It must not throw.
+  //[PRE]: {[SEE]: Submit(Plan, Target, Policy)}
+  //[POST]: The job is queued
+  //[THROW]: 'std::invalid_argument' If 'Target' is null
+  void PlanExecutor::Submit(ExecutablePlan& Plan, std::shared_ptr<Stockpile> Target, Callback Done, InputPolicy Policy)
+  {
+    Job* Task = new Job();
+    Task -> Done = std::move(Done);
+    Start(Plan, std::move(Target), Policy, Task);
+  }
+
+  //[DESC]: Wait until every submitted job finished
+  //[PRE]: Not called from a callback
+  //[POST]: No job is queued, running or parked (jobs submitted by other threads meanwhile included)
+  //[NOTE]: Parked jobs whose stockpile has no running job left are woken, so they skip the steps they
+  //        wait for {[SEE]: Park(...)}
+  void PlanExecutor::WaitIdle()
+  {
+    Draining.fetch_add(1);
+    {
+      std::lock_guard<std::mutex> Guard(LotLock);
+      for(auto& Entry : Lots)
+      {
+        Lot& Parking = Entry.second;
+        bool Stalled = false;
+        {
+          std::lock_guard<std::mutex> LotGuard(Parking.Lock);
+          Stalled = (Parking.Users == Parking.ParkedCount.load());
+        }
+        if(Stalled) { Wake(Parking); }
+      }
+    }
+
+    {
+      std::unique_lock<std::mutex> Guard(SleepLock);
+      AllDone.wait(Guard, [this]() { return InFlight.load() == 0; });
+    }
+    Draining.fetch_sub(1);
+  }
+}//[NAMESPACE]: ResourceConversion
@@ -0,0 +1,197 @@
+//[FILE]: PlanExecutor.h
+//[DESC]: This file defines the 'PlanExecutor' class, a long-lived set of worker threads that applies
+//        many 'ExecutablePlan's to their stockpiles at the same time. Every submitted plan becomes a
+//        job; a job is scheduled one step at a time, so thousands of plans share the cores fairly and
+//        a long plan never blocks a worker for its whole length.
+//
+//        Each worker owns two deques:
+//          - Shared: jobs on a thread-safe stockpile ('Concurrent', 'Sharded', 'Versioned'). The
+//            owner takes its jobs round-robin, idle workers steal the newest one.
+//          - Pinned: jobs on a 'Map' or 'Dense' stockpile. Only the owner runs them.
+//
+//        A worker keeps running the steps of one job as long as nothing else waits in its deques, and
+//        puts the job back at the end of its deque after each step otherwise. Scheduling a step then
+//        costs one uncontended lock; sleeping workers are only woken when a job becomes available.
+//
+//        A job starts on the home worker of its stockpile (affinity: plans sharing a stockpile run
+//        where its data is already in cache). Jobs on a 'Map' or 'Dense' stockpile never leave their
+//        home worker, so every step on such a stockpile runs on one thread and needs no locking.
+//
+//        Completion is reported through a 'std::future' or a callback.
+//
+//        A plan submitted with 'InputPolicy::Wait' does not skip a step whose inputs are short: the job
+//        parks on its stockpile and is put back in a deque as soon as another job produces into that
+//        stockpile, then retries the step. A parked job holds no thread, so any number of plans can
+//        wait on each other while the workers keep running the rest. When every job on a stockpile is
+//        parked while 'WaitIdle()' runs (no more jobs will come), nothing can produce anything more; the
+//        last one to park skips its step instead, exactly like 'PlanApply(...)' would, so 'WaitIdle()'
+//        and the destructor always return.
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//          - 1.1 [16/10/2026] - Jobs that wait for their inputs {[SEE]: InputPolicy}
+//
+//[INVARIANT]: A job is in at most one deque at a time, so the steps of one plan always run in order.
+//[INVARIANT]: 'SharedCount' and 'PinnedCount' count the jobs sitting in the deques, 'InFlight' the
+//             submitted jobs that did not finish yet.
+//[INVARIANT]: A job is either in a deque, running, or parked in the 'Lot' of its stockpile. A lot lives
+//             while unfinished jobs use its stockpile, 'Users' counts them.
+//
+//[USAGE]
+//{
+// PlanExecutor Executor;                                             -> one worker per hardware thread
+//
+// std::future<std::shared_ptr<Stockpile>> Done = Executor.Submit(PlanObj, StockpilePtr);
+// Executor.Submit(OtherPlan, StockpilePtr, [](const std::shared_ptr<Stockpile>& Result, std::exception_ptr Error) { ... });
+// Executor.Submit(Consumer, StockpilePtr, PlanExecutor::InputPolicy::Wait);  -> waits for 'Producer'
+// Executor.Submit(Producer, StockpilePtr);
+//
+// Done.get();                                                        -> rethrows what a step threw
+// Executor.WaitIdle();                                               -> every job finished
+//}
+//
+//[NOTE]: A plan keeps per-formula state while it is applied, so one 'ExecutablePlan' must not be part of
+//        two unfinished jobs. Plans and stockpiles must outlive their jobs (stockpiles are held by
+//        'std::shared_ptr').
+//[NOTE]: Callbacks run on a worker thread and must not throw.
+//[NOTE]: Only jobs of this executor wake parked jobs; deposits made by other threads are seen when
+//        the next step on the stockpile runs. A future of a job that waits for inputs nobody produces
+//        only becomes ready once 'WaitIdle()' is called.
+//
+//[DEPENDENCIES]:
+//       [INTERNAL]:
+//          - Member, Helper, Utility methods
+//          - Private Data Members
+//
+//        [EXTERNAL]:
+//          - 'ExecutablePlan' class {[SEE]: ExecutablePlan.h}
+//          - 'Stockpile' class {[SEE]: Stockpile.h}
+//          - 'std::thread', 'std::future', 'std::condition_variable'
+//
+//[NAMESPACE]: {ResourceConversion} Encapsulates the 'Formula', 'Plan', 'ExecutablePlan', 'Stockpile'
+//             and supporting classes.
+#ifndef PlanExecutor_h
+#define PlanExecutor_h
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "ExecutablePlan.h"
+#include "Stockpile.h"
+
+namespace ResourceConversion
+{
+  class PlanExecutor
+  {
+    public:
+    using Callback = std::function<void(const std::shared_ptr<Stockpile>& Result, std::exception_ptr Error)>;
+
+    //[DESC]: What a job does when the inputs of its next step are short
+    //          - Skip: the step does nothing, as in 'ExecutablePlan::PlanApply(...)'
+    //          - Wait: the job parks until another job produced into the stockpile, then retries
+    enum class InputPolicy { Skip, Wait };
+
+    private:
+    struct Lot;
+
+    //[DESC]: One submitted plan and how far it got
+    struct Job
+    {
+      ExecutablePlan* Plan = nullptr;
+      std::shared_ptr<Stockpile> Target = nullptr;
+      size_t NextStep = 0;
+      bool Pinned = false;
+      InputPolicy Policy = InputPolicy::Skip;
+      Lot* Parking = nullptr;
+      std::promise<std::shared_ptr<Stockpile>> Promise = std::promise<std::shared_ptr<Stockpile>>();
+      Callback Done = nullptr;
+    };
+
+    //[NOTE]: One cache line per worker, so two workers never write to the same line when scheduling
+    struct alignas(64) Worker
+    {
+      std::mutex Lock;
+      std::deque<Job*> Shared;
+      std::deque<Job*> Pinned;
+      std::atomic<size_t> PinnedCount;
+      Worker() : Lock(), Shared(), Pinned(), PinnedCount(0) {}
+    };
+
+    //[DESC]: The jobs parked on one stockpile
+    //[NOTE]: 'Epoch' counts the steps that produced into the stockpile. A job reads it before trying a
+    //        step and only parks if it did not move, so a production is never missed.
+    struct Lot
+    {
+      std::mutex Lock;
+      std::vector<Job*> Parked;
+      std::atomic<size_t> ParkedCount;
+      std::atomic<std::uint64_t> Epoch;
+      size_t Users;
+      Lot() : Lock(), Parked(), ParkedCount(0), Epoch(0), Users(0) {}
+    };
+
+    enum class ParkResult { Parked, Retry, Skip };
+
+    std::vector<std::thread> Threads = std::vector<std::thread>();
+    std::unique_ptr<Worker[]> Workers = nullptr;
+    size_t WorkerCount = 1;
+
+    std::atomic<size_t> SharedCount{0};
+    std::atomic<size_t> Sleepers{0};
+    std::atomic<size_t> InFlight{0};
+    std::mutex SleepLock{};
+    std::condition_variable WorkAvailable{};
+    std::condition_variable AllDone{};
+    bool Stopping = false;
+
+    std::atomic<size_t> Draining{0};
+    std::mutex LotLock{};
+    std::unordered_map<const Stockpile*, Lot> Lots = std::unordered_map<const Stockpile*, Lot>();
+
+    size_t HomeOf(const Stockpile* Target) const;
+    void Enqueue(size_t Self, Job* Task);
+    Job* Pop(size_t Self);
+    Job* Steal(size_t Self);
+    bool HasWork(size_t Self) const;
+    bool Sleep(size_t Self);
+    void RunStep(size_t Self, Job* Task);
+    ParkResult Park(Job* Task, std::uint64_t Seen);
+    void Wake(Lot& Parking);
+    void Release(Job* Task);
+    void Finish(Job* Task, std::exception_ptr Error);
+    void WorkerMain(size_t Self);
+    void Start(ExecutablePlan& Plan, std::shared_ptr<Stockpile>&& Target, InputPolicy Policy, Job* Task);
+
+    public:
+    PlanExecutor();
+    explicit PlanExecutor(size_t Workers_);
+    ~PlanExecutor();
+
+    PlanExecutor(const PlanExecutor& other) = delete;
+    PlanExecutor& operator=(const PlanExecutor& other) = delete;
+    PlanExecutor(PlanExecutor&& other) = delete;
+    PlanExecutor& operator=(PlanExecutor&& other) = delete;
+
+    std::future<std::shared_ptr<Stockpile>> Submit(ExecutablePlan& Plan, std::shared_ptr<Stockpile> Target, InputPolicy Policy = InputPolicy::Skip);
+    void Submit(ExecutablePlan& Plan, std::shared_ptr<Stockpile> Target, Callback Done, InputPolicy Policy = InputPolicy::Skip);
+    void WaitIdle();
+
+    inline size_t GetWorkerCount() const { return WorkerCount; }
+  };
+}//[NAMESPACE]: ResourceConversion
+#endif /*PlanExecutor_h*/
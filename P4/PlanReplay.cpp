@@ -0,0 +1,327 @@
+//[FILE]: PlanReplay.cpp
+//[DESC]: This file contains the implementation of the 'PlanReplay' class {[SEE]: PlanReplay.h}
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: During a walk, 'Diff[r]' is the change of register r made by the edit and the steps visited
+//             so far. Steps are visited in increasing order, so it is the change right before the
+//             step being visited. 'Changed' counts the registers whose 'Diff' is not zero.
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "PlanReplay.h"
+
+namespace ResourceConversion
+{
+  namespace
+  {
+    constexpr std::uint32_t Unassigned = std::numeric_limits<std::uint32_t>::max();
+
+    //[NOTE]: What a step that runs does to one of its resources
+    inline std::int64_t NetChange(unsigned int In, unsigned int Out)
+    {
+      return static_cast<std::int64_t>(Out) - static_cast<std::int64_t>(In);
+    }
+
+    inline size_t Shift(size_t Quantity, std::int64_t Amount)
+    {
+      return Quantity + static_cast<size_t>(Amount);
+    }
+  }
+
+  //[DESC]: Constructor, replays one trial of a plan
+  //[PARAM]: 'Source_' The plan, it must stay alive as long as the replay
+  //[PARAM]: 'Start' The initial stockpile, it is only read here
+  //[PARAM]: 'Trial_' The trial to replay {[SEE]: Plan::EvaluateAt(...)}
+  //[PRE]: None
+  //[POST]: The replay holds the outcome of every step and the final quantities of the trial
+  //[THROW]: 'std::logic_error' If the plan is not counter-based
+  PlanReplay::PlanReplay(ExecutablePlan& Source_, const Stockpile& Start, std::uint32_t Trial_) : Source(Source_), Trial(Trial_)
+  {
+    if(Source.GetRandomMode() != Plan::RandomMode::CounterBased)
+    {
+      throw std::logic_error("[PR]PlanReplay(...) [Plan is not counter-based]");
+    }
+
+    Start.ForEachResource([this](ResourceId Resource, size_t Quantity) {
+      Initial[Resolve(Resource)] = Quantity;
+    });
+    Rebuild();
+  }
+
+  //[DESC]: Number a resource with a register
+  //[PARAM]: 'Resource' The resource
+  //[PRE]: None
+  //[POST]: 'Resource' has a register, a new one starts and ends at 0 and no step touches it
+  //[RETURN]: The register
+  std::uint32_t PlanReplay::Resolve(ResourceId Resource)
+  {
+    if(Resource >= RegisterOf.size()) { RegisterOf.resize(static_cast<size_t>(Resource) + 1, Unassigned); }
+    if(RegisterOf[Resource] == Unassigned)
+    {
+      RegisterOf[Resource] = static_cast<std::uint32_t>(Resources.size());
+      Resources.push_back(Resource);
+      Initial.push_back(0);
+      Final.push_back(0);
+      Touchers.emplace_back();
+      Diff.push_back(0);
+    }
+    return RegisterOf[Resource];
+  }
+
+  //[DESC]: Describe one step of the trial
+  //[PARAM]: 'Index' The step
+  //[PARAM]: 'Slots' Receives one slot per distinct resource, 'Before' is left at 0
+  //[PRE]: 'Index' < 'Source.GetSize()'
+  //[POST]: The outcome of the step is drawn {[SEE]: Plan::EvaluateAt(...)}, the plan is unchanged
+  void PlanReplay::Describe(size_t Index, std::vector<Slot>& Slots)
+  {
+    const Formula::ResourceView Recipe = Source.GetFormula(Index).GetView();
+    Produced.resize(Recipe.OutputResources.size());
+    Source.EvaluateAt(Index, Trial, Produced.data());
+
+    Slots.clear();
+    auto SlotOf = [this, &Slots](ResourceId Resource) -> Slot& {
+      const std::uint32_t Register = Resolve(Resource);
+      for(Slot& Existing : Slots)
+      {
+        if(Existing.Register == Register) { return Existing; }
+      }
+      Slots.push_back(Slot{Register, 0, 0, 0});
+      return Slots.back();
+    };
+
+    for(size_t j = 0; j < Recipe.InputResources.size(); j++) { SlotOf(Recipe.InputResources[j]).In += Recipe.InputQuantities[j]; }
+    for(size_t j = 0; j < Recipe.OutputResources.size(); j++) { SlotOf(Recipe.OutputResources[j]).Out += Produced[j]; }
+  }
+
+  //[DESC]: Replay the whole trial from the initial quantities
+  //[PRE]: None
+  //[POST]: Every step is described again and run in order, as 'MonteCarloSimulator' runs a trial
+  //[THROW]: 'std::logic_error' If the plan is no longer counter-based
+  void PlanReplay::Rebuild()
+  {
+    Revision = Source.GetRevision();
+    Steps.resize(Source.GetSize());
+    Ran.assign(Source.GetSize(), 0);
+    for(std::vector<std::uint32_t>& List : Touchers) { List.clear(); }
+
+    Final.assign(Initial.begin(), Initial.end());
+    for(size_t i = 0; i < Steps.size(); i++)
+    {
+      Describe(i, Steps[i]);
+      Final.resize(Initial.size(), 0);
+
+      bool Runs = true;
+      for(Slot& Current : Steps[i])
+      {
+        Current.Before = Final[Current.Register];
+        Touchers[Current.Register].push_back(static_cast<std::uint32_t>(i));
+        Runs = Runs && Current.Before >= Current.In;
+      }
+      if(!Runs) { continue; }
+
+      Ran[i] = 1;
+      for(const Slot& Current : Steps[i])
+      {
+        Final[Current.Register] = Shift(Final[Current.Register], NetChange(Current.In, Current.Out));
+      }
+    }
+  }
+
+  //[DESC]: The quantity of a register right before a step, from the cached steps
+  //[PARAM]: 'Register' The register
+  //[PARAM]: 'Index' The step, it must not touch 'Register'
+  //[PRE]: No walk is in progress
+  //[POST]: None
+  //[RETURN]: The quantity after the last earlier step touching 'Register', or its initial quantity
+  size_t PlanReplay::ValueBefore(std::uint32_t Register, size_t Index) const
+  {
+    const std::vector<std::uint32_t>& List = Touchers[Register];
+    auto Next = std::lower_bound(List.begin(), List.end(), static_cast<std::uint32_t>(Index));
+    if(Next == List.begin()) { return Initial[Register]; }
+
+    const std::uint32_t Previous = *(Next - 1);
+    for(const Slot& Current : Steps[Previous])
+    {
+      if(Current.Register != Register) { continue; }
+      return Ran[Previous] ? Shift(Current.Before, NetChange(Current.In, Current.Out)) : Current.Before;
+    }
+    return Initial[Register];
+  }
+
+  //[DESC]: Record a change of a register at the current point of the walk
+  //[PARAM]: 'Register' The register
+  //[PARAM]: 'Amount' The change
+  //[PRE]: None
+  //[POST]: 'Final' and 'Diff' of 'Register' moved by 'Amount'
+  void PlanReplay::Change(std::uint32_t Register, std::int64_t Amount)
+  {
+    if(Amount == 0) { return; }
+    if(Diff[Register] == 0)
+    {
+      Dirty.push_back(Register);
+      ++Changed;
+    }
+    Diff[Register] += Amount;
+    if(Diff[Register] == 0) { --Changed; }
+    Final[Register] = Shift(Final[Register], Amount);
+  }
+
+  //[DESC]: Walk forward through the steps affected by the changes in 'Diff'
+  //[PARAM]: 'FirstStep' The first step after the edit
+  //[PRE]: 'Diff' holds the changes the edit made before 'FirstStep'
+  //[POST]: Every cached step and 'Final' match a full replay; 'Diff' is zero again
+  //[NOTE]: The walk stops as soon as no register differs any more. A step none of whose registers
+  //        changed is passed over after a look at its slots; a visited step adds the changes to its
+  //        cached quantities and only does more if it flips.
+  void PlanReplay::Propagate(size_t FirstStep)
+  {
+    for(size_t Index = FirstStep; Index < Steps.size() && Changed > 0; Index++)
+    {
+      std::vector<Slot>& Slots = Steps[Index];
+      bool Affected = false;
+      for(const Slot& Current : Slots) { Affected = Affected || Diff[Current.Register] != 0; }
+      if(!Affected) { continue; }
+
+      bool Runs = true;
+      for(Slot& Current : Slots)
+      {
+        Current.Before = Shift(Current.Before, Diff[Current.Register]);
+        Runs = Runs && Current.Before >= Current.In;
+      }
+      if(Runs == static_cast<bool>(Ran[Index])) { continue; }
+
+      Ran[Index] = Runs ? 1 : 0;
+      for(const Slot& Current : Slots)
+      {
+        const std::int64_t Net = NetChange(Current.In, Current.Out);
+        Change(Current.Register, Runs ? Net : -Net);
+      }
+    }
+
+    for(std::uint32_t Register : Dirty) { Diff[Register] = 0; }
+    Dirty.clear();
+    Changed = 0;
+  }
+
+  //[DESC]: Rebuild if the plan changed behind the replay's back
+  //[PRE]: None
+  //[POST]: The cached steps describe the current plan
+  void PlanReplay::Sync()
+  {
+    if(Revision != Source.GetRevision() || Steps.size() != Source.GetSize()) { Rebuild(); }
+  }
+
+  //[DESC]: Replace a step of the plan and update the trial
+  //[PARAM]: 'NewFormula' The new formula
+  //[PARAM]: 'Index' The step
+  //[PRE]: None
+  //[POST]: The plan holds 'NewFormula' at 'Index' {[SEE]: ExecutablePlan::ReplaceFormula(...)} and the
+  //        replay matches a full replay of the changed plan. Only the steps affected are revisited
+  //[THROW]: {[SEE]: ExecutablePlan::ReplaceFormula(...)}, the replay is unchanged in that case
+  void PlanReplay::ReplaceFormula(const Formula& NewFormula, size_t Index)
+  {
+    Sync();
+    Source.ReplaceFormula(NewFormula, Index);
+    Revision = Source.GetRevision();
+
+    std::vector<Slot>& Slots = Steps[Index];
+    if(Ran[Index])
+    {
+      for(const Slot& Current : Slots) { Change(Current.Register, -NetChange(Current.In, Current.Out)); }
+    }
+
+    Describe(Index, Scratch);
+    const std::uint32_t Step = static_cast<std::uint32_t>(Index);
+    bool Runs = true;
+    for(Slot& Current : Scratch)
+    {
+      auto Old = std::find_if(Slots.begin(), Slots.end(), [&Current](const Slot& Other) { return Other.Register == Current.Register; });
+      if(Old != Slots.end()) { Current.Before = Old -> Before; }
+      else
+      {
+        Current.Before = ValueBefore(Current.Register, Index);
+        std::vector<std::uint32_t>& List = Touchers[Current.Register];
+        List.insert(std::lower_bound(List.begin(), List.end(), Step), Step);
+      }
+      Runs = Runs && Current.Before >= Current.In;
+    }
+    for(const Slot& Current : Slots)
+    {
+      auto New = std::find_if(Scratch.begin(), Scratch.end(), [&Current](const Slot& Other) { return Other.Register == Current.Register; });
+      if(New != Scratch.end()) { continue; }
+      std::vector<std::uint32_t>& List = Touchers[Current.Register];
+      List.erase(std::lower_bound(List.begin(), List.end(), Step));
+    }
+
+    Slots.swap(Scratch);
+    Ran[Index] = Runs ? 1 : 0;
+    if(Runs)
+    {
+      for(const Slot& Current : Slots) { Change(Current.Register, NetChange(Current.In, Current.Out)); }
+    }
+
+    Propagate(Index + 1);
+  }
+
+  //[DESC]: Change the initial quantity of a resource and update the trial
+  //[PARAM]: 'Resource' The resource
+  //[PARAM]: 'Quantity' Its new initial quantity
+  //[PRE]: None
+  //[POST]: The replay matches a full replay from the changed initial quantities. Only the steps affected
+  //        are revisited
+  void PlanReplay::SetInitialQuantity(ResourceId Resource, size_t Quantity)
+  {
+    Sync();
+    const std::uint32_t Register = Resolve(Resource);
+    const std::int64_t Amount = static_cast<std::int64_t>(Quantity - Initial[Register]);
+    Initial[Register] = Quantity;
+
+    Change(Register, Amount);
+    Propagate(0);
+  }
+
+  //[DESC]: Change the initial quantity of a resource by name {[SEE]: SetInitialQuantity(ResourceId, ...)}
+  void PlanReplay::SetInitialQuantity(const std::string& Resource, size_t Quantity)
+  {
+    SetInitialQuantity(ResourceRegistry::Instance().Intern(Resource), Quantity);
+  }
+
+  //[DESC]: The final quantity of a resource in the trial
+  //[PARAM]: 'Resource' The resource
+  //[PRE]: None
+  //[POST]: None
+  //[RETURN]: The quantity, 0 for a resource neither the plan nor the initial stockpile mention
+  size_t PlanReplay::GetQuantity(ResourceId Resource) const
+  {
+    if(Resource >= RegisterOf.size() || RegisterOf[Resource] == Unassigned) { return 0; }
+    return Final[RegisterOf[Resource]];
+  }
+
+  //[DESC]: The final quantity of a resource by name {[SEE]: GetQuantity(ResourceId)}
+  size_t PlanReplay::GetQuantity(const std::string& Resource) const
+  {
+    const std::optional<ResourceId> Id = ResourceRegistry::Instance().Find(Resource);
+    return Id.has_value() ? GetQuantity(*Id) : 0;
+  }
+
+  //[DESC]: Whether a step ran in the trial
+  //[PARAM]: 'Index' The step
+  //[PRE]: None
+  //[POST]: None
+  //[RETURN]: 'true' if its inputs were there, 'false' if it was skipped
+  //[THROW]: 'std::out_of_range' If 'Index' is out of range
+  bool PlanReplay::StepRan(size_t Index) const
+  {
+    if(Index >= Ran.size()) { throw std::out_of_range("[PR]StepRan(...) [Index out of range]"); }
+    return Ran[Index] != 0;
+  }
+}//[NAMESPACE]: ResourceConversion
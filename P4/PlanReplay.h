@@ -0,0 +1,133 @@
+//[FILE]: PlanReplay.h
+//[DESC]: This file defines the 'PlanReplay' class, a what-if view of one trial of a counter-based
+//        'ExecutablePlan'. It holds the final stockpile of the trial and keeps it up to date while
+//        steps are replaced or initial quantities change, without running the plan again.
+//
+//        The trial is the one 'MonteCarloSimulator' runs: step i draws from
+//        'Philox4x32(Seed, PlanId, i, Trial)', so its outcome is fixed once the step is known, and the
+//        step either runs (its inputs were there) or is skipped. For every step the replay keeps
+//        what it read and what it changed:
+//
+//          Step 7   Iron  Before 12  In 2  Out 0      Ran -> Iron -2, Steel +3
+//                   Steel Before  0  In 0  Out 3
+//
+//        An edit changes some quantities from some step on. The replay walks forward from there; a step
+//        that touches a changed resource adds the change to its cached 'Before' and re-decides whether
+//        it runs, a step that flips changes its own resources from there on, and so on. Every other
+//        step is passed over, nothing is evaluated again, and the walk ends as soon as no quantity
+//        differs any more (a change that is used up, or a step that is replaced by one with the same
+//        effect, stops right there).
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: 'Steps[i]' holds one slot per distinct resource formula i touches; 'Before' is the quantity
+//             of that resource right before step i and 'Ran[i]' tells whether it ran.
+//[INVARIANT]: 'Touchers[r]' lists, in increasing order, every step with a slot for register r.
+//[INVARIANT]: 'Final[r]' = 'Initial[r]' plus the changes of every step that ran. 'Diff' is zero between
+//             edits.
+//
+//[USAGE]
+//{
+// PlanObj.SetCounterKey(42, 7);
+// PlanReplay WhatIf(PlanObj, *StockpilePtr);                   -> runs the trial once
+//
+// WhatIf.ReplaceFormula(Alternative, 1200);                    -> only steps it affects are revisited
+// WhatIf.SetInitialQuantity(Registry.Intern("Iron"), 500);
+// WhatIf.GetQuantity(Registry.Intern("Steel"));  WhatIf.StepRan(1200);
+//}
+//
+//[NOTE]: Steps are described with the proficiency levels the formulas have when they are described. The
+//        replay notices any other change to the plan (its revision moved) and rebuilds on the next edit;
+//        call 'Rebuild()' to pick up changes before querying.
+//[NOTE]: Quantities are assumed to fit in 'size_t' (a run that overflows throws, the replay does not).
+//
+//[DEPENDENCIES]:
+//       [INTERNAL]:
+//          - Member, Helper, Utility methods
+//          - Private Data Members
+//
+//        [EXTERNAL]:
+//          - 'ExecutablePlan' class {[SEE]: ExecutablePlan.h}
+//          - 'Stockpile' class {[SEE]: Stockpile.h}
+//          - 'std::vector'
+//
+//[NAMESPACE]: {ResourceConversion} Encapsulates the 'Formula', 'Plan', 'ExecutablePlan', 'Stockpile'
+//             and supporting classes.
+#ifndef PlanReplay_h
+#define PlanReplay_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ExecutablePlan.h"
+#include "ResourceRegistry.h"
+#include "Stockpile.h"
+
+namespace ResourceConversion
+{
+  class PlanReplay
+  {
+    private:
+    //[DESC]: One resource of one step, duplicates within the formula are merged
+    struct Slot
+    {
+      std::uint32_t Register = 0;
+      unsigned int In = 0;
+      unsigned int Out = 0;
+      size_t Before = 0;
+    };
+
+    ExecutablePlan& Source;
+    std::uint32_t Trial = 0;
+    std::uint64_t Revision = 0;
+
+    std::vector<std::vector<Slot>> Steps = std::vector<std::vector<Slot>>();
+    std::vector<char> Ran = std::vector<char>();
+
+    //[NOTE]: Resources are numbered locally (registers) in order of first use
+    std::vector<ResourceId> Resources = std::vector<ResourceId>();
+    std::vector<std::uint32_t> RegisterOf = std::vector<std::uint32_t>();
+    std::vector<size_t> Initial = std::vector<size_t>();
+    std::vector<size_t> Final = std::vector<size_t>();
+    std::vector<std::vector<std::uint32_t>> Touchers = std::vector<std::vector<std::uint32_t>>();
+
+    //[NOTE]: Scratch of one edit: the change of every register so far in the walk, the registers that
+    //        changed at some point and how many differ right now
+    std::vector<std::int64_t> Diff = std::vector<std::int64_t>();
+    std::vector<std::uint32_t> Dirty = std::vector<std::uint32_t>();
+    size_t Changed = 0;
+    std::vector<unsigned int> Produced = std::vector<unsigned int>();
+    std::vector<Slot> Scratch = std::vector<Slot>();
+
+    std::uint32_t Resolve(ResourceId Resource);
+    void Describe(size_t Index, std::vector<Slot>& Slots);
+    size_t ValueBefore(std::uint32_t Register, size_t Index) const;
+    void Change(std::uint32_t Register, std::int64_t Amount);
+    void Propagate(size_t FirstStep);
+    void Sync();
+
+    public:
+    PlanReplay(ExecutablePlan& Source_, const Stockpile& Start, std::uint32_t Trial_ = 0);
+
+    PlanReplay(const PlanReplay& other) = delete;
+    PlanReplay& operator=(const PlanReplay& other) = delete;
+
+    void Rebuild();
+    void ReplaceFormula(const Formula& NewFormula, size_t Index);
+    void SetInitialQuantity(ResourceId Resource, size_t Quantity);
+    void SetInitialQuantity(const std::string& Resource, size_t Quantity);
+
+    size_t GetQuantity(ResourceId Resource) const;
+    size_t GetQuantity(const std::string& Resource) const;
+    bool StepRan(size_t Index) const;
+    inline size_t StepCount() const { return Steps.size(); }
+  };
+}//[NAMESPACE]: ResourceConversion
+#endif /*PlanReplay_h*/
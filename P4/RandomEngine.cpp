@@ -0,0 +1,31 @@
+//[FILE]: RandomEngine.cpp
+//[DESC]: This file contains the per-thread default engine {[SEE]: RandomEngine.h}
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial design
+
+#include <random>
+
+#include "RandomEngine.h"
+
+namespace ResourceConversion
+{
+  //[DESC]: Get the engine owned by the calling thread.
+  //[PRE]: None
+  //[POST]: On the first call from a thread the engine is seeded from 'std::random_device'
+  //[RETURN]: Reference to the calling thread's engine
+  //[NOTE]: 'std::random_device' is only touched once per thread instead of once per application
+  Xoshiro256StarStar& ThreadLocalEngine()
+  {
+    thread_local Xoshiro256StarStar Engine = []() {
+      std::random_device RandomDevice;
+      std::uint64_t Seed = (static_cast<std::uint64_t>(RandomDevice()) << 32) ^ RandomDevice();
+      return Xoshiro256StarStar(Seed);
+    }();
+    return Engine;
+  }
+}//[NAMESPACE]: ResourceConversion
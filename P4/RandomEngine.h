@@ -0,0 +1,210 @@
+//[FILE]: RandomEngine.h
+//[DESC]: This file defines the random engines used to apply formulas. Any type satisfying the
+//        standard 'UniformRandomBitGenerator' requirements can be injected into 'Formula::Apply',
+//        the engines below are the ones the library uses itself:
+//          - 'SplitMix64' expands a 64-bit seed into well mixed engine state.
+//          - 'Xoshiro256StarStar' is a small, fast generator (32 bytes of state, no syscalls).
+//            'ForStream(...)' derives an independent, reproducible engine per plan/step.
+//          - 'ThreadLocalEngine()' is a per-thread engine seeded once from 'std::random_device',
+//            used whenever a caller does not ask for reproducible results.
+//          - 'Philox4x32' is a counter-based generator (Philox4x32-10). It keeps no running state,
+//            every value is a pure function of (seed, plan id, step, trial, position), so a step
+//            can be evaluated on any thread and in any order with identical results.
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial design
+//          - 1.1 [16/10/2026] - Counter-based 'Philox4x32'
+//
+//[INVARIANT]: Engines are deterministic, the same seed always yields the same sequence on every
+//             platform (no implementation-defined distributions are involved).
+//[INVARIANT]: The state of a 'Xoshiro256StarStar' is never all zero.
+//
+//[USAGE]
+//{
+// Xoshiro256StarStar Generator = Xoshiro256StarStar::ForStream(Seed, StepIndex);
+// FormulaObject.Apply(Generator);       -> reproducible
+// FormulaObject.Apply();                -> 'ThreadLocalEngine()'
+//
+// Philox4x32 Counter(Seed, PlanId, StepIndex, TrialIndex);
+// FormulaObject.Apply(Counter);         -> order independent
+//}
+//
+//[NAMESPACE]: {ResourceConversion} Encapsulates the 'Formula', 'Plan', 'ExecutablePlan', 'Stockpile'
+//             and supporting classes.
+#ifndef RandomEngine_h
+#define RandomEngine_h
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace ResourceConversion
+{
+  class SplitMix64
+  {
+    private:
+    std::uint64_t State = 0;
+
+    public:
+    explicit SplitMix64(std::uint64_t Seed) : State(Seed) {}
+
+    //[DESC]: Advance the state and return the next 64-bit value
+    inline std::uint64_t Next()
+    {
+      std::uint64_t Value = (State += 0x9E3779B97F4A7C15ULL);
+      Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBULL;
+      return Value ^ (Value >> 31);
+    }
+
+    //[DESC]: Combine two 64-bit values into one well mixed seed
+    static inline std::uint64_t Mix(std::uint64_t First, std::uint64_t Second)
+    {
+      SplitMix64 Mixer(First ^ (Second * 0xD1B54A32D192ED03ULL));
+      Mixer.Next();
+      return Mixer.Next();
+    }
+  };
+
+  class Xoshiro256StarStar
+  {
+    private:
+    std::array<std::uint64_t, 4> State = {};
+
+    static inline std::uint64_t RotateLeft(std::uint64_t Value, int Shift)
+    {
+      return (Value << Shift) | (Value >> (64 - Shift));
+    }
+
+    public:
+    using result_type = std::uint64_t;
+
+    explicit Xoshiro256StarStar(std::uint64_t Seed = 0)
+    {
+      SplitMix64 Seeder(Seed);
+      for(std::uint64_t& Word : State) { Word = Seeder.Next(); }
+    }
+
+    static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    //[DESC]: Advance the state and return the next 64-bit value
+    inline result_type operator()()
+    {
+      const std::uint64_t Result = RotateLeft(State[1] * 5, 7) * 9;
+      const std::uint64_t Shifted = State[1] << 17;
+
+      State[2] ^= State[0];
+      State[3] ^= State[1];
+      State[1] ^= State[2];
+      State[0] ^= State[3];
+
+      State[2] ^= Shifted;
+      State[3] = RotateLeft(State[3], 45);
+
+      return Result;
+    }
+
+    //[DESC]: Build the engine of an independent stream, e.g. one per plan step
+    //[PARAM]: 'Seed' The root seed of the simulation
+    //[PARAM]: 'Stream' Identifies the stream below 'Seed'
+    //[RETURN]: An engine whose sequence only depends on ('Seed', 'Stream')
+    static inline Xoshiro256StarStar ForStream(std::uint64_t Seed, std::uint64_t Stream)
+    {
+      return Xoshiro256StarStar(SplitMix64::Mix(Seed, Stream));
+    }
+
+    inline const std::array<std::uint64_t, 4>& GetState() const { return State; }
+  };
+
+  class Philox4x32
+  {
+    public:
+    using result_type = std::uint32_t;
+    using CounterType = std::array<std::uint32_t, 4>;
+    using KeyType = std::array<std::uint32_t, 2>;
+
+    private:
+    static constexpr std::uint32_t Multiplier0 = 0xD2511F53U;
+    static constexpr std::uint32_t Multiplier1 = 0xCD9E8D57U;
+    static constexpr std::uint32_t Weyl0 = 0x9E3779B9U;
+    static constexpr std::uint32_t Weyl1 = 0xBB67AE85U;
+    static constexpr int Rounds = 10;
+
+    CounterType Counter = {};
+    KeyType Key = {};
+    CounterType Buffer = {};
+    std::size_t Position = 4;
+
+    public:
+    //[DESC]: Build the stream of one (plan, step, trial) below 'Seed'
+    //[NOTE]: Counter word 0 is the block index inside the stream, the remaining words hold the
+    //        trial, step and plan id; the seed is the key. Distinct tuples never share a block.
+    Philox4x32(std::uint64_t Seed, std::uint32_t PlanId, std::uint32_t Step, std::uint32_t Trial)
+    {
+      Counter = {0U, Trial, Step, PlanId};
+      Key = {static_cast<std::uint32_t>(Seed), static_cast<std::uint32_t>(Seed >> 32)};
+    }
+
+    static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    //[DESC]: Return the next 32-bit value, a new block is computed every fourth call
+    inline result_type operator()()
+    {
+      if(Position == Buffer.size())
+      {
+        Buffer = Block(Counter, Key);
+        ++Counter[0];
+        Position = 0;
+      }
+      return Buffer[Position++];
+    }
+
+    //[DESC]: The Philox4x32-10 bijection, maps one 128-bit counter to 128 random bits
+    //[PARAM]: 'Counter' The block to compute
+    //[PARAM]: 'Key' The 64-bit key
+    //[RETURN]: Four random 32-bit words
+    static inline CounterType Block(CounterType Counter, KeyType Key)
+    {
+      for(int Round = 0; Round < Rounds; ++Round)
+      {
+        const std::uint64_t Product0 = static_cast<std::uint64_t>(Multiplier0) * Counter[0];
+        const std::uint64_t Product1 = static_cast<std::uint64_t>(Multiplier1) * Counter[2];
+
+        Counter = {static_cast<std::uint32_t>(Product1 >> 32) ^ Counter[1] ^ Key[0],
+                   static_cast<std::uint32_t>(Product1),
+                   static_cast<std::uint32_t>(Product0 >> 32) ^ Counter[3] ^ Key[1],
+                   static_cast<std::uint32_t>(Product0)};
+
+        Key[0] += Weyl0;
+        Key[1] += Weyl1;
+      }
+      return Counter;
+    }
+  };
+
+  //[DESC]: Draw a float uniformly distributed in [0, 1) from any full-range engine
+  //[PARAM]: 'Generator' A 'UniformRandomBitGenerator' whose range is [0, 2^N - 1], N >= 24
+  //[RETURN]: The top 24 bits of the next value, scaled into [0, 1)
+  //[NOTE]: Unlike 'std::uniform_real_distribution' the result is identical on every standard library
+  template<typename Engine>
+  inline float UnitFloat(Engine& Generator)
+  {
+    using ResultType = typename Engine::result_type;
+    constexpr int Digits = std::numeric_limits<ResultType>::digits;
+    static_assert(std::is_unsigned<ResultType>::value && Digits >= 24, "[UnitFloat] Engine must produce at least 24 random bits");
+    static_assert(Engine::min() == 0 && Engine::max() == std::numeric_limits<ResultType>::max(), "[UnitFloat] Engine must be full-range");
+
+    constexpr float Scale = 1.0f / 16777216.0f;
+    return static_cast<float>(static_cast<std::uint32_t>(Generator() >> (Digits - 24))) * Scale;
+  }
+
+  Xoshiro256StarStar& ThreadLocalEngine();
+}//[NAMESPACE]: ResourceConversion
+#endif /*RandomEngine_h*/
@@ -0,0 +1,410 @@
+//[FILE]: ResourceGraph.cpp
+//[DESC]: This file contains the implementation of the 'ResourceGraph' class {[SEE]: ResourceGraph.h}
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: 'Queue' is a min-heap on cost. An entry whose cost no longer equals 'Cost[r]' is stale and
+//             dropped when popped.
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#include "ResourceGraph.h"
+
+namespace ResourceConversion
+{
+  namespace
+  {
+    //[NOTE]: Costs saturate here, far below 'Unreachable', so sums of costs never wrap around
+    constexpr std::uint64_t CostLimit = std::numeric_limits<std::uint64_t>::max() / 4;
+
+    inline std::uint64_t SaturatingAdd(std::uint64_t Left, std::uint64_t Right)
+    {
+      return (Left >= CostLimit - Right) ? CostLimit : Left + Right;
+    }
+  }
+
+  //[DESC]: Default constructor
+  //[PRE]: None
+  //[POST]: An empty graph is constructed, it knows no formula and no resource
+  ResourceGraph::ResourceGraph() {}
+
+  //[DESC]: Make room for a resource in every per-resource array
+  //[PARAM]: 'Resource' The resource
+  //[PRE]: None
+  //[POST]: 'Resource' indexes every per-resource array; new resources are unreachable
+  void ResourceGraph::Reserve(ResourceId Resource)
+  {
+    if(Resource >= Consumers.size())
+    {
+      Consumers.resize(static_cast<size_t>(Resource) + 1);
+      Producers.resize(static_cast<size_t>(Resource) + 1);
+    }
+    Widen(Resource);
+  }
+
+  //[DESC]: Make room for a resource in the cached per-resource arrays
+  //[PARAM]: 'Resource' The resource
+  //[PRE]: None
+  //[POST]: 'Resource' indexes the cached arrays; new resources are unreachable
+  //[NOTE]: A stockpile can hold resources no formula mentions. They cannot change any cost, so they only
+  //        get a cache slot, and the catalog arrays stay as they are.
+  void ResourceGraph::Widen(ResourceId Resource) const
+  {
+    if(Resource < Cost.size()) { return; }
+
+    const size_t Size = static_cast<size_t>(Resource) + 1;
+    Cost.resize(Size, Unreachable);
+    Propagated.resize(Size, Unreachable);
+    Best.resize(Size, NoFormula);
+    ResourceMark.resize(Size, 0);
+  }
+
+  //[DESC]: Add a formula to the graph
+  //[PARAM]: 'NewFormula' The formula, only its resources are recorded
+  //[PRE]: None
+  //[POST]: The formula is hyperedge 'FormulaCount() - 1'. If costs are cached, they are lowered to
+  //        account for it, visiting only the resources whose cost drops
+  //[THROW]: 'std::length_error' If the graph already holds the maximum number of formulas
+  //[RETURN]: The index of the formula
+  size_t ResourceGraph::AddFormula(const Formula& NewFormula)
+  {
+    if(FormulaCount() >= NoFormula)
+    {
+      throw std::length_error("[RG]AddFormula(...) [Too many formulas]");
+    }
+
+    const std::uint32_t Index = static_cast<std::uint32_t>(FormulaCount());
+    const Formula::ResourceView View = NewFormula.GetView();
+
+    const size_t InputBegin = Inputs.size();
+    for(ResourceId Resource : View.InputResources)
+    {
+      if(std::find(Inputs.begin() + static_cast<std::ptrdiff_t>(InputBegin), Inputs.end(), Resource) != Inputs.end()) { continue; }
+      Reserve(Resource);
+      Inputs.push_back(Resource);
+      Consumers[Resource].push_back(Index);
+    }
+    InputOffsets.push_back(Inputs.size());
+
+    const size_t OutputBegin = Outputs.size();
+    for(ResourceId Resource : View.OutputResources)
+    {
+      if(std::find(Outputs.begin() + static_cast<std::ptrdiff_t>(OutputBegin), Outputs.end(), Resource) != Outputs.end()) { continue; }
+      Reserve(Resource);
+      Outputs.push_back(Resource);
+      Producers[Resource].push_back(Index);
+    }
+    OutputOffsets.push_back(Outputs.size());
+    FormulaMark.push_back(0);
+
+    if(InputBegin == Inputs.size()) { Sourceless.push_back(Index); }
+    if(CacheIsValid)
+    {
+      Relax(Index);
+      Drain();
+    }
+    return Index;
+  }
+
+  //[DESC]: Add every formula of a plan, in plan order
+  //[PARAM]: 'Catalog' The plan
+  //[PRE]: None
+  //[POST]: Formula i of 'Catalog' is hyperedge 'FormulaCount() + i' (counted before the call)
+  //[THROW]: 'std::length_error' {[SEE]: AddFormula(...)}
+  void ResourceGraph::AddPlan(const Plan& Catalog)
+  {
+    FormulaMark.reserve(FormulaCount() + Catalog.GetSize());
+    InputOffsets.reserve(FormulaCount() + Catalog.GetSize() + 1);
+    OutputOffsets.reserve(FormulaCount() + Catalog.GetSize() + 1);
+    for(size_t i = 0; i < Catalog.GetSize(); i++) { AddFormula(Catalog.GetFormula(i)); }
+  }
+
+  //[DESC]: The distinct inputs of a formula
+  //[PARAM]: 'Index' The formula
+  //[PRE]: 'Index' < 'FormulaCount()'
+  //[POST]: None
+  //[RETURN]: A view that stays valid until the next formula is added
+  Span<const ResourceId> ResourceGraph::GetInputs(size_t Index) const
+  {
+    return Span<const ResourceId>(Inputs.data() + InputOffsets[Index], InputOffsets[Index + 1] - InputOffsets[Index]);
+  }
+
+  //[DESC]: The distinct outputs of a formula
+  //[PARAM]: 'Index' The formula
+  //[PRE]: 'Index' < 'FormulaCount()'
+  //[POST]: None
+  //[RETURN]: A view that stays valid until the next formula is added
+  Span<const ResourceId> ResourceGraph::GetOutputs(size_t Index) const
+  {
+    return Span<const ResourceId>(Outputs.data() + OutputOffsets[Index], OutputOffsets[Index + 1] - OutputOffsets[Index]);
+  }
+
+  //[DESC]: The formulas that consume a resource
+  //[PARAM]: 'Resource' The resource
+  //[PRE]: None
+  //[POST]: None
+  //[RETURN]: Formula indices in the order they were added, empty for a resource no formula consumes. The
+  //          view stays valid until the next formula is added
+  Span<const std::uint32_t> ResourceGraph::GetConsumers(ResourceId Resource) const
+  {
+    if(Resource >= Consumers.size()) { return Span<const std::uint32_t>(); }
+    return Span<const std::uint32_t>(Consumers[Resource].data(), Consumers[Resource].size());
+  }
+
+  //[DESC]: The formulas that produce a resource
+  //[PARAM]: 'Resource' The resource
+  //[PRE]: None
+  //[POST]: None
+  //[RETURN]: Formula indices in the order they were added, empty for a resource no formula produces. The
+  //          view stays valid until the next formula is added
+  Span<const std::uint32_t> ResourceGraph::GetProducers(ResourceId Resource) const
+  {
+    if(Resource >= Producers.size()) { return Span<const std::uint32_t>(); }
+    return Span<const std::uint32_t>(Producers[Resource].data(), Producers[Resource].size());
+  }
+
+  //[DESC]: Lower the cost of a resource and queue it
+  //[PARAM]: 'Resource' The resource
+  //[PARAM]: 'NewCost' The candidate cost
+  //[PARAM]: 'Formula' The formula that achieves it, 'NoFormula' for a source
+  //[PRE]: The cache is valid
+  //[POST]: If 'NewCost' is lower than the cost of 'Resource', it becomes its cost and 'Resource' is queued
+  void ResourceGraph::Lower(ResourceId Resource, std::uint64_t NewCost, std::uint32_t Formula) const
+  {
+    if(NewCost >= Cost[Resource]) { return; }
+    Cost[Resource] = NewCost;
+    Best[Resource] = Formula;
+    Queue.emplace_back(NewCost, Resource);
+    std::push_heap(Queue.begin(), Queue.end(), std::greater<std::pair<std::uint64_t, ResourceId>>());
+  }
+
+  //[DESC]: Offer the current cost of a formula to its outputs
+  //[PARAM]: 'Formula' The formula
+  //[PRE]: The cache is valid
+  //[POST]: If every input has a propagated cost, each output is lowered to 1 + their sum
+  //[NOTE]: The sum is recomputed from the inputs (formulas have few) rather than adjusted, so an input
+  //        whose cost dropped twice is never counted twice.
+  void ResourceGraph::Relax(std::uint32_t Formula) const
+  {
+    std::uint64_t Candidate = 1;
+    for(size_t i = InputOffsets[Formula]; i < InputOffsets[Formula + 1]; i++)
+    {
+      const std::uint64_t InputCost = Propagated[Inputs[i]];
+      if(InputCost == Unreachable) { return; }
+      Candidate = SaturatingAdd(Candidate, InputCost);
+    }
+    for(size_t i = OutputOffsets[Formula]; i < OutputOffsets[Formula + 1]; i++)
+    {
+      Lower(Outputs[i], Candidate, Formula);
+    }
+  }
+
+  //[DESC]: Propagate queued cost drops, cheapest first
+  //[PRE]: The cache is valid
+  //[POST]: The queue is empty; every resource's cost is propagated to its consumers
+  void ResourceGraph::Drain() const
+  {
+    while(!Queue.empty())
+    {
+      std::pop_heap(Queue.begin(), Queue.end(), std::greater<std::pair<std::uint64_t, ResourceId>>());
+      const std::pair<std::uint64_t, ResourceId> Top = Queue.back();
+      Queue.pop_back();
+
+      const ResourceId Resource = Top.second;
+      if(Top.first != Cost[Resource] || Propagated[Resource] == Cost[Resource]) { continue; }
+      Propagated[Resource] = Cost[Resource];
+      if(Resource >= Consumers.size()) { continue; }
+      for(std::uint32_t Consumer : Consumers[Resource]) { Relax(Consumer); }
+    }
+  }
+
+  //[DESC]: Compute every cost from scratch for the sources in 'Sources'
+  //[PRE]: None
+  //[POST]: The cache is valid
+  void ResourceGraph::Rebuild() const
+  {
+    Cost.assign(Cost.size(), Unreachable);
+    Propagated.assign(Propagated.size(), Unreachable);
+    Best.assign(Best.size(), NoFormula);
+    Queue.clear();
+    CacheIsValid = true;
+
+    for(ResourceId Source : Sources) { Lower(Source, 0, NoFormula); }
+    for(std::uint32_t Formula : Sourceless) { Relax(Formula); }
+    Drain();
+  }
+
+  //[DESC]: Bring the cached costs in line with the sources collected in 'NextSources'
+  //[PRE]: 'NextSources' holds the new sources, in any order, possibly repeated
+  //[POST]: The cache is valid for the new sources, 'NextSources' holds scratch. An unchanged set costs the
+  //        sort; a set that only grew lowers costs in place; otherwise costs are rebuilt
+  void ResourceGraph::Adopt() const
+  {
+    std::sort(NextSources.begin(), NextSources.end());
+    NextSources.erase(std::unique(NextSources.begin(), NextSources.end()), NextSources.end());
+
+    if(!NextSources.empty()) { Widen(NextSources.back()); }
+
+    if(CacheIsValid && NextSources == Sources) { return; }
+    if(CacheIsValid && std::includes(NextSources.begin(), NextSources.end(), Sources.begin(), Sources.end()))
+    {
+      for(ResourceId Resource : NextSources) { Lower(Resource, 0, NoFormula); }
+      Drain();
+      Sources.swap(NextSources);
+      return;
+    }
+
+    Sources.swap(NextSources);
+    Rebuild();
+  }
+
+  //[DESC]: Bring the cached costs in line with the resources a stockpile holds
+  //[PARAM]: 'Source' The stockpile, every resource with a quantity above zero is a source
+  //[PRE]: None
+  //[POST]: The cache is valid for the sources of 'Source' {[SEE]: Adopt()}
+  void ResourceGraph::Sync(const Stockpile& Source) const
+  {
+    NextSources.clear();
+    Source.ForEachResource([this](ResourceId Resource, size_t Quantity) {
+      if(Quantity > 0) { NextSources.push_back(Resource); }
+    });
+    Adopt();
+  }
+
+  //[DESC]: Use the resources a stockpile holds as the sources of later queries
+  //[PARAM]: 'Source' The stockpile, every resource with a quantity above zero is a source
+  //[PRE]: None
+  //[POST]: The costs are cached for the new sources, queries without a stockpile are lookups. Later
+  //        changes to 'Source' are not seen until the sources are set again
+  void ResourceGraph::SetSources(const Stockpile& Source)
+  {
+    Sync(Source);
+  }
+
+  //[DESC]: Use a list of resources as the sources of later queries
+  //[PARAM]: 'Resources' The sources, in any order; a resource listed twice counts once
+  //[PRE]: None
+  //[POST]: The costs are cached for the new sources, queries without a stockpile are lookups
+  void ResourceGraph::SetSources(Span<const ResourceId> Resources)
+  {
+    NextSources.assign(Resources.begin(), Resources.end());
+    Adopt();
+  }
+
+  //[DESC]: Check whether a resource can be had from the current sources
+  //[PARAM]: 'Target' The resource
+  //[PRE]: None
+  //[POST]: None
+  //[RETURN]: 'true' if 'Target' is a source or some chain of formulas produces it
+  //[NOTE]: Without 'SetSources(...)' (or a query against a stockpile) before, the set of sources is empty
+  bool ResourceGraph::CanProduce(ResourceId Target) const
+  {
+    return GetChainCost(Target) != Unreachable;
+  }
+
+  //[DESC]: The cost of the cheapest chain that produces a resource from the current sources
+  //[PARAM]: 'Target' The resource
+  //[PRE]: None
+  //[POST]: None
+  //[RETURN]: 0 if 'Target' is a source, 'Unreachable' if no chain produces it, the hyperpath cost of the
+  //          cheapest chain otherwise {[SEE]: ResourceGraph.h}
+  std::uint64_t ResourceGraph::GetChainCost(ResourceId Target) const
+  {
+    if(!CacheIsValid) { Rebuild(); }
+    return (Target < Cost.size()) ? Cost[Target] : Unreachable;
+  }
+
+  //[DESC]: Check whether a resource can be had from a stockpile
+  //[PARAM]: 'Target' The resource
+  //[PARAM]: 'Source' The stockpile
+  //[PRE]: None
+  //[POST]: The resources of 'Source' are the sources {[SEE]: SetSources(const Stockpile&)}
+  //[RETURN]: 'true' if 'Source' holds 'Target' or some chain of formulas produces it
+  bool ResourceGraph::CanProduce(ResourceId Target, const Stockpile& Source) const
+  {
+    Sync(Source);
+    return CanProduce(Target);
+  }
+
+  //[DESC]: The cost of the cheapest chain that produces a resource from a stockpile
+  //[PARAM]: 'Target' The resource
+  //[PARAM]: 'Source' The stockpile
+  //[PRE]: None
+  //[POST]: The resources of 'Source' are the sources {[SEE]: SetSources(const Stockpile&)}
+  //[RETURN]: {[SEE]: GetChainCost(ResourceId)}
+  std::uint64_t ResourceGraph::GetChainCost(ResourceId Target, const Stockpile& Source) const
+  {
+    Sync(Source);
+    return GetChainCost(Target);
+  }
+
+  //[DESC]: The formulas of the cheapest chain that produces a resource from a stockpile
+  //[PARAM]: 'Target' The resource
+  //[PARAM]: 'Source' The stockpile
+  //[PRE]: None
+  //[POST]: The resources of 'Source' are the sources {[SEE]: SetSources(const Stockpile&)}
+  //[RETURN]: {[SEE]: GetChain(ResourceId)}
+  std::vector<size_t> ResourceGraph::GetChain(ResourceId Target, const Stockpile& Source) const
+  {
+    Sync(Source);
+    return GetChain(Target);
+  }
+
+  //[DESC]: The formulas of the cheapest chain that produces a resource from the current sources
+  //[PARAM]: 'Target' The resource
+  //[PRE]: None
+  //[POST]: None
+  //[RETURN]: Formula indices, each once, ordered so every formula comes after the formulas that make its
+  //          inputs; empty if 'Target' is a source or no chain produces it
+  std::vector<size_t> ResourceGraph::GetChain(ResourceId Target) const
+  {
+    std::vector<size_t> Chain;
+    if(GetChainCost(Target) == Unreachable) { return Chain; }
+
+    if(++Epoch == 0)
+    {
+      std::fill(ResourceMark.begin(), ResourceMark.end(), 0);
+      std::fill(FormulaMark.begin(), FormulaMark.end(), 0);
+      Epoch = 1;
+    }
+
+    //[NOTE]: Post-order walk of the 'Best' formulas; a resource is pushed a second time (high bit set)
+    //        below its inputs, so its formula is emitted once they are. Following 'Best' only leads to
+    //        cheaper resources and a resource is expanded once, so the walk ends
+    static constexpr std::uint64_t Emit = std::uint64_t(1) << 63;
+    std::vector<std::uint64_t> Pending(1, Target);
+    while(!Pending.empty())
+    {
+      const std::uint64_t Top = Pending.back();
+      Pending.pop_back();
+
+      const ResourceId Resource = static_cast<ResourceId>(Top & ~Emit);
+      const std::uint32_t Formula = Best[Resource];
+      if(Top & Emit)
+      {
+        if(FormulaMark[Formula] != Epoch)
+        {
+          FormulaMark[Formula] = Epoch;
+          Chain.push_back(Formula);
+        }
+        continue;
+      }
+
+      if(ResourceMark[Resource] == Epoch || Formula == NoFormula) { continue; }
+      ResourceMark[Resource] = Epoch;
+      Pending.push_back(Top | Emit);
+      for(size_t i = InputOffsets[Formula]; i < InputOffsets[Formula + 1]; i++)
+      {
+        if(ResourceMark[Inputs[i]] != Epoch) { Pending.push_back(Inputs[i]); }
+      }
+    }
+    return Chain;
+  }
+}//[NAMESPACE]: ResourceConversion
@@ -0,0 +1,156 @@
+//[FILE]: ResourceGraph.h
+//[DESC]: This file defines the 'ResourceGraph' class, an index over a catalog of formulas that answers
+//        "what makes what" questions without simulating plans. Resources are the nodes, every formula
+//        is a hyperedge from its (distinct) inputs to its outputs:
+//
+//          Consumers[Iron] = {0, 3}       Producers[Steel] = {0}       (formula indices)
+//          Inputs(0) = {Iron, Coal}       Outputs(0) = {Steel}
+//
+//        Queries run against a set of sources, the resources that can be had without any formula:
+//          - 'CanProduce(X)': some chain of formulas ends in X
+//          - 'GetChain(X)': the formulas of the cheapest such chain, in an order they can be applied;
+//            'GetChainCost(X)' its cost
+//
+//        'SetSources(...)' sets the sources, from a list or from the resources a stockpile holds
+//        (quantity above zero). The queries are then lookups: 'CanProduce' and 'GetChainCost' read one
+//        cached cost, 'GetChain' walks the chain it returns. The overloads that take a stockpile set
+//        its resources as the sources first, which costs a pass over the stockpile and a sort on
+//        every call; they suit a stockpile that changes between queries.
+//
+//        The cost of a chain is the number of formula applications when every input is derived on its
+//        own (the hyperpath cost of Knuth's generalization of Dijkstra's algorithm): cost(source) = 0,
+//        cost(f) = 1 + sum of the costs of its inputs, cost(X) = min over the producers of X. The
+//        chain applies shared sub-chains once, so it can be shorter than its cost.
+//
+//        The costs of every resource are cached for one set of sources. Setting the same set again
+//        changes nothing; a set that only grew, and every added formula, lower costs in place (costs
+//        never rise then, so only the affected part of the graph is visited). A set that lost a
+//        resource is recomputed from scratch.
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: Formulas are only ever appended, formula i keeps index i.
+//[INVARIANT]: While the cache is valid, 'Cost[r]' is the least cost of r over the formulas and sources
+//             seen so far, once every queued resource was processed. 'Best[r]' is the formula that
+//             achieves it, 'NoFormula' for a source.
+//
+//[USAGE]
+//{
+// ResourceGraph Graph;
+// Graph.AddPlan(Catalog);                                 -> or 'AddFormula(...)' one by one
+//
+// Graph.SetSources(*StockpilePtr);                        -> one pass over the stockpile
+// Graph.CanProduce(Registry.Intern("Steel"));             -> lookups from here on
+// std::vector<size_t> Chain = Graph.GetChain(Registry.Intern("Steel"));
+//
+// Graph.GetChainCost(Registry.Intern("Steel"), *StockpilePtr);   -> sets the sources and looks up
+// for(uint32_t Index : Graph.GetConsumers(Registry.Intern("Coal"))) { ... }
+//}
+//
+//[NOTE]: Quantities are ignored, a formula counts as able to run once all its inputs can be had.
+//[NOTE]: Queries are 'const' but update the cache (like 'Plan::GetFormulaBook()'), so one graph must not
+//        be queried from two threads at once.
+//
+//[DEPENDENCIES]:
+//       [INTERNAL]:
+//          - Member, Helper, Utility methods
+//          - Private Data Members
+//
+//        [EXTERNAL]:
+//          - 'Formula', 'Plan' {[SEE]: Formula.h, Plan.h}
+//          - 'Stockpile' class {[SEE]: Stockpile.h}
+//          - 'Span' {[SEE]: Span.h}
+//
+//[NAMESPACE]: {ResourceConversion} Encapsulates the 'Formula', 'Plan', 'ExecutablePlan', 'Stockpile'
+//             and supporting classes.
+#ifndef ResourceGraph_h
+#define ResourceGraph_h
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "Formula.h"
+#include "Plan.h"
+#include "ResourceRegistry.h"
+#include "Span.h"
+#include "Stockpile.h"
+
+namespace ResourceConversion
+{
+  class ResourceGraph
+  {
+    public:
+    //[NOTE]: Cost of a resource no chain reaches {[SEE]: GetChainCost(...)}
+    static constexpr std::uint64_t Unreachable = std::numeric_limits<std::uint64_t>::max();
+
+    private:
+    static constexpr std::uint32_t NoFormula = std::numeric_limits<std::uint32_t>::max();
+
+    //[NOTE]: The catalog, as growing compressed rows. Inputs are stored without duplicates.
+    std::vector<ResourceId> Inputs = std::vector<ResourceId>();
+    std::vector<size_t> InputOffsets = std::vector<size_t>(1, 0);
+    std::vector<ResourceId> Outputs = std::vector<ResourceId>();
+    std::vector<size_t> OutputOffsets = std::vector<size_t>(1, 0);
+    std::vector<std::vector<std::uint32_t>> Consumers = std::vector<std::vector<std::uint32_t>>();
+    std::vector<std::vector<std::uint32_t>> Producers = std::vector<std::vector<std::uint32_t>>();
+    std::vector<std::uint32_t> Sourceless = std::vector<std::uint32_t>();
+
+    //[NOTE]: Cached costs for the sources in 'Sources' (sorted). 'Propagated[r]' is the cost of r the
+    //        consumers of r have seen, a resource is queued in 'Queue' while it differs from 'Cost[r]'.
+    mutable bool CacheIsValid = false;
+    mutable std::vector<ResourceId> Sources = std::vector<ResourceId>();
+    mutable std::vector<ResourceId> NextSources = std::vector<ResourceId>();
+    mutable std::vector<std::uint64_t> Cost = std::vector<std::uint64_t>();
+    mutable std::vector<std::uint64_t> Propagated = std::vector<std::uint64_t>();
+    mutable std::vector<std::uint32_t> Best = std::vector<std::uint32_t>();
+    mutable std::vector<std::pair<std::uint64_t, ResourceId>> Queue = std::vector<std::pair<std::uint64_t, ResourceId>>();
+
+    //[NOTE]: Visit marks of 'GetChain(...)', a mark equal to 'Epoch' means visited by the current call
+    mutable std::uint32_t Epoch = 0;
+    mutable std::vector<std::uint32_t> ResourceMark = std::vector<std::uint32_t>();
+    mutable std::vector<std::uint32_t> FormulaMark = std::vector<std::uint32_t>();
+
+    void Reserve(ResourceId Resource);
+    void Widen(ResourceId Resource) const;
+    void Sync(const Stockpile& Source) const;
+    void Adopt() const;
+    void Rebuild() const;
+    void Lower(ResourceId Resource, std::uint64_t NewCost, std::uint32_t Formula) const;
+    void Relax(std::uint32_t Formula) const;
+    void Drain() const;
+
+    public:
+    ResourceGraph();
+
+    size_t AddFormula(const Formula& NewFormula);
+    void AddPlan(const Plan& Catalog);
+
+    inline size_t FormulaCount() const { return InputOffsets.size() - 1; }
+    inline size_t ResourceCount() const { return Consumers.size(); }
+
+    Span<const ResourceId> GetInputs(size_t Index) const;
+    Span<const ResourceId> GetOutputs(size_t Index) const;
+    Span<const std::uint32_t> GetConsumers(ResourceId Resource) const;
+    Span<const std::uint32_t> GetProducers(ResourceId Resource) const;
+
+    void SetSources(const Stockpile& Source);
+    void SetSources(Span<const ResourceId> Resources);
+
+    bool CanProduce(ResourceId Target) const;
+    std::uint64_t GetChainCost(ResourceId Target) const;
+    std::vector<size_t> GetChain(ResourceId Target) const;
+
+    bool CanProduce(ResourceId Target, const Stockpile& Source) const;
+    std::uint64_t GetChainCost(ResourceId Target, const Stockpile& Source) const;
+    std::vector<size_t> GetChain(ResourceId Target, const Stockpile& Source) const;
+  };
+}//[NAMESPACE]: ResourceConversion
+#endif /*ResourceGraph_h*/
@@ -0,0 +1,102 @@
+//[FILE]: ResourceRegistry.cpp
+//[DESC]: This file contains the implementation of the 'ResourceRegistry' class, which interns
+//        resource names into dense 'ResourceId' values.
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: Identifiers are dense, handed out in order starting at 0, and never reused.
+//[INVARIANT]: Writers (Intern) take the registry lock exclusively, readers share it.
+
+#include <stdexcept>
+#include <limits>
+#include <mutex>
+
+#include "ResourceRegistry.h"
+
+namespace ResourceConversion
+{
+  //[DESC]: Default constructor, only reachable through 'Instance()'
+  //[PRE]: None
+  //[POST]: An empty registry is constructed
+  ResourceRegistry::ResourceRegistry() : IdsByName(), NamesById(), RegistryMutex() {}
+
+  //[DESC]: Get the process-wide registry. The instance is created on the first call.
+  //[RETURN]: Reference to the single 'ResourceRegistry' instance
+  ResourceRegistry& ResourceRegistry::Instance()
+  {
+    static ResourceRegistry Instance_;
+    return Instance_;
+  }
+
+  //[DESC]: Intern a resource name, returning its identifier.
+  //[PARAM]: 'Name' The resource name
+  //[PRE]: None
+  //[POST]: 'Name' is present in the registry
+  //[THROW]: 'std::overflow_error' if the identifier space is exhausted
+  //[RETURN]: The identifier of 'Name', newly assigned if it was not interned before
+  //[NOTE]: The common case (name already interned) only takes the shared lock
+  ResourceId ResourceRegistry::Intern(const std::string& Name)
+  {
+    {
+      std::shared_lock<std::shared_mutex> ReadLock(RegistryMutex);
+      auto it = IdsByName.find(Name);
+      if(it != IdsByName.end()) { return it -> second; }
+    }
+
+    std::unique_lock<std::shared_mutex> WriteLock(RegistryMutex);
+    auto it = IdsByName.find(Name);
+    if(it != IdsByName.end()) { return it -> second; }
+
+    if(NamesById.size() >= std::numeric_limits<ResourceId>::max())
+    {
+      throw std::overflow_error("[R]Intern(...) [Resource identifier space exhausted]");
+    }
+
+    ResourceId NewId = static_cast<ResourceId>(NamesById.size());
+    NamesById.push_back(Name);
+    IdsByName.emplace(Name, NewId);
+    return NewId;
+  }
+
+  //[DESC]: Look up the identifier of a resource name without interning it.
+  //[PARAM]: 'Name' The resource name
+  //[PRE]: None
+  //[POST]: None
+  //[RETURN]: The identifier of 'Name', or 'std::nullopt' if it was never interned
+  std::optional<ResourceId> ResourceRegistry::Find(const std::string& Name) const
+  {
+    std::shared_lock<std::shared_mutex> ReadLock(RegistryMutex);
+    auto it = IdsByName.find(Name);
+    if(it == IdsByName.end()) { return std::nullopt; }
+    return it -> second;
+  }
+
+  //[DESC]: Get the name of an interned resource.
+  //[PARAM]: 'Id' The resource identifier
+  //[PRE]: 'Id' was returned by 'Intern(...)'
+  //[POST]: None
+  //[THROW]: 'std::out_of_range' if 'Id' was never handed out
+  //[RETURN]: Reference to the interned name, valid for the lifetime of the process
+  const std::string& ResourceRegistry::GetName(ResourceId Id) const
+  {
+    std::shared_lock<std::shared_mutex> ReadLock(RegistryMutex);
+    if(Id >= NamesById.size())
+    {
+      throw std::out_of_range("[R]GetName(...) [Unknown resource identifier]");
+    }
+    return NamesById[Id];
+  }
+
+  //[DESC]: Get the number of interned resources.
+  //[RETURN]: The number of identifiers handed out so far, every valid id is below this value
+  std::size_t ResourceRegistry::Size() const
+  {
+    std::shared_lock<std::shared_mutex> ReadLock(RegistryMutex);
+    return NamesById.size();
+  }
+}//[NAMESPACE]: ResourceConversion
@@ -0,0 +1,67 @@
+//[FILE]: ResourceRegistry.h
+//[DESC]: This file defines the 'ResourceRegistry' class, a process-wide table that interns resource
+//        names into dense 32-bit identifiers ('ResourceId'). Every resource name is hashed exactly
+//        once, when it is first interned; from then on 'Formula', 'Stockpile' and the executors
+//        work on the integer identifiers and only translate back to names at the API edge
+//        (construction, display, 'GetResourcesMap()').
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: Identifiers are dense, handed out in order starting at 0, and never reused.
+//[INVARIANT]: An interned name is never removed, so 'GetName(...)' references stay valid for the
+//             lifetime of the process.
+//[INVARIANT]: The registry is safe to use from multiple threads.
+//
+//[DEPENDENCIES]:
+//       [INTERNAL]:
+//          - Member, Helper, Utility methods
+//          - Private Data Members
+//
+//        [EXTERNAL]:
+//          - 'std::unordered_map', 'std::deque', 'std::shared_mutex'
+//
+//[NAMESPACE]: {ResourceConversion} Encapsulates the 'Formula', 'Plan', 'ExecutablePlan', 'Stockpile'
+//             and 'ResourceRegistry' class.
+#ifndef ResourceRegistry_h
+#define ResourceRegistry_h
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace ResourceConversion
+{
+  using ResourceId = std::uint32_t;
+
+  // [NOTE]: Meyers Singleton Pattern, there is exactly one name <-> id table per process so that
+  //         identifiers can be compared across every 'Formula' and 'Stockpile'.
+  class ResourceRegistry
+  {
+    private:
+    std::unordered_map<std::string, ResourceId> IdsByName;
+    std::deque<std::string> NamesById;
+    mutable std::shared_mutex RegistryMutex;
+
+    ResourceRegistry();
+
+    public:
+    ResourceRegistry(const ResourceRegistry& other) = delete;
+    ResourceRegistry& operator=(const ResourceRegistry& other) = delete;
+
+    static ResourceRegistry& Instance();
+
+    ResourceId Intern(const std::string& Name);
+    std::optional<ResourceId> Find(const std::string& Name) const;
+    const std::string& GetName(ResourceId Id) const;
+    std::size_t Size() const;
+  };
+}//[NAMESPACE]: ResourceConversion
+#endif /*ResourceRegistry_h*/
@@ -0,0 +1,180 @@
+//[FILE]: SegmentedSlots.h
+//[DESC]: This file defines the 'SegmentedSlots' class template, a table of slots indexed by a dense id
+//        (a 'ResourceId') that grows while other threads use it, without a lock and without ever
+//        moving a slot. The table is a fixed directory of segments; segment k holds 64 << k ids, so
+//        the segments double in size and a handful of them cover every 32-bit id:
+//
+//          ids      [0, 64)   [64, 192)   [192, 448)   ...
+//          segment  0         1           2            ...   (allocated on first use)
+//
+//        Every id owns 'Width' consecutive elements per segment row, laid out as 'Width' rows of
+//        'Length' elements: element (w, id) of a segment is 'Segment[w * Length + Offset]'. A width
+//        of 1 gives one element per id; 'ShardedQuantities' uses one row per shard.
+//
+//        A missing segment is allocated and published with one compare-and-swap; the thread that
+//        loses the race frees its copy and uses the winner's. A published segment stays in place
+//        until the table is reset, so pointers into it stay valid while other threads grow the table.
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: 'Segments[k]' is nullptr or points to 'Width * (FirstLength << k)' default-constructed
+//             elements, and never changes again until 'Reset(...)' or the destructor.
+//[INVARIANT]: 'Extent' is the end of the highest segment published so far.
+//
+//[USAGE]
+//{
+// SegmentedSlots<Slot> Slots;                                  -> width 1, nothing allocated
+// SegmentedSlots<Slot>::Position Where = Slots.Obtain(Id);     -> any thread, allocates if needed
+// Where.Segment[Where.Offset];                                 -> the slot of 'Id'
+// Slots.Find(Id).Segment == nullptr;                           -> no slot yet, nothing allocated
+//}
+//
+//[NOTE]: 'Find(...)' and 'Obtain(...)' may run on any number of threads at once. Construction, moves
+//        and 'Reset(...)' must not race with anything.
+//
+//[NAMESPACE]: {ResourceConversion} Encapsulates the 'Formula', 'Plan', 'ExecutablePlan', 'Stockpile'
+//             and supporting classes.
+#ifndef SegmentedSlots_h
+#define SegmentedSlots_h
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+namespace ResourceConversion
+{
+  template<typename T>
+  class SegmentedSlots
+  {
+    public:
+    //[DESC]: Where an id lives: its elements are 'Segment[w * Length + Offset]', 'Segment' is nullptr if
+    //        the segment was not allocated yet
+    struct Position
+    {
+      T* Segment = nullptr;
+      std::size_t Offset = 0;
+      std::size_t Length = 0;
+    };
+
+    static constexpr std::size_t FirstLength = 64;
+    static constexpr std::size_t SegmentCount = 27;
+    //[NOTE]: Ids below this fit, which covers every 32-bit 'ResourceId'
+    static constexpr std::size_t MaxSize = FirstLength * ((std::size_t{1} << SegmentCount) - 1);
+
+    private:
+    std::size_t Width = 1;
+    std::atomic<T*> Segments[SegmentCount] = {};
+    std::atomic<std::size_t> Extent{0};
+
+    //[DESC]: The segment of an id and the first id of that segment
+    static inline std::size_t SegmentOf(std::size_t Index, std::size_t& Base)
+    {
+      std::size_t Row = Index / FirstLength + 1;
+      std::size_t Segment = 0;
+      while(Row >>= 1) { Segment++; }
+      Base = FirstLength * ((std::size_t{1} << Segment) - 1);
+      return Segment;
+    }
+
+    inline void Release()
+    {
+      for(std::atomic<T*>& Segment : Segments) { delete[] Segment.exchange(nullptr, std::memory_order_relaxed); }
+      Extent.store(0, std::memory_order_relaxed);
+    }
+
+    inline void TakeFrom(SegmentedSlots& other)
+    {
+      Width = other.Width;
+      for(std::size_t k = 0; k < SegmentCount; k++)
+      {
+        Segments[k].store(other.Segments[k].exchange(nullptr, std::memory_order_relaxed), std::memory_order_relaxed);
+      }
+      Extent.store(other.Extent.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    public:
+    SegmentedSlots() = default;
+    explicit SegmentedSlots(std::size_t Width_) : Width(Width_) {}
+    ~SegmentedSlots() { Release(); }
+
+    SegmentedSlots(const SegmentedSlots& other) = delete;
+    SegmentedSlots& operator=(const SegmentedSlots& other) = delete;
+
+    //[DESC]: Move constructor, 'other' is left empty with the same width
+    SegmentedSlots(SegmentedSlots&& other) noexcept { TakeFrom(other); }
+
+    //[DESC]: Move assignment operator, the segments held before are freed, 'other' is left empty
+    SegmentedSlots& operator=(SegmentedSlots&& other) noexcept
+    {
+      if(this != &other)
+      {
+        Release();
+        TakeFrom(other);
+      }
+      return *this;
+    }
+
+    //[DESC]: Free every segment and set the number of elements per id
+    //[PRE]: No other thread uses the table
+    //[POST]: Nothing is allocated, 'Size()' is 0
+    void Reset(std::size_t Width_)
+    {
+      Release();
+      Width = Width_;
+    }
+
+    //[DESC]: Locate an id without allocating
+    //[PRE]: None
+    //[RETURN]: The position of the id; 'Segment' is nullptr if its segment does not exist yet or the
+    //          id is beyond 'MaxSize'
+    Position Find(std::size_t Index) const
+    {
+      if(Index >= MaxSize) { return Position(); }
+      std::size_t Base = 0;
+      const std::size_t Segment = SegmentOf(Index, Base);
+      return Position{Segments[Segment].load(std::memory_order_acquire), Index - Base, FirstLength << Segment};
+    }
+
+    //[DESC]: Locate an id, allocating its segment if it does not exist yet
+    //[PRE]: None
+    //[POST]: The segment of the id exists, its new elements are default-constructed
+    //[RETURN]: The position of the id, 'Segment' is never nullptr
+    //[THROW]: 'std::out_of_range' If the id is beyond 'MaxSize'
+    //[THROW]: 'std::bad_alloc' If the segment cannot be allocated, the table is unchanged
+    Position Obtain(std::size_t Index)
+    {
+      if(Index >= MaxSize) { throw std::out_of_range("[SS]Obtain(...) [Index beyond the last segment]"); }
+
+      std::size_t Base = 0;
+      const std::size_t Segment = SegmentOf(Index, Base);
+      const std::size_t Length = FirstLength << Segment;
+      T* Current = Segments[Segment].load(std::memory_order_acquire);
+      if(Current == nullptr)
+      {
+        T* Fresh = new T[Width * Length]();
+        if(Segments[Segment].compare_exchange_strong(Current, Fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+          Current = Fresh;
+          std::size_t Reached = Extent.load(std::memory_order_relaxed);
+          while(Reached < Base + Length && !Extent.compare_exchange_weak(Reached, Base + Length, std::memory_order_release, std::memory_order_relaxed)) {}
+        }
+        else
+        {
+          delete[] Fresh;
+        }
+      }
+      return Position{Current, Index - Base, Length};
+    }
+
+    //[DESC]: One past the highest id whose segment was published, the bound for a walk over all ids
+    inline std::size_t Size() const { return Extent.load(std::memory_order_acquire); }
+    inline std::size_t GetWidth() const { return Width; }
+  };
+}//[NAMESPACE]: ResourceConversion
+#endif /*SegmentedSlots_h*/
@@ -0,0 +1,279 @@
+//[FILE]: ShardedQuantities.cpp
+//[DESC]: This file contains the implementation of the 'ShardedQuantities' class {[SEE]: ShardedQuantities.h}
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: Counter (s, r) lives in line 'r / CountersPerLine' of row 's' of its segment, so two
+//             shards never share a cache line.
+//[INVARIANT]: The lines of a resource are allocated before it is marked present; a reader that sees the
+//             flag (acquire) finds them.
+//[INVARIANT]: Every change of a counter is a single atomic operation, units are never created or lost,
+//             only moved between shards (except units that no longer fit, {[SEE]: Rebalance(ResourceId)}).
+//[INVARIANT]: No counter exceeds 'ShardLimit()', so the sum over the shards never exceeds 'Capacity()'
+//             and never wraps.
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "ShardedQuantities.h"
+
+namespace ResourceConversion
+{
+  //[DESC]: Get the counter of one resource in one shard
+  //[PARAM]: 'Where' The position of the resource's line, from 'Lines.Find(...)' or 'Lines.Obtain(...)'
+  //[PRE]: 'Shard' < 'ShardCount' and the segment of 'Where' exists
+  //[RETURN]: Reference to the counter
+  inline std::atomic<size_t>& ShardedQuantities::Counter(const LinePosition& Where, size_t Shard, ResourceId Resource)
+  {
+    return Where.Segment[Shard * Where.Length + Where.Offset].Counters[Resource % CountersPerLine];
+  }
+
+  //[DESC]: Get the shard of the calling thread
+  //[PARAM]: 'ShardCount_' The number of shards, a power of two
+  //[PRE]: None
+  //[POST]: On the first call a thread draws the next ticket, threads are spread round-robin
+  //[RETURN]: The index of the calling thread's shard
+  size_t ShardedQuantities::LocalShard(size_t ShardCount_)
+  {
+    static std::atomic<size_t> NextTicket{0};
+    thread_local const size_t Ticket = NextTicket.fetch_add(1, std::memory_order_relaxed);
+    return Ticket & (ShardCount_ - 1);
+  }
+
+  //[DESC]: Add up to 'Amount' units to the counters of a resource, without pushing any past 'ShardLimit()'
+  //[PARAM]: 'Where' The position of the resource's line
+  //[PARAM]: 'Resource' The interned identifier of the resource
+  //[PARAM]: 'Amount' The number of units
+  //[PARAM]: 'FirstShard' The shard filled first, the others follow in order
+  //[PRE]: The lines of 'Resource' are allocated
+  //[POST]: The units that fit were added
+  //[RETURN]: The units that did not fit, 0 unless the total is close to 'Capacity()'
+  size_t ShardedQuantities::Place(const LinePosition& Where, ResourceId Resource, size_t Amount, size_t FirstShard)
+  {
+    const size_t Limit = ShardLimit();
+    for(size_t Visited = 0; Visited < ShardCount && Amount > 0; Visited++)
+    {
+      std::atomic<size_t>& Value = Counter(Where, (FirstShard + Visited) & (ShardCount - 1), Resource);
+      size_t Current = Value.load(std::memory_order_acquire);
+      size_t Portion = 0;
+      do
+      {
+        Portion = std::min(Limit - Current, Amount);
+        if(Portion == 0) { break; }
+      } while(!Value.compare_exchange_weak(Current, Current + Portion, std::memory_order_acq_rel, std::memory_order_acquire));
+      Amount -= Portion;
+    }
+    return Amount;
+  }
+
+  //[DESC]: Remove up to 'Amount' units of a resource, from the caller's shard first
+  //[PARAM]: 'Where' The position of the resource's line
+  //[PARAM]: 'Resource' The interned identifier of the resource
+  //[PARAM]: 'Amount' The number of units
+  //[PRE]: The lines of 'Resource' are allocated
+  //[POST]: The units gathered were removed
+  //[RETURN]: The number of units gathered, below 'Amount' if the shards ran dry
+  size_t ShardedQuantities::Gather(const LinePosition& Where, ResourceId Resource, size_t Amount)
+  {
+    const size_t Local = LocalShard(ShardCount);
+    size_t Gathered = 0;
+    for(size_t Visited = 0; Visited < ShardCount && Gathered < Amount; Visited++)
+    {
+      std::atomic<size_t>& Value = Counter(Where, (Local + Visited) & (ShardCount - 1), Resource);
+      size_t Current = Value.load(std::memory_order_acquire);
+      size_t Portion = 0;
+      do
+      {
+        Portion = std::min(Current, Amount - Gathered);
+        if(Portion == 0) { break; }
+      } while(!Value.compare_exchange_weak(Current, Current - Portion, std::memory_order_acq_rel, std::memory_order_acquire));
+      Gathered += Portion;
+    }
+    return Gathered;
+  }
+
+  //[DESC]: Default constructor
+  //[PRE]: None
+  //[POST]: An empty object is constructed, 'Size()' is 0
+  ShardedQuantities::ShardedQuantities() {}
+
+  //[DESC]: Move constructor
+  //[PRE]: 'other' has to be an !rvalue! reference
+  //[POST]: Ownership is transfered, 'other' is empty
+  ShardedQuantities::ShardedQuantities(ShardedQuantities&& other) noexcept
+    : ShardCount(std::exchange(other.ShardCount, 1)), Lines(std::move(other.Lines)), Present(std::move(other.Present)) {}
+
+  //[DESC]: Move assignment operator
+  //[PRE]: 'other' has to be an !rvalue! reference
+  //[POST]: Data is swapped
+  ShardedQuantities& ShardedQuantities::operator=(ShardedQuantities&& other) noexcept
+  {
+    if(this == &other) { return *this; }
+
+    std::swap(ShardCount, other.ShardCount);
+    std::swap(Lines, other.Lines);
+    std::swap(Present, other.Present);
+    return *this;
+  }
+
+  //[DESC]: Drop every quantity and pick the number of shards
+  //[PRE]: No other thread uses the object
+  //[POST]: No resource is present and nothing is allocated. The number of shards is the number of
+  //        hardware threads rounded up to a power of two.
+  void ShardedQuantities::Reset()
+  {
+    size_t Shards = 1;
+    while(Shards < std::thread::hardware_concurrency()) { Shards <<= 1; }
+
+    ShardCount = Shards;
+    Lines.Reset(ShardCount);
+    Present.Reset(1);
+  }
+
+  //[DESC]: Release all storage
+  //[PRE]: No other thread uses the object
+  //[POST]: 'Size()' is 0
+  void ShardedQuantities::Clear()
+  {
+    Lines.Reset(ShardCount);
+    Present.Reset(1);
+  }
+
+  //[DESC]: Set the quantity of a resource, spreading it evenly over the shards
+  //[PARAM]: 'Resource' The interned identifier of the resource
+  //[PARAM]: 'Quantity' The quantity to store
+  //[PRE]: No other thread uses the object
+  //[POST]: The resource is present and holds 'Quantity', its counters are allocated if needed
+  //[THROW]: 'std::overflow_error' If 'Quantity' > 'Capacity()', nothing is stored
+  void ShardedQuantities::Store(ResourceId Resource, size_t Quantity)
+  {
+    if(Quantity > Capacity()) { throw std::overflow_error("[SQ]Store(...) [Quantity overflow]"); }
+
+    const LinePosition Where = Lines.Obtain(Resource / CountersPerLine);
+    const SegmentedSlots<std::atomic<bool>>::Position Flag = Present.Obtain(Resource);
+    for(size_t Shard = 0; Shard < ShardCount; Shard++)
+    {
+      const size_t Share = Quantity / ShardCount + (Shard < Quantity % ShardCount ? 1 : 0);
+      Counter(Where, Shard, Resource).store(Share, std::memory_order_relaxed);
+    }
+    Flag.Segment[Flag.Offset].store(true, std::memory_order_release);
+  }
+
+  //[DESC]: Check whether a resource is present
+  //[RETURN]: 'true' if the resource was stored or added, 'false' if otherwise
+  bool ShardedQuantities::Has(ResourceId Resource) const
+  {
+    const SegmentedSlots<std::atomic<bool>>::Position Flag = Present.Find(Resource);
+    return Flag.Segment != nullptr && Flag.Segment[Flag.Offset].load(std::memory_order_acquire);
+  }
+
+  //[DESC]: Get the exact quantity of a resource by summing its shards
+  //[PRE]: None
+  //[POST]: None
+  //[RETURN]: The quantity, 0 if the resource is not present
+  //[NOTE]: Exact whenever no other thread changes the resource during the call. Under concurrent
+  //        updates the sum may mix counters read at slightly different times. It never exceeds
+  //        'Capacity()', every counter stays within 'ShardLimit()'.
+  size_t ShardedQuantities::Load(ResourceId Resource) const
+  {
+    if(!Has(Resource)) { return 0; }
+
+    const LinePosition Where = Lines.Find(Resource / CountersPerLine);
+    size_t Total = 0;
+    for(size_t Shard = 0; Shard < ShardCount; Shard++)
+    {
+      Total += Counter(Where, Shard, Resource).load(std::memory_order_acquire);
+    }
+    return Total;
+  }
+
+  //[DESC]: Take 'Amount' units of a resource, all of them or none
+  //[PARAM]: 'Resource' The interned identifier of the resource
+  //[PARAM]: 'Amount' The number of units
+  //[PRE]: None
+  //[POST]: On success 'Amount' units were removed, otherwise the total is unchanged
+  //[RETURN]: 'true' if the units were taken, 'false' if the resource is absent or short
+  //[NOTE]: The caller's shard is tried first. Only when it runs short are the other shards visited,
+  //        taking what they hold; if the total still falls short the units gathered so far are put
+  //        back, starting with the caller's shard. A 'false' can therefore also mean that other threads
+  //        were moving the last units at the same time.
+  bool ShardedQuantities::Take(ResourceId Resource, size_t Amount)
+  {
+    if(!Has(Resource)) { return false; }
+    if(Amount == 0) { return true; }
+
+    const LinePosition Where = Lines.Find(Resource / CountersPerLine);
+    const size_t Gathered = Gather(Where, Resource, Amount);
+    if(Gathered == Amount) { return true; }
+
+    Place(Where, Resource, Gathered, LocalShard(ShardCount));
+    return false;
+  }
+
+  //[DESC]: Add 'Amount' units of a resource to the caller's shard
+  //[PARAM]: 'Resource' The interned identifier of the resource
+  //[PARAM]: 'Amount' The number of units
+  //[PRE]: None
+  //[POST]: The resource is present and its quantity grew by 'Amount', its counters are allocated if
+  //        needed (safe while other threads use the object)
+  //[THROW]: 'std::overflow_error' If the total would exceed 'Capacity()', nothing is added
+  //[NOTE]: The caller's shard takes the units while it has room, only then are the others filled. On
+  //        overflow the units placed so far are gathered back; other threads may have consumed some of
+  //        them in between, which then counts as a completed part of the addition.
+  void ShardedQuantities::Add(ResourceId Resource, size_t Amount)
+  {
+    const LinePosition Where = Lines.Obtain(Resource / CountersPerLine);
+    const SegmentedSlots<std::atomic<bool>>::Position Flag = Present.Obtain(Resource);
+    const size_t Left = Place(Where, Resource, Amount, LocalShard(ShardCount));
+    if(Left != 0)
+    {
+      Gather(Where, Resource, Amount - Left);
+      throw std::overflow_error("[SQ]Add(...) [Quantity overflow]");
+    }
+
+    std::atomic<bool>& Marked = Flag.Segment[Flag.Offset];
+    if(!Marked.load(std::memory_order_relaxed)) { Marked.store(true, std::memory_order_release); }
+  }
+
+  //[DESC]: Spread the quantity of one resource evenly over the shards
+  //[PARAM]: 'Resource' The interned identifier of the resource
+  //[PRE]: None
+  //[POST]: Without concurrent updates every shard holds the total / 'ShardCount' units (+1)
+  //[NOTE]: Safe to call while other threads work on the resource, the total is preserved; their
+  //        'Take' calls may fail while the units are in flight. If other threads fill the shards up to
+  //        'Capacity()' meanwhile, the units that no longer fit are dropped: the quantity saturates at
+  //        'Capacity()' instead of wrapping.
+  void ShardedQuantities::Rebalance(ResourceId Resource)
+  {
+    if(!Has(Resource)) { return; }
+
+    const LinePosition Where = Lines.Find(Resource / CountersPerLine);
+    //[NOTE]: Every counter is at most 'ShardLimit()', so the total cannot wrap
+    size_t Total = 0;
+    for(size_t Shard = 0; Shard < ShardCount; Shard++)
+    {
+      Total += Counter(Where, Shard, Resource).exchange(0, std::memory_order_acq_rel);
+    }
+
+    size_t Carry = 0;
+    for(size_t Shard = 0; Shard < ShardCount; Shard++)
+    {
+      const size_t Share = Total / ShardCount + (Shard < Total % ShardCount ? 1 : 0);
+      Carry = Place(Where, Resource, Share + Carry, Shard);
+    }
+  }
+
+  //[DESC]: Spread the quantity of every resource evenly over the shards {[SEE]: Rebalance(ResourceId)}
+  void ShardedQuantities::Rebalance()
+  {
+    for(size_t r = 0; r < Size(); r++) { Rebalance(static_cast<ResourceId>(r)); }
+  }
+}//[NAMESPACE]: ResourceConversion
@@ -0,0 +1,120 @@
+//[FILE]: ShardedQuantities.h
+//[DESC]: This file defines the 'ShardedQuantities' class, the storage behind 'Stockpile's 'Sharded'
+//        mode. The quantity of every resource is split across several shards (one per hardware
+//        thread, rounded up to a power of two). A thread adds to and takes from its own shard, so
+//        producers and consumers of the same hot resource on different cores touch different cache
+//        lines. Only a thread whose shard runs dry visits the other shards, taking what it needs from
+//        them (on-demand reconciliation); 'Rebalance(...)' spreads a quantity evenly again.
+//
+//          segment 0:  [ shard 0: r0 r1 ... r7 | r8 ... r511 ][ shard 1: r0 r1 ... ] ...
+//          segment 1:  [ shard 0: r512 ... r1535 ][ shard 1: r512 ... ] ...   (allocated on first use)
+//
+//        Every shard holds one counter per resource, eight to a cache line, and no line holds counters
+//        of two shards. The lines live in segments that are allocated the first time a resource in
+//        their range is stored or added and never move {[SEE]: SegmentedSlots.h}, so a resource
+//        interned while other threads work on the object can be added without a lock.
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: The quantity of a resource is the sum of its counters over all shards.
+//[INVARIANT]: A resource that is not present holds 0 in every shard.
+//[INVARIANT]: A resource marked present has its counters allocated.
+//[INVARIANT]: 'ShardCount' is a power of two.
+//[INVARIANT]: Every counter holds at most 'ShardLimit()', the quantity of a resource at most 'Capacity()'.
+//
+//[USAGE]
+//{
+// ShardedQuantities Quantities;
+// Quantities.Reset();                   -> one shard per hardware thread, nothing allocated
+// Quantities.Store(Iron, 100);          -> single-threaded setup, spread over all shards
+//
+// Quantities.Add(Iron, 5);              -> any thread, adds to the caller's shard
+// Quantities.Take(Iron, 7);             -> any thread, 'false' and no change if short
+// Quantities.Load(Iron);                -> sum of all shards
+//}
+//
+//[DEPENDENCIES]:
+//       [INTERNAL]:
+//          - Member, Helper, Utility methods
+//          - Private Data Members
+//
+//        [EXTERNAL]:
+//          - 'std::atomic'
+//          - 'ResourceId' {[SEE]: ResourceRegistry.h}
+//          - 'SegmentedSlots' {[SEE]: SegmentedSlots.h}
+//
+//[NAMESPACE]: {ResourceConversion} Encapsulates the 'Formula', 'Plan', 'ExecutablePlan', 'Stockpile'
+//             and supporting classes.
+#ifndef ShardedQuantities_h
+#define ShardedQuantities_h
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+
+#include "ResourceRegistry.h"
+#include "SegmentedSlots.h"
+
+namespace ResourceConversion
+{
+  class ShardedQuantities
+  {
+    private:
+    static constexpr size_t CountersPerLine = 8;
+
+    struct alignas(64) CacheLine
+    {
+      std::atomic<size_t> Counters[CountersPerLine] = {};
+    };
+
+    using LinePosition = SegmentedSlots<CacheLine>::Position;
+
+    size_t ShardCount = 1;
+    //[NOTE]: Indexed by 'Resource / CountersPerLine', one row of lines per shard
+    SegmentedSlots<CacheLine> Lines = SegmentedSlots<CacheLine>();
+    SegmentedSlots<std::atomic<bool>> Present = SegmentedSlots<std::atomic<bool>>();
+
+    static inline std::atomic<size_t>& Counter(const LinePosition& Where, size_t Shard, ResourceId Resource);
+    static size_t LocalShard(size_t ShardCount_);
+    size_t Place(const LinePosition& Where, ResourceId Resource, size_t Amount, size_t FirstShard);
+    size_t Gather(const LinePosition& Where, ResourceId Resource, size_t Amount);
+
+    //[NOTE]: The most one counter holds, so that the sum over all shards fits in 'size_t'
+    inline size_t ShardLimit() const { return std::numeric_limits<size_t>::max() / ShardCount; }
+
+    public:
+    ShardedQuantities();
+    ShardedQuantities(ShardedQuantities&& other) noexcept;
+    ShardedQuantities& operator=(ShardedQuantities&& other) noexcept;
+    ~ShardedQuantities() = default;
+
+    ShardedQuantities(const ShardedQuantities& other) = delete;
+    ShardedQuantities& operator=(const ShardedQuantities& other) = delete;
+
+    void Reset();
+    void Clear();
+    void Store(ResourceId Resource, size_t Quantity);
+
+    bool Has(ResourceId Resource) const;
+    size_t Load(ResourceId Resource) const;
+    bool Take(ResourceId Resource, size_t Amount);
+    void Add(ResourceId Resource, size_t Amount);
+
+    void Rebalance(ResourceId Resource);
+    void Rebalance();
+
+    //[NOTE]: One past the highest resource that may be present, the bound for a walk over all resources
+    inline size_t Size() const { return Present.Size(); }
+    //[NOTE]: Every resource below this can be added
+    static constexpr size_t MaxSize = SegmentedSlots<std::atomic<bool>>::MaxSize;
+    inline size_t GetShardCount() const { return ShardCount; }
+    //[NOTE]: The largest quantity of one resource, a few units below 'std::numeric_limits<size_t>::max()'
+    inline size_t Capacity() const { return ShardLimit() * ShardCount; }
+  };
+}//[NAMESPACE]: ResourceConversion
+#endif /*ShardedQuantities_h*/
@@ -0,0 +1,52 @@
+//[FILE]: Span.h
+//[DESC]: This file defines the 'Span' class template, a non-owning view of a contiguous array
+//        (pointer + length), the C++17 stand-in for 'std::span'. A span never allocates and never
+//        frees; it is only valid while the array it views is alive and not reallocated.
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: 'Data' points to at least 'Length' elements, or 'Length' is 0.
+//
+//[USAGE]
+//{
+// Span<const unsigned int> Quantities(Pointer, Count);
+// for(unsigned int Quantity : Quantities) { ... }
+// Quantities[0]; Quantities.size(); Quantities.data();
+//}
+//
+//[NAMESPACE]: {ResourceConversion} Encapsulates the 'Formula', 'Plan', 'ExecutablePlan', 'Stockpile'
+//             and supporting classes.
+#ifndef Span_h
+#define Span_h
+
+#include <cstddef>
+
+namespace ResourceConversion
+{
+  template<typename T>
+  class Span
+  {
+    private:
+    T* Data = nullptr;
+    std::size_t Length = 0;
+
+    public:
+    constexpr Span() = default;
+    constexpr Span(T* Data_, std::size_t Length_) : Data(Data_), Length(Length_) {}
+
+    constexpr T* data() const { return Data; }
+    constexpr std::size_t size() const { return Length; }
+    constexpr bool empty() const { return Length == 0; }
+
+    constexpr T& operator[](std::size_t Index) const { return Data[Index]; }
+
+    constexpr T* begin() const { return Data; }
+    constexpr T* end() const { return Data + Length; }
+  };
+}//[NAMESPACE]: ResourceConversion
+#endif /*Span_h*/
@@ -0,0 +1,101 @@
+//[FILE]: StepGraph.cpp
+//[DESC]: This file contains the implementation of the 'StepGraph' class {[SEE]: StepGraph.h}
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: While steps are added, 'LastStepOf[r]' is the last step that touched register r, or
+//             'NoStep'. 'Edges' is ordered by target step.
+
+#include <algorithm>
+#include <limits>
+
+#include "StepGraph.h"
+
+namespace ResourceConversion
+{
+  namespace
+  {
+    constexpr std::uint32_t NoStep = std::numeric_limits<std::uint32_t>::max();
+  }
+
+  //[DESC]: Default constructor
+  //[PRE]: None
+  //[POST]: An empty graph is constructed, 'StepCount()' is 0
+  StepGraph::StepGraph() {}
+
+  //[DESC]: Start a new graph
+  //[PARAM]: 'RegisterCount' The number of distinct resources the steps refer to
+  //[PRE]: None
+  //[POST]: The graph is empty and ready for 'AddStep(...)'
+  void StepGraph::Reset(size_t RegisterCount)
+  {
+    Predecessors.clear();
+    SuccessorOffsets.clear();
+    Successors.clear();
+    Edges.clear();
+    CriticalPath = 0;
+    LastStepOf.assign(RegisterCount, NoStep);
+  }
+
+  //[DESC]: Add the edge from the last step on 'Register' to 'Step', unless it is already there
+  //[PARAM]: 'FirstEdge' The first edge that ends in 'Step'
+  //[PRE]: 'Step' is the step being added
+  //[POST]: 'Step' is the last step on 'Register'
+  void StepGraph::Depend(std::uint32_t Step, std::uint32_t Register, size_t FirstEdge)
+  {
+    const std::uint32_t Previous = LastStepOf[Register];
+    LastStepOf[Register] = Step;
+    if(Previous == NoStep || Previous == Step) { return; }
+
+    for(size_t e = FirstEdge; e < Edges.size(); e++)
+    {
+      if(Edges[e].first == Previous) { return; }
+    }
+    Edges.emplace_back(Previous, Step);
+    Predecessors[Step]++;
+  }
+
+  //[DESC]: Add the next step of the plan
+  //[PARAM]: 'Inputs' The registers the step consumes
+  //[PARAM]: 'Outputs' The registers the step produces
+  //[PRE]: 'Reset(...)' was called, every register is below its 'RegisterCount'
+  //[POST]: The step depends on the last earlier step of each of its registers
+  void StepGraph::AddStep(Span<const std::uint32_t> Inputs, Span<const std::uint32_t> Outputs)
+  {
+    const std::uint32_t Step = static_cast<std::uint32_t>(Predecessors.size());
+    const size_t FirstEdge = Edges.size();
+    Predecessors.push_back(0);
+
+    for(std::uint32_t Register : Inputs) { Depend(Step, Register, FirstEdge); }
+    for(std::uint32_t Register : Outputs) { Depend(Step, Register, FirstEdge); }
+  }
+
+  //[DESC]: Lay the edges out as compressed rows and measure the critical path
+  //[PRE]: Every step was added
+  //[POST]: The successors of each step are sorted, the scratch data of the build is released
+  void StepGraph::Finish()
+  {
+    const size_t Count = Predecessors.size();
+    SuccessorOffsets.assign(Count + 1, 0);
+    for(const auto& [From, To] : Edges) { SuccessorOffsets[From + 1]++; }
+    for(size_t i = 0; i < Count; i++) { SuccessorOffsets[i + 1] += SuccessorOffsets[i]; }
+
+    std::vector<std::uint32_t> Next(SuccessorOffsets.begin(), SuccessorOffsets.end() - 1);
+    std::vector<size_t> Depth(Count, 1);
+    Successors.resize(Edges.size());
+    for(const auto& [From, To] : Edges)
+    {
+      Successors[Next[From]++] = To;
+      Depth[To] = std::max(Depth[To], Depth[From] + 1);
+    }
+    CriticalPath = Depth.empty() ? 0 : *std::max_element(Depth.begin(), Depth.end());
+
+    std::vector<std::uint32_t>().swap(LastStepOf);
+    std::vector<std::pair<std::uint32_t, std::uint32_t>>().swap(Edges);
+  }
+}//[NAMESPACE]: ResourceConversion
@@ -0,0 +1,92 @@
+//[FILE]: StepGraph.h
+//[DESC]: This file defines the 'StepGraph' class, the dependency DAG between the steps of a compiled
+//        plan {[SEE]: CompiledPlan.h}. Step j depends on step i < j when both touch one resource
+//        (consume or produce it): their order changes the result, every other pair commutes. Only the
+//        edge to the last earlier step on each resource is kept, the rest follow transitively.
+//
+//          0: Ore   -> Metal          0 --> 1 --> 3
+//          1: Metal -> Tool
+//          2: Wood  -> Plank          2 -------> 3        (0 and 2 may run at the same time)
+//          3: Tool, Plank -> Chair
+//
+//        The edges are stored as compressed rows (successors of step i are
+//        'Successors[SuccessorOffsets[i] .. SuccessorOffsets[i + 1])') together with the number of
+//        predecessors of each step, which is what a scheduler needs {[SEE]: WorkStealingPool.h}.
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: Every edge goes from a lower to a higher step index, so the graph is acyclic and plan
+//             order is a valid topological order.
+//[INVARIANT]: 'Predecessors[j]' is the number of edges ending in step j, no edge is stored twice.
+//
+//[USAGE]
+//{
+// StepGraph Graph;
+// Graph.Reset(RegisterCount);
+// Graph.AddStep(Inputs, Outputs);    -> once per step, in plan order
+// Graph.Finish();
+//
+// Graph.GetSuccessors(i); Graph.GetPredecessorCount(j); Graph.GetCriticalPath();
+//}
+//
+//[DEPENDENCIES]:
+//       [INTERNAL]:
+//          - Member, Helper, Utility methods
+//          - Private Data Members
+//
+//        [EXTERNAL]:
+//          - 'Span' {[SEE]: Span.h}
+//          - 'std::vector'
+//
+//[NAMESPACE]: {ResourceConversion} Encapsulates the 'Formula', 'Plan', 'ExecutablePlan', 'Stockpile'
+//             and supporting classes.
+#ifndef StepGraph_h
+#define StepGraph_h
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Span.h"
+
+namespace ResourceConversion
+{
+  class StepGraph
+  {
+    private:
+    std::vector<std::uint32_t> Predecessors = std::vector<std::uint32_t>();
+    std::vector<std::uint32_t> SuccessorOffsets = std::vector<std::uint32_t>();
+    std::vector<std::uint32_t> Successors = std::vector<std::uint32_t>();
+    size_t CriticalPath = 0;
+
+    //[NOTE]: Only used while steps are added, emptied by 'Finish()'
+    std::vector<std::uint32_t> LastStepOf = std::vector<std::uint32_t>();
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> Edges = std::vector<std::pair<std::uint32_t, std::uint32_t>>();
+
+    void Depend(std::uint32_t Step, std::uint32_t Register, size_t FirstEdge);
+
+    public:
+    StepGraph();
+
+    void Reset(size_t RegisterCount);
+    void AddStep(Span<const std::uint32_t> Inputs, Span<const std::uint32_t> Outputs);
+    void Finish();
+
+    inline size_t StepCount() const { return Predecessors.size(); }
+    inline size_t EdgeCount() const { return Successors.size(); }
+    inline size_t GetCriticalPath() const { return CriticalPath; }
+
+    inline std::uint32_t GetPredecessorCount(size_t Step) const { return Predecessors[Step]; }
+    inline Span<const std::uint32_t> GetSuccessors(size_t Step) const
+    {
+      return Span<const std::uint32_t>(Successors.data() + SuccessorOffsets[Step], SuccessorOffsets[Step + 1] - SuccessorOffsets[Step]);
+    }
+  };
+}//[NAMESPACE]: ResourceConversion
+#endif /*StepGraph_h*/
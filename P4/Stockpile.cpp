@@ -25,29 +25,41 @@
 #include <algorithm>
 #include <iterator>
 #include <functional>
+#include <optional>
+#include <stdexcept>
 
 #include "Stockpile.h"
 
 namespace ResourceConversion 
 {
-  //[DESC]: Reassigns the data encapsulated by the object upon calling the Move Constructor
+  //[DESC]: Reassigns the data encapsulated by 'other' to this object upon calling the Move Constructor
   //[PRE]: 'other' has to be a valid object and an !rvalue! reference
-  //[POST]: Data is re-assigned
+  //[POST]: Data is re-assigned, 'other' is left in a valid but unspecified state
   //[INVOKE]: Move-ctor
-  inline void Stockpile::ReassignData(Stockpile&& other) const 
+  inline void Stockpile::ReassignData(Stockpile&& other)
   {
-    other.ResourcesMap = ResourcesMap;
+    Mode = other.Mode;
+    ResourcesMap = std::move(other.ResourcesMap);
+    DenseQuantities = std::move(other.DenseQuantities);
+    ConcurrentSlots = std::move(other.ConcurrentSlots);
+    Shards = std::move(other.Shards);
+    Versions = std::move(other.Versions);
+    Version = other.Version;
+    CachedSnapshot = std::move(other.CachedSnapshot);
   }
 
   //[DESC]: Resets the data encapsulated by the object upon calling the Move Constructor
   //[PRE]: None
-  //[POST]: Data is cleared and the container ('ResourcesMap') is set to a default state
+  //[POST]: Data is cleared and the containers are set to a default state
   //[INVOKE]: Move-ctor
   inline void Stockpile::ResetData()
   {
-    if(ResourcesMap.empty()) {return;}
-
     ResourcesMap.clear();
+    DenseQuantities.clear();
+    ConcurrentSlots.Reset(1);
+    Shards.Clear();
+    Versions.Clear();
+    CachedSnapshot.reset();
   }
 
   //[DESC]: Resets the data encapsulated by the object upon calling the Move Assignemnet operator
@@ -56,34 +68,171 @@ namespace ResourceConversion
   //[INVOKE]: operator=(...&&)
   inline void Stockpile::SwapData(Stockpile&& other)
   {
+    std::swap(other.Mode, Mode);
     std::swap(other.ResourcesMap, ResourcesMap);
+    std::swap(other.DenseQuantities, DenseQuantities);
+    std::swap(other.ConcurrentSlots, ConcurrentSlots);
+    std::swap(other.Shards, Shards);
+    std::swap(other.Versions, Versions);
+    std::swap(other.Version, Version);
+    std::swap(other.CachedSnapshot, CachedSnapshot);
   }
 
   //[DESC]: Clear the data encapsulated by the object upon the object going out of scope
   //[PRE]: Object has to go out of scope
   //[POST]: Data is cleared
   //[INVOKE]: Dtor
-  inline void Stockpile::ClearData() { ResourcesMap.clear(); }
+  inline void Stockpile::ClearData() 
+  { 
+    ResourcesMap.clear(); 
+    DenseQuantities.clear();
+    ConcurrentSlots.Reset(1);
+    Shards.Clear();
+    Versions.Clear();
+    CachedSnapshot.reset();
+  }
+
+  //[DESC]: Locate the stored quantity of a resource in 'Map' or 'Dense' mode.
+  //[PARAM]: 'Resource' The interned identifier of the resource
+  //[PRE]: None
+  //[POST]: None
+  //[RETURN]: Pointer to the quantity, or 'nullptr' if the resource is not part of the stockpile
+  //[NOTE]: 'Dense' mode is a bounds check and an array read, 'Map' mode is a single hash lookup.
+  //        'Concurrent' mode is served by 'FindSlot(...)' instead.
+  inline size_t* Stockpile::FindQuantity(ResourceId Resource)
+  {
+    if(Mode == StorageMode::Dense)
+    {
+      if(Resource >= DenseQuantities.size() || DenseQuantities[Resource] == AbsentQuantity) { return nullptr; }
+      return &DenseQuantities[Resource];
+    }
+
+    auto it = ResourcesMap.find(Resource);
+    if(it == ResourcesMap.end()) { return nullptr; }
+    return &it -> second;
+  }
+
+  //[DESC]: Const overload of 'FindQuantity(...)'
+  //[RETURN]: Pointer to the quantity, or 'nullptr' if the resource is not part of the stockpile
+  inline const size_t* Stockpile::FindQuantity(ResourceId Resource) const
+  {
+    return const_cast<Stockpile*>(this) -> FindQuantity(Resource);
+  }
+
+  //[DESC]: Locate the atomic quantity of a resource in 'Concurrent' mode.
+  //[PARAM]: 'Resource' The interned identifier of the resource
+  //[PRE]: None
+  //[POST]: None
+  //[RETURN]: Pointer to the slot, or 'nullptr' if the segment of the resource was never allocated.
+  //          A slot may hold 'AbsentQuantity'.
+  inline std::atomic<size_t>* Stockpile::FindSlot(ResourceId Resource) const
+  {
+    const SegmentedSlots<ConcurrentSlot>::Position Where = ConcurrentSlots.Find(Resource);
+    if(Where.Segment == nullptr) { return nullptr; }
+    return &Where.Segment[Where.Offset].Quantity;
+  }
+
+  //[DESC]: Locate the atomic quantity of a resource in 'Concurrent' mode, allocating its slot if needed
+  //[PARAM]: 'Resource' The interned identifier of the resource
+  //[PRE]: None, safe while other threads use the stockpile {[SEE]: SegmentedSlots.h}
+  //[POST]: The resource has a slot, a new slot holds 'AbsentQuantity'
+  //[RETURN]: Reference to the slot
+  inline std::atomic<size_t>& Stockpile::ObtainSlot(ResourceId Resource)
+  {
+    const SegmentedSlots<ConcurrentSlot>::Position Where = ConcurrentSlots.Obtain(Resource);
+    return Where.Segment[Where.Offset].Quantity;
+  }
+
+  //[DESC]: Set the quantity of a resource, adding the resource if it is not part of the stockpile
+  //[PARAM]: 'Resource' The interned identifier of the resource
+  //[PARAM]: 'Quantity' The quantity to store
+  //[PRE]: 'Quantity' is not 'AbsentQuantity'
+  //[PRE]: In 'Concurrent', 'Sharded' and 'Versioned' mode no other thread uses the stockpile
+  //[POST]: The resource is part of the stockpile and holds 'Quantity'
+  inline void Stockpile::StoreQuantity(ResourceId Resource, size_t Quantity)
+  {
+    ++Version;
+    if(Mode == StorageMode::Map)
+    {
+      ResourcesMap.insert_or_assign(Resource, Quantity);
+      return;
+    }
+
+    if(Mode == StorageMode::Concurrent)
+    {
+      ObtainSlot(Resource).store(Quantity, std::memory_order_relaxed);
+      return;
+    }
+
+    if(Mode == StorageMode::Sharded)
+    {
+      Shards.Store(Resource, Quantity);
+      return;
+    }
+
+    if(Mode == StorageMode::Versioned)
+    {
+      Versions.Commit([Resource, Quantity](VersionedQuantities::Draft& Working) {
+        Working.Set(Resource, Quantity);
+        return true;
+      });
+      return;
+    }
+
+    if(Resource >= DenseQuantities.size())
+    {
+      DenseQuantities.resize(static_cast<size_t>(Resource) + 1, AbsentQuantity);
+    }
+    DenseQuantities[Resource] = Quantity;
+  }
 
   //[DESC]: Default constructor for the 'Stockpile' class
   //[NOTE]: Only use case should be heap allocations or allocating arrays
   //        Strongly discouraged since it encapsulates an 'std::unordered_map'
   //[PRE]: None
   //[POST]: Object is constructed
-  Stockpile::Stockpile() : ResourcesMap() {}
+  Stockpile::Stockpile() : ResourcesMap(), DenseQuantities() {}
 
   //[DESC]: Non-Default constructor for the 'Stockpile' class
   //[PARAM]: 'const std::unordered_map<std::string, size_t>& ResourcesMap_' 
   //         Container to be assigned to the encapsulated map
+  //[PARAM]: 'Mode_' Storage backing the quantities {[SEE]: Stockpile.h [STORAGE MODES]}
   //[PRE]: Resources map cannot be empty
-  //[THROW]: 'std::invalid_argument' if the Map is empty
-  //[POST]: Object is constructed
-  Stockpile::Stockpile(const std::unordered_map<std::string, size_t>& ResourcesMap_) : ResourcesMap(ResourcesMap_)
+  //[PRE]: No quantity may equal 'std::numeric_limits<size_t>::max()' in any mode but 'Map'
+  //[THROW]: 'std::invalid_argument' if the Map is empty or holds a reserved quantity
+  //[THROW]: 'std::overflow_error' in 'Sharded' mode if a quantity exceeds 'ShardedQuantities::Capacity()'
+  //[POST]: Object is constructed, every resource name is interned
+  Stockpile::Stockpile(const std::unordered_map<std::string, size_t>& ResourcesMap_, StorageMode Mode_) 
+    : Mode(Mode_), ResourcesMap(), DenseQuantities()
   {
     if(ResourcesMap_.empty()) 
     {
       throw std::invalid_argument("[S]Stockpile(...) [Map cannot be empty]");
     }
+
+    ResourceRegistry& Registry = ResourceRegistry::Instance();
+    if(Mode == StorageMode::Map)
+    {
+      ResourcesMap.reserve(ResourcesMap_.size());
+      for(const auto& [Name, Quantity] : ResourcesMap_)
+      {
+        ResourcesMap.emplace(Registry.Intern(Name), Quantity);
+      }
+      return;
+    }
+
+    if(Mode == StorageMode::Sharded) { Shards.Reset(); }
+    if(Mode == StorageMode::Versioned) { Versions.Reset(); }
+
+    for(const auto& [Name, Quantity] : ResourcesMap_)
+    {
+      if(Quantity == AbsentQuantity)
+      {
+        throw std::invalid_argument("[S]Stockpile(...) [Quantity is reserved outside of Map mode]");
+      }
+
+      StoreQuantity(Registry.Intern(Name), Quantity);
+    }
   }
 
   //[DESC]: Destructor for the 'Stockpile' class
@@ -104,7 +253,7 @@ namespace ResourceConversion
   Stockpile::Stockpile(Stockpile&& other) noexcept
   {
     ReassignData(std::move(other));
-    ResetData();
+    other.ResetData();
   }
 #pragma GCC diagnostic pop
 
@@ -136,29 +285,17 @@ namespace ResourceConversion
   //[POST]: The quantity of the specified resource is updated to 'NewIncreasedQuantity'.
   //
   //[THROW]: 'std::runtime_error' If the specified resource doesn't exist in the Stockpile.
-  //[THROW]: 'std::domain_error' If NewIncreasedQuantity is equal to the current quantity.
   //[THROW]: 'std::runtime_error' If NewIncreasedQuantity is less than the current quantity.
   //
   //[RETURN]: 'true' if the quantity was sucessfuly increased, 'false' if otherwise
   bool Stockpile::IncreaseQuantity(const std::string& NameOfResource, const size_t& NewIncreasedQuantity)
   {
-    auto it = ResourcesMap.find(NameOfResource);
-    size_t InitialQuantityInMap = it -> second;
-
-    if(it == ResourcesMap.end()) 
-    { 
-      throw std::runtime_error("[S]IncreaseQuantity(...) [Invalid Key, Key does not exist]");
-    }
-
-    if(NewIncreasedQuantity < it -> second)
+    std::optional<ResourceId> Resource = ResourceRegistry::Instance().Find(NameOfResource);
+    if(!Resource.has_value())
     {
-      throw std::runtime_error("[S]IncreaseQuantity(...) [Invalid Quantity Parameter]");
+      throw std::runtime_error("[S]IncreaseQuantity(...) [Invalid Key, Key does not exist]");
     }
-
-    it -> second = NewIncreasedQuantity;
-
-    if(it -> second >= InitialQuantityInMap) { return true; }
-    return false;
+    return IncreaseQuantity(*Resource, NewIncreasedQuantity);
   }
 
   //[DESC]: Decrease the quantity of a resource in the Stockpile
@@ -174,47 +311,684 @@ namespace ResourceConversion
   //[POST]: The quantity of the specified resource is updated to 'NewDecreasedQuantity'.
   //
   //[THROW]: 'std::runtime_error' If the specified resource doesn't exist in the Stockpile.
-  //[THROW]: 'std::domain_error' If NewIncreasedQuantity is equal to the current quantity.
-  //[THROW]: 'std::runtime_error' If NewIncreasedQuantity is less than the current quantity.
+  //[THROW]: 'std::runtime_error' If NewDecreasedQuantity is greater than the current quantity.
   //
   //[RETURN]: 'true' if the quantity was sucessfuly increased, 'false' if otherwise
   bool Stockpile::DecreaseQuantity(const std::string& NameOfResource, const size_t& NewDecreasedQuantity)
   {
-    auto it = ResourcesMap.find(NameOfResource);
-    size_t InitialQuantityInMap = it -> second;
-    if(it == ResourcesMap.end()) 
+    std::optional<ResourceId> Resource = ResourceRegistry::Instance().Find(NameOfResource);
+    if(!Resource.has_value())
+    {
+      throw std::runtime_error("[S]DecreaseQuantity(...) [Invalid Key, Key does not exist]");
+    }
+    return DecreaseQuantity(*Resource, NewDecreasedQuantity);
+  }
+
+  //[DESC]: Get the quantity of a specific resource in the stockpile.
+  //[PRE]: The stockpile should be properly initialized and contain the resource.
+  //[POST]: None.
+  //[RETURN]: The quantity of the specified resource. If the resource is not found, it returns 0.
+  std::size_t Stockpile::GetResourceQuantity(const std::string& Resource) const
+  {
+    std::optional<ResourceId> Id = ResourceRegistry::Instance().Find(Resource);
+    if(!Id.has_value()) { return 0; }
+    return GetResourceQuantity(*Id);
+  }
+
+  //[DESC]: Check if the stockpile contains a specific resource.
+  //[PRE]: The stockpile should be properly initialized.
+  //[POST]: None.
+  //[RETURN]: True if the stockpile contains the specified resource, false otherwise.
+  bool Stockpile::HasResource(const std::string& Resource) const {
+    std::optional<ResourceId> Id = ResourceRegistry::Instance().Find(Resource);
+    if(!Id.has_value()) { return false; }
+    return HasResource(*Id);
+  }
+
+  //[DESC]: 'ResourceId' overload of 'IncreaseQuantity(...)', no string hashing is involved.
+  //[PARAM]: 'Resource' The interned identifier of the resource to increase
+  //[PARAM]: 'NewIncreasedQuantity' The new quantity to set for the resource.
+  //[PRE]: The resource must exist in the 'Stockpile'.
+  //[POST]: The quantity of the specified resource is updated to 'NewIncreasedQuantity'.
+  //[THROW]: 'std::runtime_error' If the specified resource doesn't exist in the Stockpile.
+  //[THROW]: 'std::runtime_error' If NewIncreasedQuantity is less than the current quantity.
+  //[RETURN]: 'true' if the quantity was sucessfuly increased, 'false' if otherwise
+  //[NOTE]: In 'Sharded' mode the total is read and then the difference added, which is not one atomic
+  //        step: the result is only exact if no other thread changes the resource during the call.
+  bool Stockpile::IncreaseQuantity(ResourceId Resource, const size_t& NewIncreasedQuantity)
+  {
+    if(Mode == StorageMode::Concurrent)
+    {
+      std::atomic<size_t>* Slot = FindSlot(Resource);
+      size_t Current = (Slot == nullptr) ? AbsentQuantity : Slot -> load(std::memory_order_acquire);
+      do
+      {
+        if(Current == AbsentQuantity)
+        {
+          throw std::runtime_error("[S]IncreaseQuantity(...) [Invalid Key, Key does not exist]");
+        }
+        if(NewIncreasedQuantity < Current || NewIncreasedQuantity == AbsentQuantity)
+        {
+          throw std::runtime_error("[S]IncreaseQuantity(...) [Invalid Quantity Parameter]");
+        }
+      } while(!Slot -> compare_exchange_weak(Current, NewIncreasedQuantity, std::memory_order_acq_rel, std::memory_order_acquire));
+      return true;
+    }
+
+    if(Mode == StorageMode::Sharded)
+    {
+      if(!Shards.Has(Resource))
+      {
+        throw std::runtime_error("[S]IncreaseQuantity(...) [Invalid Key, Key does not exist]");
+      }
+
+      const size_t Current = Shards.Load(Resource);
+      if(NewIncreasedQuantity < Current || NewIncreasedQuantity == AbsentQuantity)
+      {
+        throw std::runtime_error("[S]IncreaseQuantity(...) [Invalid Quantity Parameter]");
+      }
+      Shards.Add(Resource, NewIncreasedQuantity - Current);
+      return true;
+    }
+
+    if(Mode == StorageMode::Versioned)
+    {
+      return Versions.Commit([Resource, &NewIncreasedQuantity](VersionedQuantities::Draft& Working) {
+        const size_t Current = Working.Get(Resource);
+        if(Current == AbsentQuantity)
+        {
+          throw std::runtime_error("[S]IncreaseQuantity(...) [Invalid Key, Key does not exist]");
+        }
+        if(NewIncreasedQuantity < Current || NewIncreasedQuantity == AbsentQuantity)
+        {
+          throw std::runtime_error("[S]IncreaseQuantity(...) [Invalid Quantity Parameter]");
+        }
+        Working.Set(Resource, NewIncreasedQuantity);
+        return true;
+      });
+    }
+
+    size_t* Quantity = FindQuantity(Resource);
+    if(Quantity == nullptr) 
     { 
       throw std::runtime_error("[S]IncreaseQuantity(...) [Invalid Key, Key does not exist]");
     }
 
-    if(NewDecreasedQuantity > it -> second)
+    size_t InitialQuantityInMap = *Quantity;
+    if(NewIncreasedQuantity < InitialQuantityInMap || NewIncreasedQuantity == AbsentQuantity)
     {
       throw std::runtime_error("[S]IncreaseQuantity(...) [Invalid Quantity Parameter]");
     }
 
-    it -> second = NewDecreasedQuantity;
+    *Quantity = NewIncreasedQuantity;
+    ++Version;
 
-    if(it -> second >= InitialQuantityInMap) { return true; }
+    if(*Quantity >= InitialQuantityInMap) { return true; }
     return false;
   }
 
-  //[DESC]: Get the quantity of a specific resource in the stockpile.
-  //[PRE]: The stockpile should be properly initialized and contain the resource.
+  //[DESC]: 'ResourceId' overload of 'DecreaseQuantity(...)', no string hashing is involved.
+  //[PARAM]: 'Resource' The interned identifier of the resource to decrease
+  //[PARAM]: 'NewDecreasedQuantity' The new quantity to set for the resource.
+  //[PRE]: The resource must exist in the 'Stockpile'.
+  //[POST]: The quantity of the specified resource is updated to 'NewDecreasedQuantity'.
+  //[THROW]: 'std::runtime_error' If the specified resource doesn't exist in the Stockpile.
+  //[THROW]: 'std::runtime_error' If NewDecreasedQuantity is greater than the current quantity.
+  //[RETURN]: 'true' if the new quantity is not below the previous one, 'false' if otherwise
+  //[NOTE]: In 'Sharded' mode the total is read and then the difference taken, which is not one atomic
+  //        step: the result is only exact if no other thread changes the resource during the call. A
+  //        take that fails because others moved units meanwhile is retried on the new total.
+  bool Stockpile::DecreaseQuantity(ResourceId Resource, const size_t& NewDecreasedQuantity)
+  {
+    if(Mode == StorageMode::Concurrent)
+    {
+      std::atomic<size_t>* Slot = FindSlot(Resource);
+      size_t Current = (Slot == nullptr) ? AbsentQuantity : Slot -> load(std::memory_order_acquire);
+      do
+      {
+        if(Current == AbsentQuantity)
+        {
+          throw std::runtime_error("[S]DecreaseQuantity(...) [Invalid Key, Key does not exist]");
+        }
+        if(NewDecreasedQuantity > Current)
+        {
+          throw std::runtime_error("[S]DecreaseQuantity(...) [Invalid Quantity Parameter]");
+        }
+      } while(!Slot -> compare_exchange_weak(Current, NewDecreasedQuantity, std::memory_order_acq_rel, std::memory_order_acquire));
+      return NewDecreasedQuantity == Current;
+    }
+
+    if(Mode == StorageMode::Sharded)
+    {
+      if(!Shards.Has(Resource))
+      {
+        throw std::runtime_error("[S]DecreaseQuantity(...) [Invalid Key, Key does not exist]");
+      }
+
+      while(true)
+      {
+        const size_t Current = Shards.Load(Resource);
+        if(NewDecreasedQuantity > Current)
+        {
+          throw std::runtime_error("[S]DecreaseQuantity(...) [Invalid Quantity Parameter]");
+        }
+        if(Shards.Take(Resource, Current - NewDecreasedQuantity)) { return NewDecreasedQuantity == Current; }
+      }
+    }
+
+    if(Mode == StorageMode::Versioned)
+    {
+      bool Unchanged = false;
+      Versions.Commit([Resource, &NewDecreasedQuantity, &Unchanged](VersionedQuantities::Draft& Working) {
+        const size_t Current = Working.Get(Resource);
+        if(Current == AbsentQuantity)
+        {
+          throw std::runtime_error("[S]DecreaseQuantity(...) [Invalid Key, Key does not exist]");
+        }
+        if(NewDecreasedQuantity > Current)
+        {
+          throw std::runtime_error("[S]DecreaseQuantity(...) [Invalid Quantity Parameter]");
+        }
+        Unchanged = (NewDecreasedQuantity == Current);
+        Working.Set(Resource, NewDecreasedQuantity);
+        return true;
+      });
+      return Unchanged;
+    }
+
+    size_t* Quantity = FindQuantity(Resource);
+    if(Quantity == nullptr) 
+    { 
+      throw std::runtime_error("[S]DecreaseQuantity(...) [Invalid Key, Key does not exist]");
+    }
+
+    size_t InitialQuantityInMap = *Quantity;
+    if(NewDecreasedQuantity > InitialQuantityInMap)
+    {
+      throw std::runtime_error("[S]DecreaseQuantity(...) [Invalid Quantity Parameter]");
+    }
+
+    *Quantity = NewDecreasedQuantity;
+    ++Version;
+
+    if(*Quantity >= InitialQuantityInMap) { return true; }
+    return false;
+  }
+
+  //[DESC]: 'ResourceId' overload of 'GetResourceQuantity(...)'.
+  //[PRE]: None.
   //[POST]: None.
   //[RETURN]: The quantity of the specified resource. If the resource is not found, it returns 0.
-  std::size_t Stockpile::GetResourceQuantity(const std::string& Resource)
+  std::size_t Stockpile::GetResourceQuantity(ResourceId Resource) const
   {
-    if (ResourcesMap.find(Resource) != ResourcesMap.end()) { return ResourcesMap[Resource]; }
-    return 0;
+    if(Mode == StorageMode::Concurrent)
+    {
+      std::atomic<size_t>* Slot = FindSlot(Resource);
+      const size_t Quantity = (Slot == nullptr) ? AbsentQuantity : Slot -> load(std::memory_order_acquire);
+      return (Quantity == AbsentQuantity) ? 0 : Quantity;
+    }
+
+    if(Mode == StorageMode::Sharded) { return Shards.Load(Resource); }
+    if(Mode == StorageMode::Versioned) { return Versions.Load(Resource); }
+
+    const size_t* Quantity = FindQuantity(Resource);
+    if(Quantity == nullptr) { return 0; }
+    return *Quantity;
   }
 
-  //[DESC]: Check if the stockpile contains a specific resource.
-  //[PRE]: The stockpile should be properly initialized.
+  //[DESC]: 'ResourceId' overload of 'HasResource(...)'.
+  //[PRE]: None.
   //[POST]: None.
   //[RETURN]: True if the stockpile contains the specified resource, false otherwise.
-  bool Stockpile::HasResource(const std::string& Resource) const {
-    if(ResourcesMap.find(Resource) != ResourcesMap.end()) { return true; }
+  bool Stockpile::HasResource(ResourceId Resource) const
+  {
+    if(Mode == StorageMode::Concurrent)
+    {
+      std::atomic<size_t>* Slot = FindSlot(Resource);
+      return Slot != nullptr && Slot -> load(std::memory_order_acquire) != AbsentQuantity;
+    }
+
+    if(Mode == StorageMode::Sharded) { return Shards.Has(Resource); }
+    if(Mode == StorageMode::Versioned) { return Versions.Has(Resource); }
+
+    return FindQuantity(Resource) != nullptr;
+  }
+
+  //[DESC]: Take 'Amount' units of a resource out of the stockpile.
+  //[PARAM]: 'Resource' The interned identifier of the resource
+  //[PARAM]: 'Amount' The number of units to subtract
+  //[PRE]: None.
+  //[POST]: On success the quantity is lowered by 'Amount', otherwise the stockpile is unchanged
+  //[RETURN]: 'true' if the resource is present and holds at least 'Amount' units, 'false' if otherwise
+  //[NOTE]: Unlike 'DecreaseQuantity(...)' the argument is a delta, not the new quantity.
+  //        In 'Concurrent' mode this is an atomic "take if available": the check and the subtraction
+  //        happen in one compare-and-swap, two threads can never take the same units.
+  //        In 'Sharded' mode the caller's own counter is tried first {[SEE]: ShardedQuantities::Take(...)}.
+  bool Stockpile::Withdraw(ResourceId Resource, size_t Amount)
+  {
+    if(Mode == StorageMode::Concurrent)
+    {
+      std::atomic<size_t>* Slot = FindSlot(Resource);
+      if(Slot == nullptr) { return false; }
+
+      size_t Current = Slot -> load(std::memory_order_acquire);
+      do
+      {
+        if(Current == AbsentQuantity || Current < Amount) { return false; }
+      } while(!Slot -> compare_exchange_weak(Current, Current - Amount, std::memory_order_acq_rel, std::memory_order_acquire));
+      return true;
+    }
+
+    if(Mode == StorageMode::Sharded) { return Shards.Take(Resource, Amount); }
+
+    if(Mode == StorageMode::Versioned)
+    {
+      return Versions.Commit([Resource, Amount](VersionedQuantities::Draft& Working) {
+        const size_t Current = Working.Get(Resource);
+        if(Current == AbsentQuantity || Current < Amount) { return false; }
+        Working.Set(Resource, Current - Amount);
+        return true;
+      });
+    }
+
+    size_t* Quantity = FindQuantity(Resource);
+    if(Quantity == nullptr || *Quantity < Amount) { return false; }
+
+    *Quantity -= Amount;
+    ++Version;
+    return true;
+  }
+
+  //[DESC]: Add 'Amount' units of a resource to the stockpile.
+  //[PARAM]: 'Resource' The interned identifier of the resource
+  //[PARAM]: 'Amount' The number of units to add
+  //[PRE]: None.
+  //[POST]: The quantity is raised by 'Amount', an absent resource is added with 'Amount' units
+  //[THROW]: 'std::overflow_error' If the new quantity does not fit, the stockpile is unchanged
+  //[NOTE]: Unlike 'IncreaseQuantity(...)' the argument is a delta, not the new quantity
+  //        In 'Concurrent' and 'Sharded' mode a resource interned after the stockpile was built gets
+  //        its slot here.
+  void Stockpile::Deposit(ResourceId Resource, size_t Amount)
+  {
+    if(Mode == StorageMode::Concurrent)
+    {
+      std::atomic<size_t>* Slot = &ObtainSlot(Resource);
+      size_t Current = Slot -> load(std::memory_order_acquire);
+      size_t Updated = 0;
+      do
+      {
+        const size_t Base = (Current == AbsentQuantity) ? 0 : Current;
+        if(Amount >= AbsentQuantity - Base)
+        {
+          throw std::overflow_error("[S]Deposit(...) [Quantity overflow]");
+        }
+        Updated = Base + Amount;
+      } while(!Slot -> compare_exchange_weak(Current, Updated, std::memory_order_acq_rel, std::memory_order_acquire));
+      return;
+    }
+
+    if(Mode == StorageMode::Sharded)
+    {
+      Shards.Add(Resource, Amount);
+      return;
+    }
+
+    if(Mode == StorageMode::Versioned)
+    {
+      Versions.Commit([Resource, Amount](VersionedQuantities::Draft& Working) {
+        const size_t Current = Working.Get(Resource);
+        const size_t Base = (Current == AbsentQuantity) ? 0 : Current;
+        if(Amount >= AbsentQuantity - Base)
+        {
+          throw std::overflow_error("[S]Deposit(...) [Quantity overflow]");
+        }
+        Working.Set(Resource, Base + Amount);
+        return true;
+      });
+      return;
+    }
+
+    size_t* Quantity = FindQuantity(Resource);
+    if(Quantity == nullptr)
+    {
+      if(Amount == AbsentQuantity)
+      {
+        throw std::overflow_error("[S]Deposit(...) [Quantity overflow]");
+      }
+      StoreQuantity(Resource, Amount);
+      return;
+    }
+
+    if(Amount >= AbsentQuantity - *Quantity)
+    {
+      throw std::overflow_error("[S]Deposit(...) [Quantity overflow]");
+    }
+    *Quantity += Amount;
+    ++Version;
+  }
+
+  //[DESC]: Take a whole set of quantities out of the stockpile, or nothing at all.
+  //[PARAM]: 'Resources' The interned identifiers, e.g. the inputs of one formula
+  //[PARAM]: 'Quantities' 'Quantities[i]' units of 'Resources[i]' are taken
+  //[PARAM]: 'Count' The number of entries, may be 0
+  //[PRE]: Both arrays hold at least 'Count' values. An id may appear more than once.
+  //[POST]: On success every quantity was subtracted, otherwise the stockpile holds what it held before
+  //[RETURN]: 'true' if every resource was present with enough units, 'false' if otherwise
+  //[NOTE]: One pass, one lookup per entry: each entry is checked and debited in the same step
+  //        {[SEE]: Withdraw(...)}. When an entry is short the entries already debited are given back.
+  //        In 'Concurrent' mode each debit is a compare-and-swap, no lock is taken; another thread
+  //        may briefly see the first entries taken by a call that ends up failing and rolling back.
+  //        In 'Versioned' mode the whole set is one commit, no other thread ever sees a partial debit.
+  bool Stockpile::TryConsume(const ResourceId* Resources, const unsigned int* Quantities, size_t Count)
+  {
+    if(Mode == StorageMode::Versioned)
+    {
+      return Versions.Commit([Resources, Quantities, Count](VersionedQuantities::Draft& Working) {
+        for(size_t i = 0; i < Count; i++)
+        {
+          const size_t Current = Working.Get(Resources[i]);
+          if(Current == AbsentQuantity || Current < Quantities[i]) { return false; }
+          Working.Set(Resources[i], Current - Quantities[i]);
+        }
+        return true;
+      });
+    }
+
+    size_t Taken = 0;
+    while(Taken < Count && Withdraw(Resources[Taken], Quantities[Taken])) { Taken++; }
+    if(Taken == Count) { return true; }
+
+    while(Taken > 0)
+    {
+      Taken--;
+      Deposit(Resources[Taken], Quantities[Taken]);
+    }
     return false;
   }
-}//[NAMESPACE]: ResourceConversion
 
+  //[DESC]: Add a whole set of quantities to the stockpile.
+  //[PARAM]: 'Resources' The interned identifiers, e.g. the outputs of one formula
+  //[PARAM]: 'Quantities' 'Quantities[i]' units of 'Resources[i]' are added
+  //[PARAM]: 'Count' The number of entries, may be 0
+  //[PRE]: Both arrays hold at least 'Count' values. An id may appear more than once.
+  //[POST]: Every quantity was added, absent resources are added to the stockpile
+  //[THROW]: 'std::overflow_error' If a quantity does not fit. The entries already added are taken back
+  //         (in 'Concurrent' and 'Sharded' mode as far as other threads have not consumed them yet;
+  //         in 'Versioned' mode nothing is published).
+  void Stockpile::Produce(const ResourceId* Resources, const unsigned int* Quantities, size_t Count)
+  {
+    if(Mode == StorageMode::Versioned)
+    {
+      Versions.Commit([Resources, Quantities, Count](VersionedQuantities::Draft& Working) {
+        for(size_t i = 0; i < Count; i++)
+        {
+          const size_t Current = Working.Get(Resources[i]);
+          const size_t Base = (Current == AbsentQuantity) ? 0 : Current;
+          if(Quantities[i] >= AbsentQuantity - Base)
+          {
+            throw std::overflow_error("[S]Produce(...) [Quantity overflow]");
+          }
+          Working.Set(Resources[i], Base + Quantities[i]);
+        }
+        return true;
+      });
+      return;
+    }
+
+    size_t Added = 0;
+    try
+    {
+      for(; Added < Count; Added++) { Deposit(Resources[Added], Quantities[Added]); }
+    }
+    catch(const std::overflow_error&)
+    {
+      while(Added > 0)
+      {
+        Added--;
+        Withdraw(Resources[Added], Quantities[Added]);
+      }
+      throw;
+    }
+  }
+
+  //[DESC]: Spread the quantity of every resource evenly over the shards of a 'Sharded' stockpile.
+  //[PRE]: None.
+  //[POST]: Quantities are unchanged. Does nothing in the other storage modes.
+  //[NOTE]: Reconciliation on demand, e.g. after a phase in which a few threads produced most of a
+  //        resource that all threads are about to consume. Safe to call while other threads use the
+  //        stockpile {[SEE]: ShardedQuantities::Rebalance(...)}.
+  void Stockpile::Rebalance()
+  {
+    if(Mode == StorageMode::Sharded) { Shards.Rebalance(); }
+  }
+
+  //[DESC]: Check whether the stockpile can hold a resource, present or not.
+  //[PARAM]: 'Resource' The interned identifier of the resource
+  //[PRE]: None.
+  //[POST]: None.
+  //[RETURN]: 'true' for every 'ResourceId'. 'Concurrent' and 'Sharded' mode grow their slots in
+  //          segments up to the 32-bit id range, the other modes grow on demand.
+  bool Stockpile::CanStore(ResourceId Resource) const
+  {
+    switch(Mode)
+    {
+      case StorageMode::Concurrent: return Resource < SegmentedSlots<ConcurrentSlot>::MaxSize;
+      case StorageMode::Sharded: return Resource < ShardedQuantities::MaxSize;
+      default: return true;
+    }
+  }
+
+  //[DESC]: Replace the contents of this stockpile with a copy of 'other'.
+  //[PARAM]: 'other' The stockpile to copy
+  //[PARAM]: 'Mode_' Storage backing the copy {[SEE]: Stockpile.h [STORAGE MODES]}
+  //[PRE]: None.
+  //[POST]: This stockpile holds exactly the resources and quantities of 'other'
+  //[NOTE]: Copying stays explicit on purpose. The existing containers are reused, so resetting a
+  //        scratch stockpile once per simulation trial does not allocate after the first trial.
+  void Stockpile::CopyFrom(const Stockpile& other, StorageMode Mode_)
+  {
+    if(this == &other && Mode == Mode_) { return; }
+    ++Version;
+
+    if(other.Mode == Mode_ && (Mode_ == StorageMode::Map || Mode_ == StorageMode::Dense))
+    {
+      Mode = Mode_;
+      ResourcesMap = other.ResourcesMap;
+      DenseQuantities = other.DenseQuantities;
+      ConcurrentSlots.Reset(1);
+      Shards.Clear();
+      Versions.Clear();
+      return;
+    }
+
+    if(this == &other)
+    {
+      Stockpile Converted;
+      Converted.CopyFrom(other, Mode_);
+      SwapData(std::move(Converted));
+      return;
+    }
+
+    Mode = Mode_;
+    ResourcesMap.clear();
+    DenseQuantities.clear();
+    ConcurrentSlots.Reset(1);
+    Shards.Clear();
+    Versions.Clear();
+    if(Mode == StorageMode::Sharded) { Shards.Reset(); }
+    if(Mode == StorageMode::Versioned) { Versions.Reset(); }
+    other.VisitQuantities([this](ResourceId Resource, size_t Quantity) { StoreQuantity(Resource, Quantity); });
+  }
+
+  //[DESC]: Take an immutable copy of the stockpile contents.
+  //[PRE]: None.
+  //[POST]: In 'Map' and 'Dense' mode the snapshot is cached until the next change of the stockpile.
+  //[RETURN]: A shared handle to the snapshot {[SEE]: StockpileSnapshot.h}
+  //[NOTE]: One flat copy of the (ResourceId, quantity) pairs, no names and no hashing. Calling it
+  //        repeatedly without changing the stockpile (e.g. once per reporting tick) hands out the
+  //        same snapshot again. In 'Versioned' mode the snapshot is the newest committed version,
+  //        O(1) and consistent even while writers run. In 'Concurrent' and 'Sharded' mode every call builds a new snapshot
+  //        from quantities loaded one at a time, which is not a single point in time while other
+  //        threads are writing.
+  std::shared_ptr<const StockpileSnapshot> Stockpile::Snapshot() const
+  {
+    if(Mode == StorageMode::Versioned)
+    {
+      std::shared_ptr<const VersionedQuantities::Tree> Newest = Versions.Current();
+      if(Newest == nullptr) { Newest = std::make_shared<const VersionedQuantities::Tree>(); }
+      return std::make_shared<const StockpileSnapshot>(std::move(Newest));
+    }
+
+    const bool Cacheable = (Mode == StorageMode::Map || Mode == StorageMode::Dense);
+    if(Cacheable)
+    {
+      std::shared_ptr<const StockpileSnapshot> Cached = std::atomic_load(&CachedSnapshot);
+      if(Cached != nullptr && Cached -> GetVersion() == Version) { return Cached; }
+    }
+
+    std::vector<StockpileSnapshot::Entry> Entries;
+    if(Mode == StorageMode::Map) { Entries.reserve(ResourcesMap.size()); }
+    VisitQuantities([&Entries](ResourceId Resource, size_t Quantity) { Entries.emplace_back(Resource, Quantity); });
+
+    std::shared_ptr<const StockpileSnapshot> Fresh = std::make_shared<const StockpileSnapshot>(std::move(Entries), Version);
+    if(Cacheable) { std::atomic_store(&CachedSnapshot, Fresh); }
+    return Fresh;
+  }
+
+  //[DESC]: Get an iterator to the first resource of the stockpile {[SEE]: Stockpile.h [READING]}
+  //[PRE]: None.
+  //[POST]: None.
+  //[RETURN]: The iterator, equal to 'end()' if the stockpile is empty
+  Stockpile::ConstIterator Stockpile::begin() const
+  {
+    ConstIterator First;
+    First.Owner = this;
+    First.MapPosition = ResourcesMap.begin();
+    if(Mode == StorageMode::Versioned)
+    {
+      First.Pinned = Versions.Current();
+      First.Slots = (First.Pinned != nullptr) ? First.Pinned -> Capacity() : 0;
+    }
+    else
+    {
+      First.Slots = SlotCount();
+    }
+    First.SkipAbsent();
+    return First;
+  }
+
+  //[DESC]: Get the past-the-end iterator of the stockpile
+  //[PRE]: None.
+  //[POST]: None.
+  //[RETURN]: The iterator
+  Stockpile::ConstIterator Stockpile::end() const
+  {
+    ConstIterator Last;
+    Last.Owner = this;
+    Last.MapPosition = ResourcesMap.end();
+    if(Mode != StorageMode::Map) { Last.Index = ConstIterator::EndIndex; }
+    return Last;
+  }
+
+  //[DESC]: Get the number of index positions the iterator walks in the array based modes
+  //[RETURN]: The number of slots, 0 in 'Map' mode
+  size_t Stockpile::SlotCount() const
+  {
+    switch(Mode)
+    {
+      case StorageMode::Dense: return DenseQuantities.size();
+      case StorageMode::Concurrent: return ConcurrentSlots.Size();
+      case StorageMode::Sharded: return Shards.Size();
+      case StorageMode::Versioned:
+      {
+        std::shared_ptr<const VersionedQuantities::Tree> Newest = Versions.Current();
+        return (Newest != nullptr) ? Newest -> Capacity() : 0;
+      }
+      case StorageMode::Map:
+      default: return 0;
+    }
+  }
+
+  //[DESC]: Move the iterator forward to the next present resource, or to 'end()'
+  //[PRE]: The iterator belongs to a stockpile
+  //[POST]: The iterator points to a present resource or equals 'end()'. The walk covers the slots
+  //        counted by 'begin()', in 'Versioned' mode those of the pinned version, so it always ends.
+  void Stockpile::ConstIterator::SkipAbsent()
+  {
+    if(Owner -> Mode == StorageMode::Map) { return; }
+
+    if(Pinned != nullptr)
+    {
+      while(Index < Slots && Pinned -> Find(static_cast<ResourceId>(Index)) == VersionedQuantities::AbsentQuantity) { Index++; }
+    }
+    else
+    {
+      while(Index < Slots && !Owner -> HasResource(static_cast<ResourceId>(Index))) { Index++; }
+    }
+    if(Index >= Slots) { Index = EndIndex; }
+  }
+
+  //[DESC]: Read the resource the iterator points to
+  //[PRE]: The iterator is dereferenceable
+  //[RETURN]: The (ResourceId, quantity) pair, by value
+  Stockpile::ConstIterator::value_type Stockpile::ConstIterator::operator*() const
+  {
+    if(Owner -> Mode == StorageMode::Map) { return *MapPosition; }
+
+    const ResourceId Resource = static_cast<ResourceId>(Index);
+    if(Pinned != nullptr) { return value_type(Resource, Pinned -> Find(Resource)); }
+    return value_type(Resource, Owner -> GetResourceQuantity(Resource));
+  }
+
+  //[DESC]: Advance to the next resource
+  //[PRE]: The iterator is dereferenceable
+  //[RETURN]: Reference to the advanced iterator
+  Stockpile::ConstIterator& Stockpile::ConstIterator::operator++()
+  {
+    if(Owner -> Mode == StorageMode::Map)
+    {
+      ++MapPosition;
+      return *this;
+    }
+
+    Index++;
+    SkipAbsent();
+    return *this;
+  }
+
+  //[DESC]: Advance to the next resource
+  //[PRE]: The iterator is dereferenceable
+  //[RETURN]: A copy of the iterator before it was advanced
+  Stockpile::ConstIterator Stockpile::ConstIterator::operator++(int DummyParameter)
+  {
+    ConstIterator Previous = *this;
+    ++(*this);
+    return Previous;
+  }
+
+  //[DESC]: Compare two iterators of the same stockpile
+  //[RETURN]: True if both point to the same position, false otherwise
+  bool Stockpile::ConstIterator::operator==(const ConstIterator& other) const
+  {
+    return Owner == other.Owner && Index == other.Index && MapPosition == other.MapPosition;
+  }
+
+  //[DESC]: Compare two iterators of the same stockpile
+  //[RETURN]: True if they point to different positions, false otherwise
+  bool Stockpile::ConstIterator::operator!=(const ConstIterator& other) const { return !(*this == other); }
+
+  //[DESC]: Build a name-keyed copy of the stockpile contents.
+  //[PRE]: None.
+  //[POST]: None.
+  //[RETURN]: A map from resource name to quantity
+  //[NOTE]: Expensive, every entry is copied and its name looked up in the 'ResourceRegistry'
+  std::unordered_map<std::string, size_t> Stockpile::GetResourcesMap() const
+  {
+    const ResourceRegistry& Registry = ResourceRegistry::Instance();
+    std::unordered_map<std::string, size_t> NamedMap;
+    if(Mode == StorageMode::Map) { NamedMap.reserve(ResourcesMap.size()); }
+
+    VisitQuantities([&](ResourceId Resource, size_t Quantity) { NamedMap.emplace(Registry.GetName(Resource), Quantity); });
+    return NamedMap;
+  }
+}//[NAMESPACE]: ResourceConversion
@@ -39,6 +39,82 @@
 //
 //        [EXTERNAL]:
 //          - 'std::unordered_map' - {SEE [<unordered_map>]}
+//          - 'ResourceRegistry' class {[SEE]: ResourceRegistry.h}
+//
+//[STORAGE MODES]
+//{
+// Stockpile Obj1(Map);                           -> 'std::unordered_map' keyed by 'ResourceId' (default)
+// Stockpile Obj2(Map, StorageMode::Dense);       -> contiguous quantity vector indexed by 'ResourceId'
+//
+// Stockpile Obj3(Map, StorageMode::Concurrent);  -> one atomic quantity per 'ResourceId', thread-safe
+// Stockpile Obj4(Map, StorageMode::Sharded);     -> per-core counters per 'ResourceId', thread-safe
+// Stockpile Obj5(Map, StorageMode::Versioned);   -> persistent trie, O(1) consistent snapshots, thread-safe
+//
+// All modes expose the same interface and produce identical results. 'Dense' trades memory (one
+// slot per interned resource, up to the highest id present) for O(1) array access without hashing
+// or pointer chasing, which pays off when 'PlanApply' touches many resources.
+//
+// 'Concurrent' lets many threads (e.g. several 'ExecutablePlan's sharing one warehouse through
+// 'PlanApply') consume and produce at the same time without a global lock. Every resource has its
+// own cache line sized atomic; 'Withdraw' is a compare-and-swap "take if available",
+// 'IncreaseQuantity'/'DecreaseQuantity'/'Deposit' are compare-and-swap loops as well. The slots live
+// in segments that are allocated on first use and never move {[SEE]: SegmentedSlots.h}, so any
+// resource can be deposited, including one interned after the stockpile was built, while other
+// threads keep working; there is no limit below the 32-bit 'ResourceId' range.
+// Construction, moves, 'CopyFrom' into the stockpile and 'GetResourcesMap' are not synchronized.
+// A step of 'PlanApply' takes its inputs one at a time, so other threads may see some of them taken
+// before the step gives them back.
+//
+// 'Sharded' goes one step further for hot resources that hundreds of plans hammer at once: the
+// quantity of each resource is split over one counter per core {[SEE]: ShardedQuantities.h}. A
+// thread produces into and consumes from its own counter and only visits the others when its own
+// runs dry. 'GetResourceQuantity' sums the counters and is exact when the resource is not being
+// changed at the same time; 'Rebalance()' spreads every quantity evenly again. A resource holds at
+// most 'ShardedQuantities::Capacity()' units (a few below the 'size_t' maximum), checked against the
+// total over all counters, and 'Deposit'/'Produce' throw 'std::overflow_error' beyond that. The same
+// synchronization rules as in 'Concurrent' mode apply, except that the set-to calls
+// 'IncreaseQuantity'/'DecreaseQuantity' read the total and then add or take the difference: they
+// are single-writer, only exact while no other thread changes that resource. Use 'Deposit'/'Withdraw'
+// for deltas from many threads. The counters grow in segments like the 'Concurrent' slots, so any
+// resource can be deposited here too.
+//
+// 'Versioned' is for reading while others write (audits during a run). Every change commits a new
+// immutable version {[SEE]: VersionedQuantities.h}; 'Snapshot()' hands out the newest one in O(1)
+// and it never shows a torn state. 'TryConsume'/'Produce' commit all entries of a step at once.
+// Readers and writers only share the head pointer, which is copied under a short lock inside
+// 'std::atomic_load'/'std::atomic_compare_exchange_weak' (libstdc++ keeps a small pool of mutexes
+// for atomic 'std::shared_ptr'), so they can wait on each other for that copy but never for a
+// whole read or edit. Concurrent writers retry on conflict, so heavy write contention on one
+// stockpile is better served by 'Concurrent' or 'Sharded'. The iterator pins the version it starts
+// on and walks only that one. The same synchronization rules as in
+// 'Concurrent' mode apply.
+//}
+//
+//[DELTAS]
+//{
+// Obj1.IncreaseQuantity(Id, 10);                 -> sets the quantity to 10 (must not shrink)
+// Obj1.Deposit(Id, 10);                          -> adds 10, the resource is added if it is absent
+// Obj1.Withdraw(Id, 10);                         -> subtracts 10, 'false' and no change if short
+// Scratch.CopyFrom(Obj1, StorageMode::Dense);    -> explicit copy, reuses Scratch's storage
+//
+// Obj1.TryConsume(Ids, Quantities, Count);       -> all inputs of a step or none, 'false' if short
+// Obj1.Produce(Ids, Quantities, Count);          -> all outputs of a step
+//}
+//
+//[READING]
+//{
+// for(const auto [Id, Quantity] : Obj1) { ... }                    -> walks the storage, no copy
+// Obj1.ForEachResource([](ResourceId Id, size_t Quantity) { ... }); -> same, as a visitor
+// std::shared_ptr<const StockpileSnapshot> View = Obj1.Snapshot(); -> immutable, shareable copy
+//
+// The iterator and the visitor read the live stockpile and must not outlive or race with a change
+// of it in 'Map'/'Dense' mode. A snapshot is one flat array of pairs; it is cached until the next
+// change, so polling it every reporting tick copies only when something changed.
+//}
+//
+//[NOTE]: Resources are keyed by their interned 'ResourceId'. The 'std::string' overloads intern or
+//        look up the name once and forward to the 'ResourceId' overloads, hot paths such as
+//        'ExecutablePlan::PlanApply(...)' call the 'ResourceId' overloads directly.
 //
 //[NAMESPACE]: Might be deemed unnecessary, but despite the distinctive function names, global
 //             namespace pollution is still in the picture.
@@ -47,44 +123,189 @@
 #ifndef Stockpile_h
 #define Stockpile_h
 
+#include <atomic>
+#include <cstdint>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
+#include <limits>
+
+#include "ResourceRegistry.h"
+#include "SegmentedSlots.h"
+#include "ShardedQuantities.h"
+#include "StockpileSnapshot.h"
+#include "VersionedQuantities.h"
 
 //Client fills the map with appropriaet valeus -> exact copy
 namespace ResourceConversion
 {
   class Stockpile
   {
+    public:
+    enum class StorageMode { Map, Dense, Concurrent, Sharded, Versioned };
+
     private:
-    std::unordered_map<std::string, size_t> ResourcesMap;
+    //[NOTE]: Marks a 'DenseQuantities' or 'ConcurrentSlots' slot whose resource is not part of the stockpile
+    static constexpr size_t AbsentQuantity = std::numeric_limits<size_t>::max();
+
+    //[NOTE]: One cache line per resource, threads working on different resources never contend
+    struct alignas(64) ConcurrentSlot
+    {
+      std::atomic<size_t> Quantity{AbsentQuantity};
+    };
+
+    StorageMode Mode = StorageMode::Map;
+    std::unordered_map<ResourceId, size_t> ResourcesMap;
+    std::vector<size_t> DenseQuantities;
+    SegmentedSlots<ConcurrentSlot> ConcurrentSlots = SegmentedSlots<ConcurrentSlot>();
+    ShardedQuantities Shards = ShardedQuantities();
+    VersionedQuantities Versions = VersionedQuantities();
+
+    //[NOTE]: Bumped by every change in 'Map' and 'Dense' mode, tags the cached snapshot
+    std::uint64_t Version = 0;
+    mutable std::shared_ptr<const StockpileSnapshot> CachedSnapshot = nullptr;
 
-    inline void ReassignData(Stockpile&& other) const;
+    inline void ReassignData(Stockpile&& other);
     inline void ResetData();
     inline void SwapData(Stockpile&& other);
     inline void ClearData();
 
+    inline size_t* FindQuantity(ResourceId Resource);
+    inline const size_t* FindQuantity(ResourceId Resource) const;
+    inline void StoreQuantity(ResourceId Resource, size_t Quantity);
+    inline std::atomic<size_t>* FindSlot(ResourceId Resource) const;
+    inline std::atomic<size_t>& ObtainSlot(ResourceId Resource);
+
+    template<typename Visitor> void VisitQuantities(Visitor&& Visit) const;
+    size_t SlotCount() const;
+
     //[NOTE]: Copying is suppressed
     Stockpile(const Stockpile& other) = delete;
     Stockpile& operator=(const Stockpile& other) = delete;
 
     public:
+    //[DESC]: Forward iterator over the (ResourceId, quantity) pairs of a stockpile, in any storage
+    //        mode. Dereferencing yields the pair by value; nothing is copied up front.
+    class ConstIterator
+    {
+      public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = std::pair<ResourceId, size_t>;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = value_type;
+
+      value_type operator*() const;
+      ConstIterator& operator++();
+      ConstIterator operator++(int DummyParameter);
+
+      bool operator==(const ConstIterator& other) const;
+      bool operator!=(const ConstIterator& other) const;
+
+      private:
+      friend class Stockpile;
+
+      //[NOTE]: 'Index' of every past-the-end iterator of the array based modes
+      static constexpr size_t EndIndex = std::numeric_limits<size_t>::max();
+
+      const Stockpile* Owner = nullptr;
+      size_t Index = 0;
+      size_t Slots = 0;
+      std::unordered_map<ResourceId, size_t>::const_iterator MapPosition = std::unordered_map<ResourceId, size_t>::const_iterator();
+      //[NOTE]: The version a 'Versioned' walk reads from start to end, whatever is committed meanwhile
+      std::shared_ptr<const VersionedQuantities::Tree> Pinned = nullptr;
+
+      void SkipAbsent();
+    };
 
     explicit Stockpile();
-    Stockpile(const std::unordered_map<std::string, size_t>& ResourcesMap_);
+    Stockpile(const std::unordered_map<std::string, size_t>& ResourcesMap_, StorageMode Mode_ = StorageMode::Map);
     ~Stockpile();
     Stockpile(Stockpile&& other) noexcept;
     Stockpile& operator=(Stockpile&& other) noexcept;
 
     bool IncreaseQuantity(const std::string& NameOfResource, const size_t& NewIncreasedQuantity);
     bool DecreaseQuantity(const std::string& NameOfResource, const size_t& NewDecreasedQuantity);
-    std::size_t GetResourceQuantity(const std::string& resource);
+    std::size_t GetResourceQuantity(const std::string& resource) const;
     bool HasResource(const std::string& resource) const; 
 
+    bool IncreaseQuantity(ResourceId Resource, const size_t& NewIncreasedQuantity);
+    bool DecreaseQuantity(ResourceId Resource, const size_t& NewDecreasedQuantity);
+    std::size_t GetResourceQuantity(ResourceId Resource) const;
+    bool HasResource(ResourceId Resource) const;
+
+    bool Withdraw(ResourceId Resource, size_t Amount);
+    void Deposit(ResourceId Resource, size_t Amount);
+    void CopyFrom(const Stockpile& other, StorageMode Mode_);
+
+    bool TryConsume(const ResourceId* Resources, const unsigned int* Quantities, size_t Count);
+    void Produce(const ResourceId* Resources, const unsigned int* Quantities, size_t Count);
+
+    void Rebalance();
+    bool CanStore(ResourceId Resource) const;
+
+    inline StorageMode GetStorageMode() const { return Mode; }
+    inline std::uint64_t GetVersion() const { return Version; }
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+    template<typename Visitor> void ForEachResource(Visitor&& Visit) const { VisitQuantities(std::forward<Visitor>(Visit)); }
+    std::shared_ptr<const StockpileSnapshot> Snapshot() const;
+
     //[NOTE]: Calling this function is expensive. 
     //        It should only be called when the 
     //        'ResourcesMap' needs to be used
-    [[nodiscard]]inline std::unordered_map<std::string, size_t> GetResourcesMap() {return ResourcesMap;}
+    //        {[SEE]: [READING] for the non-copying alternatives}
+    [[nodiscard]]std::unordered_map<std::string, size_t> GetResourcesMap() const;
   };
+
+  //[DESC]: Call 'Visit(ResourceId, size_t)' once per resource of the stockpile, in any storage mode
+  //[PRE]: None
+  //[POST]: None
+  //[NOTE]: In 'Concurrent' and 'Sharded' mode every quantity is loaded on its own, the visit is not a
+  //        snapshot. In 'Versioned' mode the visit walks one consistent version.
+  template<typename Visitor>
+  void Stockpile::VisitQuantities(Visitor&& Visit) const
+  {
+    switch(Mode)
+    {
+      case StorageMode::Map:
+        for(const auto& [Resource, Quantity] : ResourcesMap) { Visit(Resource, Quantity); }
+        break;
+
+      case StorageMode::Dense:
+        for(size_t i = 0; i < DenseQuantities.size(); i++)
+        {
+          if(DenseQuantities[i] != AbsentQuantity) { Visit(static_cast<ResourceId>(i), DenseQuantities[i]); }
+        }
+        break;
+
+      case StorageMode::Concurrent:
+        for(size_t i = 0; i < ConcurrentSlots.Size(); i++)
+        {
+          const SegmentedSlots<ConcurrentSlot>::Position Where = ConcurrentSlots.Find(i);
+          if(Where.Segment == nullptr) { i += Where.Length - Where.Offset - 1; continue; }
+          const size_t Quantity = Where.Segment[Where.Offset].Quantity.load(std::memory_order_acquire);
+          if(Quantity != AbsentQuantity) { Visit(static_cast<ResourceId>(i), Quantity); }
+        }
+        break;
+
+      case StorageMode::Sharded:
+        for(size_t i = 0; i < Shards.Size(); i++)
+        {
+          if(Shards.Has(static_cast<ResourceId>(i))) { Visit(static_cast<ResourceId>(i), Shards.Load(static_cast<ResourceId>(i))); }
+        }
+        break;
+
+      case StorageMode::Versioned:
+      {
+        std::shared_ptr<const VersionedQuantities::Tree> Newest = Versions.Current();
+        if(Newest != nullptr) { Newest -> Visit(Visit); }
+        break;
+      }
+    }
+  }
 }//[NAMESPACE]: ResourceConversion
 #endif /*Stockpile_h*/
\ No newline at end of file
@@ -0,0 +1,91 @@
+//[FILE]: StockpileSnapshot.cpp
+//[DESC]: This file contains the implementation of the 'StockpileSnapshot' class {[SEE]: StockpileSnapshot.h}
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//          - 1.1 [16/10/2026] - Snapshots of versioned stockpiles
+//
+//[INVARIANT]: Lookups are binary searches over the sorted 'Entries', or trie walks when 'Source' is set.
+
+#include <algorithm>
+
+#include "StockpileSnapshot.h"
+
+namespace ResourceConversion
+{
+  namespace
+  {
+    //[DESC]: Orders entries, and entries against ids, by 'ResourceId'
+    struct ById
+    {
+      bool operator()(const StockpileSnapshot::Entry& Left, const StockpileSnapshot::Entry& Right) const { return Left.first < Right.first; }
+      bool operator()(const StockpileSnapshot::Entry& Left, ResourceId Right) const { return Left.first < Right; }
+    };
+  }
+
+  //[DESC]: Constructor
+  //[PARAM]: 'Entries_' The (ResourceId, quantity) pairs of the stockpile, each id at most once, any order
+  //[PARAM]: 'Version_' The version of the stockpile the entries were read from
+  //[PRE]: None
+  //[POST]: Object is constructed, the entries are sorted by id
+  StockpileSnapshot::StockpileSnapshot(std::vector<Entry>&& Entries_, std::uint64_t Version_)
+    : Entries(std::move(Entries_)), Version(Version_)
+  {
+    if(!std::is_sorted(Entries.begin(), Entries.end(), ById())) { std::sort(Entries.begin(), Entries.end(), ById()); }
+  }
+
+  //[DESC]: Constructor, wraps one version of a 'Versioned' stockpile
+  //[PARAM]: 'Source_' The version, never null
+  //[PRE]: None
+  //[POST]: Object is constructed in O(1), the version is kept alive by the snapshot
+  StockpileSnapshot::StockpileSnapshot(std::shared_ptr<const VersionedQuantities::Tree> Source_)
+    : Source(std::move(Source_)), Version(Source -> Number) {}
+
+  //[DESC]: Get the sorted entries, flattening the wrapped version on first use
+  //[PRE]: None
+  //[POST]: 'Entries' is built, at most once even with concurrent readers
+  //[RETURN]: The entries
+  const std::vector<StockpileSnapshot::Entry>& StockpileSnapshot::GetEntries() const
+  {
+    if(Source != nullptr)
+    {
+      std::call_once(EntriesBuilt, [this]() {
+        Source -> Visit([this](ResourceId Resource, size_t Quantity) { Entries.emplace_back(Resource, Quantity); });
+      });
+    }
+    return Entries;
+  }
+
+  //[DESC]: Get the quantity of a resource at the time of the snapshot
+  //[PRE]: None
+  //[POST]: None
+  //[RETURN]: The quantity, 0 if the resource was not part of the stockpile
+  size_t StockpileSnapshot::GetResourceQuantity(ResourceId Resource) const
+  {
+    if(Source != nullptr)
+    {
+      const size_t Quantity = Source -> Find(Resource);
+      return (Quantity == VersionedQuantities::AbsentQuantity) ? 0 : Quantity;
+    }
+
+    auto it = std::lower_bound(Entries.begin(), Entries.end(), Resource, ById());
+    if(it == Entries.end() || it -> first != Resource) { return 0; }
+    return it -> second;
+  }
+
+  //[DESC]: Check whether a resource was part of the stockpile at the time of the snapshot
+  //[PRE]: None
+  //[POST]: None
+  //[RETURN]: True if the resource was present, false otherwise
+  bool StockpileSnapshot::HasResource(ResourceId Resource) const
+  {
+    if(Source != nullptr) { return Source -> Find(Resource) != VersionedQuantities::AbsentQuantity; }
+
+    auto it = std::lower_bound(Entries.begin(), Entries.end(), Resource, ById());
+    return it != Entries.end() && it -> first == Resource;
+  }
+}//[NAMESPACE]: ResourceConversion
@@ -0,0 +1,87 @@
+//[FILE]: StockpileSnapshot.h
+//[DESC]: This file defines the 'StockpileSnapshot' class, an immutable copy of the contents of a
+//        'Stockpile' taken at one point in time. It is handed out as 'std::shared_ptr<const
+//        StockpileSnapshot>' by 'Stockpile::Snapshot()', so any number of readers (dashboards,
+//        audits, other threads) can keep and share it while the stockpile moves on.
+//
+//        The entries are one flat array of (ResourceId, quantity) pairs sorted by id, which makes a
+//        snapshot cheap to build, cheap to iterate and small compared to a node based map.
+//
+//        A snapshot of a 'Versioned' stockpile instead keeps a reference to one immutable version
+//        {[SEE]: VersionedQuantities.h}: taking it is O(1), lookups walk the version directly and the
+//        flat array is only built the first time the snapshot is iterated.
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//          - 1.1 [16/10/2026] - Snapshots of versioned stockpiles
+//
+//[INVARIANT]: 'Entries' is sorted by 'ResourceId' and holds each id at most once.
+//[INVARIANT]: A snapshot never changes after construction (building 'Entries' lazily is not a change).
+//
+//[USAGE]
+//{
+// std::shared_ptr<const StockpileSnapshot> View = StockpileObj.Snapshot();
+// for(const StockpileSnapshot::Entry& Item : *View) { Item.first; Item.second; }
+// View -> GetResourceQuantity(Iron);
+//}
+//
+//[DEPENDENCIES]:
+//       [INTERNAL]:
+//          - Member, Helper, Utility methods
+//          - Private Data Members
+//
+//        [EXTERNAL]:
+//          - 'std::vector'
+//          - 'ResourceId' {[SEE]: ResourceRegistry.h}
+//
+//[NAMESPACE]: {ResourceConversion} Encapsulates the 'Formula', 'Plan', 'ExecutablePlan', 'Stockpile'
+//             and supporting classes.
+#ifndef StockpileSnapshot_h
+#define StockpileSnapshot_h
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "ResourceRegistry.h"
+#include "VersionedQuantities.h"
+
+namespace ResourceConversion
+{
+  class StockpileSnapshot
+  {
+    public:
+    using Entry = std::pair<ResourceId, size_t>;
+    using const_iterator = std::vector<Entry>::const_iterator;
+
+    private:
+    //[NOTE]: Filled on first use when the snapshot wraps a 'VersionedQuantities::Tree'
+    mutable std::vector<Entry> Entries = std::vector<Entry>();
+    mutable std::once_flag EntriesBuilt = {};
+    std::shared_ptr<const VersionedQuantities::Tree> Source = nullptr;
+    std::uint64_t Version = 0;
+
+    const std::vector<Entry>& GetEntries() const;
+
+    public:
+    StockpileSnapshot(std::vector<Entry>&& Entries_, std::uint64_t Version_);
+    explicit StockpileSnapshot(std::shared_ptr<const VersionedQuantities::Tree> Source_);
+
+    size_t GetResourceQuantity(ResourceId Resource) const;
+    bool HasResource(ResourceId Resource) const;
+
+    inline size_t Size() const { return GetEntries().size(); }
+    inline std::uint64_t GetVersion() const { return Version; }
+
+    inline const_iterator begin() const { return GetEntries().begin(); }
+    inline const_iterator end() const { return GetEntries().end(); }
+  };
+}//[NAMESPACE]: ResourceConversion
+#endif /*StockpileSnapshot_h*/
@@ -0,0 +1,456 @@
+//[FILE]: ThroughputPlanner.cpp
+//[DESC]: This file contains the implementation of the 'ThroughputPlanner' class {[SEE]: ThroughputPlanner.h}
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: 'Terms[TermOffsets[f] .. TermOffsets[f + 1])' describe formula f of the candidates.
+//[INVARIANT]: The program has one row per consumed resource of a kept formula and one row for the
+//             application limit (last). Variable j < 'Kept.size()' applies formula 'Kept[j]', the
+//             next ones are the slacks of the rows. 'Basis[i]' is the variable of row i, 'Values[i]'
+//             its value and column k of 'Inverse' is column k of the basis inverse.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+
+#include "ThroughputPlanner.h"
+
+namespace ResourceConversion
+{
+  namespace
+  {
+    constexpr std::uint32_t NoIndex = std::numeric_limits<std::uint32_t>::max();
+    constexpr double Epsilon = 1e-9;
+
+    //[NOTE]: Smallest coefficient the simplex pivots on, smaller ones only amplify rounding errors
+    constexpr double PivotTolerance = 1e-7;
+
+    //[NOTE]: Consecutive pivots without progress before the simplex switches to Bland's rule, which
+    //        cannot cycle
+    constexpr size_t DegenerateLimit = 64;
+
+    //[NOTE]: Programs solved per 'Optimize(...)' at most, each one without the formulas the previous
+    //        schedule could not start {[SEE]: Sequence(...)}. Rounds also stop once one does not improve.
+    constexpr size_t ResolveLimit = 4;
+  }
+
+  //[DESC]: Default constructor
+  //[PRE]: None
+  //[POST]: A planner with empty buffers is constructed
+  ThroughputPlanner::ThroughputPlanner() {}
+
+  //[DESC]: Number a resource locally, on its first mention
+  //[RETURN]: The local index of 'Resource'
+  std::uint32_t ThroughputPlanner::LocalIndex(ResourceId Resource)
+  {
+    if(Resource >= LocalOf.size()) { LocalOf.resize(Resource + 1, NoIndex); }
+    if(LocalOf[Resource] == NoIndex)
+    {
+      LocalOf[Resource] = static_cast<std::uint32_t>(Resources.size());
+      Resources.push_back(Resource);
+    }
+    return LocalOf[Resource];
+  }
+
+  //[DESC]: Collect what every candidate consumes and is expected to produce
+  //[POST]: 'Terms', 'TermOffsets', 'Resources' and 'Initial' describe the candidates and 'Start'
+  void ThroughputPlanner::Describe(const Plan& Candidates, const Stockpile& Start)
+  {
+    for(ResourceId Resource : Resources) { LocalOf[Resource] = NoIndex; }
+    Resources.clear();
+    Terms.clear();
+    TermOffsets.assign(1, 0);
+
+    for(size_t f = 0; f < Candidates.GetSize(); f++)
+    {
+      const Formula& Candidate = Candidates.GetFormula(f);
+      const Formula::ResourceView Recipe = Candidate.GetView();
+      const size_t First = Terms.size();
+
+      auto TermOf = [this, First](ResourceId Resource) -> Term& {
+        const std::uint32_t Local = LocalIndex(Resource);
+        for(size_t t = First; t < Terms.size(); t++)
+        {
+          if(Terms[t].Resource == Local) { return Terms[t]; }
+        }
+        Terms.push_back(Term());
+        Terms.back().Resource = Local;
+        return Terms.back();
+      };
+
+      for(size_t i = 0; i < Recipe.InputResources.size(); i++)
+      {
+        TermOf(Recipe.InputResources[i]).Consumed += Recipe.InputQuantities[i];
+      }
+
+      Yield.resize(Recipe.OutputResources.size());
+      Candidate.ExpectedOutputs(Yield.data());
+      for(size_t i = 0; i < Recipe.OutputResources.size(); i++)
+      {
+        TermOf(Recipe.OutputResources[i]).Produced += Yield[i];
+      }
+      TermOffsets.push_back(Terms.size());
+    }
+
+    Initial.resize(Resources.size());
+    for(size_t r = 0; r < Resources.size(); r++)
+    {
+      Initial[r] = static_cast<double>(Start.GetResourceQuantity(Resources[r]));
+    }
+  }
+
+  //[DESC]: Keep the candidates that can run and can contribute to the target
+  //[PRE]: 'Banned' marks the formulas to leave out
+  //[POST]: 'Kept' lists them in the order their inputs first become available
+  //[NOTE]: Both closures are fixpoints over the terms: a formula becomes usable once every input is in
+  //        stock or made by a usable formula, and relevant once it makes the target or an input of a
+  //        relevant formula.
+  void ThroughputPlanner::Prune(std::uint32_t Target)
+  {
+    const size_t Count = TermOffsets.size() - 1;
+    Available.assign(Resources.size(), 0);
+    for(size_t r = 0; r < Resources.size(); r++) { Available[r] = (Initial[r] > 0.0); }
+    Usable.assign(Count, 0);
+    Kept.clear();
+
+    for(bool Changed = true; Changed; )
+    {
+      Changed = false;
+      for(size_t f = 0; f < Count; f++)
+      {
+        if(Usable[f] || Banned[f]) { continue; }
+
+        bool Ready = true;
+        for(size_t t = TermOffsets[f]; t < TermOffsets[f + 1] && Ready; t++)
+        {
+          Ready = (Terms[t].Consumed == 0 || Available[Terms[t].Resource]);
+        }
+        if(!Ready) { continue; }
+
+        Usable[f] = 1;
+        Kept.push_back(f);
+        Changed = true;
+        for(size_t t = TermOffsets[f]; t < TermOffsets[f + 1]; t++)
+        {
+          if(Terms[t].Produced > 0.0) { Available[Terms[t].Resource] = 1; }
+        }
+      }
+    }
+
+    Relevant.assign(Resources.size(), 0);
+    Relevant[Target] = 1;
+    std::fill(Usable.begin(), Usable.end(), 0);
+    for(bool Changed = true; Changed; )
+    {
+      Changed = false;
+      for(size_t f : Kept)
+      {
+        if(Usable[f]) { continue; }
+
+        bool Helps = false;
+        for(size_t t = TermOffsets[f]; t < TermOffsets[f + 1] && !Helps; t++)
+        {
+          Helps = (Terms[t].Produced > 0.0 && Relevant[Terms[t].Resource]);
+        }
+        if(!Helps) { continue; }
+
+        Usable[f] = 1;
+        Changed = true;
+        for(size_t t = TermOffsets[f]; t < TermOffsets[f + 1]; t++)
+        {
+          if(Terms[t].Consumed != 0) { Relevant[Terms[t].Resource] = 1; }
+        }
+      }
+    }
+    Kept.erase(std::remove_if(Kept.begin(), Kept.end(), [this](size_t f) { return !Usable[f]; }), Kept.end());
+  }
+
+  //[DESC]: Solve the linear program over the kept formulas {[SEE]: ThroughputPlanner.h}
+  //[POST]: 'Counts[j]' holds the optimal number of applications of formula 'Kept[j]'
+  //[THROW]: 'std::runtime_error' if the simplex does not converge (only on numerically broken input)
+  //[RETURN]: The optimal expected net gain of the target
+  //[NOTE]: Revised simplex with an explicit basis inverse. A formula column has only a handful of
+  //        entries, so a pivot costs O(Rows^2) for the inverse plus O(entries) to update every
+  //        reduced cost, instead of O(Rows * Columns) for a full tableau. The entering variable has
+  //        the largest reduced cost (Dantzig), or the lowest index (Bland) after 'DegenerateLimit'
+  //        pivots that made no progress.
+  double ThroughputPlanner::Solve(std::uint32_t Target, size_t MaxApplications)
+  {
+    const size_t Columns = Kept.size();
+    RowOf.assign(Resources.size(), NoIndex);
+    RowResource.clear();
+    for(size_t f : Kept)
+    {
+      for(size_t t = TermOffsets[f]; t < TermOffsets[f + 1]; t++)
+      {
+        const std::uint32_t Resource = Terms[t].Resource;
+        if(Terms[t].Consumed == 0 || RowOf[Resource] != NoIndex) { continue; }
+        RowOf[Resource] = static_cast<std::uint32_t>(RowResource.size());
+        RowResource.push_back(Resource);
+      }
+    }
+
+    const size_t Rows = RowResource.size() + 1;
+    const std::uint32_t LimitRow = static_cast<std::uint32_t>(Rows - 1);
+    const size_t Variables = Columns + Rows;
+
+    Reduced.assign(Variables, 0.0);
+    ColumnOffsets.assign(1, 0);
+    ColumnRows.clear();
+    ColumnValues.clear();
+    for(size_t j = 0; j < Columns; j++)
+    {
+      const size_t f = Kept[j];
+      for(size_t t = TermOffsets[f]; t < TermOffsets[f + 1]; t++)
+      {
+        const Term& Effect = Terms[t];
+        const double Net = static_cast<double>(Effect.Consumed) - Effect.Produced;
+        if(RowOf[Effect.Resource] != NoIndex)
+        {
+          ColumnRows.push_back(RowOf[Effect.Resource]);
+          ColumnValues.push_back(Net);
+        }
+        if(Effect.Resource == Target) { Reduced[j] = -Net; }
+      }
+      ColumnRows.push_back(LimitRow);
+      ColumnValues.push_back(1.0);
+      ColumnOffsets.push_back(ColumnRows.size());
+    }
+
+    Inverse.assign(Rows * Rows, 0.0);
+    Values.resize(Rows);
+    Basis.resize(Rows);
+    Column.resize(Rows);
+    PivotRow.resize(Rows);
+    for(size_t i = 0; i < Rows; i++)
+    {
+      Inverse[i * Rows + i] = 1.0;
+      Values[i] = (i < LimitRow) ? Initial[RowResource[i]] : static_cast<double>(MaxApplications);
+      Basis[i] = Columns + i;
+    }
+
+    double Optimum = 0.0;
+    const size_t IterationLimit = 50 * Variables + 1000;
+    size_t Degenerate = 0;
+    for(size_t Iteration = 0; ; Iteration++)
+    {
+      if(Iteration == IterationLimit)
+      {
+        throw std::runtime_error("[TP]Optimize(...) [Simplex did not converge]");
+      }
+
+      const bool Bland = (Degenerate >= DegenerateLimit);
+      size_t Entering = Variables;
+      for(size_t j = 0; j < Variables; j++)
+      {
+        if(Reduced[j] <= Epsilon) { continue; }
+        if(Entering == Variables || Reduced[j] > Reduced[Entering]) { Entering = j; }
+        if(Bland) { break; }
+      }
+      if(Entering == Variables) { break; }
+
+      //[NOTE]: 'Inverse' is stored by columns, so the entering column is a sum of inverse columns
+      if(Entering < Columns)
+      {
+        std::fill(Column.begin(), Column.end(), 0.0);
+        for(size_t k = ColumnOffsets[Entering]; k < ColumnOffsets[Entering + 1]; k++)
+        {
+          const double* Source = Inverse.data() + ColumnRows[k] * Rows;
+          for(size_t i = 0; i < Rows; i++) { Column[i] += ColumnValues[k] * Source[i]; }
+        }
+      }
+      else
+      {
+        const double* Source = Inverse.data() + (Entering - Columns) * Rows;
+        std::copy(Source, Source + Rows, Column.begin());
+      }
+
+      //[NOTE]: Ties go to the larger pivot (stable) or, under Bland's rule, to the lower basic variable.
+      //        A value that rounding pushed below zero counts as zero.
+      size_t Leaving = Rows;
+      double Theta = 0.0;
+      for(size_t i = 0; i < Rows; i++)
+      {
+        if(Column[i] <= PivotTolerance) { continue; }
+
+        const double Ratio = std::max(0.0, Values[i]) / Column[i];
+        bool Take = (Leaving == Rows || Ratio < Theta - Epsilon);
+        if(!Take && Ratio <= Theta + Epsilon) { Take = Bland ? (Basis[i] < Basis[Leaving]) : (Column[i] > Column[Leaving]); }
+        if(Take)
+        {
+          Leaving = i;
+          Theta = Ratio;
+        }
+      }
+      //[NOTE]: The application limit row has a coefficient of 1 in every formula column and a slack
+      //        column always has its own row, so this only guards against rounding
+      if(Leaving == Rows) { break; }
+      Degenerate = (Theta <= Epsilon) ? Degenerate + 1 : 0;
+
+      const double Pivot = Column[Leaving];
+      for(size_t k = 0; k < Rows; k++) { PivotRow[k] = Inverse[k * Rows + Leaving]; }
+
+      const double Step = Reduced[Entering] / Pivot;
+      Optimum += Reduced[Entering] * Theta;
+      for(size_t j = 0; j < Columns; j++)
+      {
+        double Dot = 0.0;
+        for(size_t k = ColumnOffsets[j]; k < ColumnOffsets[j + 1]; k++) { Dot += PivotRow[ColumnRows[k]] * ColumnValues[k]; }
+        Reduced[j] -= Step * Dot;
+      }
+      for(size_t k = 0; k < Rows; k++) { Reduced[Columns + k] -= Step * PivotRow[k]; }
+      Reduced[Entering] = 0.0;
+
+      for(size_t i = 0; i < Rows; i++) { Values[i] -= Theta * Column[i]; }
+      Values[Leaving] = Theta;
+
+      for(size_t k = 0; k < Rows; k++)
+      {
+        if(PivotRow[k] == 0.0) { continue; }
+        const double Scaled = PivotRow[k] / Pivot;
+        double* Destination = Inverse.data() + k * Rows;
+        for(size_t i = 0; i < Rows; i++) { Destination[i] -= Column[i] * Scaled; }
+        Destination[Leaving] = Scaled;
+      }
+      Basis[Leaving] = Entering;
+    }
+
+    Counts.assign(Columns, 0.0);
+    for(size_t i = 0; i < Rows; i++)
+    {
+      if(Basis[i] < Columns) { Counts[Basis[i]] = std::max(0.0, Values[i]); }
+    }
+    return Optimum;
+  }
+
+  //[DESC]: Turn the optimal counts into an ordered schedule
+  //[POST]: 'Result.Steps' never consumes more than the expected stockpile holds at that point,
+  //        'Result.ExpectedOutput' is the expected net gain of the target
+  //[RETURN]: True if a formula of the solution could not run even once; it is banned
+  //[NOTE]: Counts are rounded down. A pass runs every formula as often as its remaining count and the
+  //        expected quantities allow; passes repeat while they make progress (cycles such as a catalyst
+  //        that is consumed and produced again need several). The program only balances totals, so it
+  //        may use a loop that nobody seeds (A makes what B needs and B makes what A needs, neither
+  //        in stock): such formulas never start here.
+  bool ThroughputPlanner::Sequence(std::uint32_t Target, Schedule& Result)
+  {
+    Expected.assign(Initial.begin(), Initial.end());
+    Started.assign(Kept.size(), 0);
+    for(double& Count : Counts) { Count = std::floor(Count + 1e-6); }
+
+    const size_t PassLimit = Kept.size() + 64;
+    bool Progress = true;
+    for(size_t Pass = 0; Pass < PassLimit && Progress; Pass++)
+    {
+      Progress = false;
+      for(size_t j = 0; j < Kept.size(); j++)
+      {
+        if(Counts[j] < 1.0) { continue; }
+
+        const size_t f = Kept[j];
+        double Runs = Counts[j];
+        for(size_t t = TermOffsets[f]; t < TermOffsets[f + 1]; t++)
+        {
+          if(Terms[t].Consumed == 0) { continue; }
+          Runs = std::min(Runs, std::floor((Expected[Terms[t].Resource] + Epsilon) / Terms[t].Consumed));
+        }
+        if(Runs < 1.0) { continue; }
+
+        for(size_t t = TermOffsets[f]; t < TermOffsets[f + 1]; t++)
+        {
+          Expected[Terms[t].Resource] += (Terms[t].Produced - Terms[t].Consumed) * Runs;
+        }
+        Counts[j] -= Runs;
+        Started[j] = 1;
+        Progress = true;
+
+        const size_t Repetitions = static_cast<size_t>(Runs);
+        if(!Result.Steps.empty() && Result.Steps.back().Formula == f) { Result.Steps.back().Repetitions += Repetitions; }
+        else { Result.Steps.push_back(Entry{f, Repetitions}); }
+        Result.Applications += Repetitions;
+      }
+    }
+    Result.ExpectedOutput = Expected[Target] - Initial[Target];
+
+    bool Stuck = false;
+    for(size_t j = 0; j < Kept.size(); j++)
+    {
+      if(Started[j] || Counts[j] < 1.0) { continue; }
+      Banned[Kept[j]] = 1;
+      Stuck = true;
+    }
+    return Stuck;
+  }
+
+  //[DESC]: Compute the schedule that maximizes the expected output of 'Target'
+  //[PARAM]: 'Candidates' The formulas that may be used, each any number of times
+  //[PARAM]: 'Start' The stockpile production starts from
+  //[PARAM]: 'Target' The resource to maximize
+  //[PARAM]: 'MaxApplications' Upper limit on the total number of applications (keeps loops that gain
+  //         from nothing, and the schedule, finite)
+  //[PRE]: None
+  //[POST]: The candidates and 'Start' are unchanged
+  //[THROW]: {[SEE]: Solve(...)}
+  //[RETURN]: The schedule, empty if no candidate can add to the target
+  //[NOTE]: If the optimal program relies on a loop nobody seeds, the formulas that cannot start are
+  //        dropped and the program is solved again while that improves the schedule.
+  ThroughputPlanner::Schedule ThroughputPlanner::Optimize(const Plan& Candidates, const Stockpile& Start, ResourceId Target, size_t MaxApplications)
+  {
+    Schedule Result;
+    Describe(Candidates, Start);
+    if(Target >= LocalOf.size() || LocalOf[Target] == NoIndex || MaxApplications == 0) { return Result; }
+
+    const std::uint32_t Local = LocalOf[Target];
+    Banned.assign(TermOffsets.size() - 1, 0);
+    Prune(Local);
+    if(Kept.empty()) { return Result; }
+
+    Result.Bound = Solve(Local, MaxApplications);
+    for(size_t Round = 1; ; Round++)
+    {
+      Schedule Attempt;
+      Attempt.Bound = Result.Bound;
+      const bool Stuck = Sequence(Local, Attempt);
+      const bool Improved = (Round == 1 || Attempt.ExpectedOutput > Result.ExpectedOutput);
+      if(Improved) { Result = std::move(Attempt); }
+      if(!Stuck || !Improved || Round == ResolveLimit) { break; }
+
+      Prune(Local);
+      if(Kept.empty()) { break; }
+      Solve(Local, MaxApplications);
+    }
+    return Result;
+  }
+
+  //[DESC]: Compute the schedule that maximizes the expected output of the named resource
+  //[PRE]: None
+  //[POST]: {[SEE]: Optimize(..., ResourceId, ...)}
+  //[RETURN]: The schedule, empty if the name is unknown
+  ThroughputPlanner::Schedule ThroughputPlanner::Optimize(const Plan& Candidates, const Stockpile& Start, const std::string& Target, size_t MaxApplications)
+  {
+    const std::optional<ResourceId> Resource = ResourceRegistry::Instance().Find(Target);
+    if(!Resource.has_value()) { return Schedule(); }
+    return Optimize(Candidates, Start, *Resource, MaxApplications);
+  }
+
+  //[DESC]: Spell a schedule out as a plan, one step per application
+  //[PRE]: 'Best' was computed for 'Candidates'
+  //[POST]: The plan holds 'Best.Applications' formulas
+  //[RETURN]: The plan, ready for 'PlanApply(...)'
+  ExecutablePlan ThroughputPlanner::ToPlan(const Plan& Candidates, const Schedule& Best)
+  {
+    ExecutablePlan Result;
+    for(const Entry& Step : Best.Steps)
+    {
+      for(size_t k = 0; k < Step.Repetitions; k++) { Result.AddFormula(Candidates.GetFormula(Step.Formula)); }
+    }
+    return Result;
+  }
+}//[NAMESPACE]: ResourceConversion
@@ -0,0 +1,155 @@
+//[FILE]: ThroughputPlanner.h
+//[DESC]: This file defines the 'ThroughputPlanner' class. Given candidate formulas (the formulas of a
+//        'Plan'), a starting 'Stockpile' and a target resource, it computes how often to apply each
+//        formula, and in which order, to maximize the expected amount of the target produced.
+//
+//        The counts come from a linear program over the resource graph. Variable x_f is the number
+//        of applications of formula f; E[f, r] is its expected yield of r {[SEE]:
+//        Formula::ExpectedOutputs(...)} and In[f, r] its consumption of r:
+//
+//          maximize    sum_f (E[f, Target] - In[f, Target]) * x_f
+//          subject to  sum_f (In[f, r] - E[f, r]) * x_f <= Start[r]     for every consumed r
+//                      sum_f x_f                         <= MaxApplications
+//                      x_f >= 0
+//
+//        'Start' is never negative, so x = 0 is feasible and a single (revised) simplex phase solves it. Before
+//        solving, formulas that can never run (an input no one has or makes) or never help (no path to
+//        the target) are dropped, which usually shrinks the program a lot.
+//
+//        The solution is rounded down and turned into a schedule by replaying it on the expected
+//        stockpile: in passes over the formulas (ordered by when their inputs first become
+//        available), each formula runs as many of its remaining applications as the expected
+//        quantities allow. The program only balances totals, so it can lean on a loop of formulas
+//        that feed each other but that nothing in stock starts; those formulas are dropped and the
+//        program is solved again (a few rounds at most).
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: The candidates and the starting stockpile are never modified.
+//[INVARIANT]: Every 'Entry' of a schedule refers to a formula of the candidate plan and has at least one
+//             repetition; following the schedule never needs more than the expected quantities.
+//
+//[USAGE]
+//{
+// ThroughputPlanner Planner;                                             -> keep it, buffers are reused
+//
+// ThroughputPlanner::Schedule Best = Planner.Optimize(Recipes, *StockpilePtr, "Steel", 10000);
+// Best.ExpectedOutput;  Best.Bound;                                      -> schedule vs. LP optimum
+//
+// ExecutablePlan Production = ThroughputPlanner::ToPlan(Recipes, Best);
+// Production.PlanApply(StockpilePtr);
+//}
+//
+//[NOTE]: Expected yields use the current proficiency level of every formula. Applying a formula raises
+//        its level, which only improves later yields, so the expectation is conservative.
+//[NOTE]: The program treats expected yields as exact amounts. A real run draws random yields, so it can
+//        fall short of the schedule; re-planning every tick from the actual stockpile corrects that.
+//
+//[DEPENDENCIES]:
+//       [INTERNAL]:
+//          - Member, Helper, Utility methods
+//          - Private Data Members
+//
+//        [EXTERNAL]:
+//          - 'Plan', 'ExecutablePlan', 'Formula' {[SEE]: Plan.h, ExecutablePlan.h, Formula.h}
+//          - 'Stockpile' class {[SEE]: Stockpile.h}
+//          - 'std::vector'
+//
+//[NAMESPACE]: {ResourceConversion} Encapsulates the 'Formula', 'Plan', 'ExecutablePlan', 'Stockpile'
+//             and supporting classes.
+#ifndef ThroughputPlanner_h
+#define ThroughputPlanner_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ExecutablePlan.h"
+#include "Plan.h"
+#include "ResourceRegistry.h"
+#include "Stockpile.h"
+
+namespace ResourceConversion
+{
+  class ThroughputPlanner
+  {
+    public:
+    //[DESC]: Apply formula 'Formula' of the candidates 'Repetitions' times in a row
+    struct Entry
+    {
+      size_t Formula = 0;
+      size_t Repetitions = 0;
+    };
+
+    //[DESC]: Outcome of 'Optimize(...)'
+    //        - 'Steps' the schedule, in order
+    //        - 'Applications' the total of all repetitions
+    //        - 'ExpectedOutput' the expected net gain of the target when following 'Steps'
+    //        - 'Bound' the optimum of the linear program, no schedule can expect more
+    struct Schedule
+    {
+      std::vector<Entry> Steps = std::vector<Entry>();
+      size_t Applications = 0;
+      double ExpectedOutput = 0.0;
+      double Bound = 0.0;
+    };
+
+    private:
+    //[NOTE]: One resource a formula touches, duplicates within the formula are merged
+    struct Term
+    {
+      std::uint32_t Resource = 0;
+      unsigned int Consumed = 0;
+      double Produced = 0.0;
+    };
+
+    //[NOTE]: Scratch of one 'Optimize(...)' call, kept so re-planning every tick does not reallocate.
+    //        Resources are numbered locally (0, 1, 2, ...) in the order the candidates mention them.
+    std::vector<ResourceId> Resources = std::vector<ResourceId>();
+    std::vector<std::uint32_t> LocalOf = std::vector<std::uint32_t>();
+    std::vector<double> Initial = std::vector<double>();
+    std::vector<size_t> TermOffsets = std::vector<size_t>();
+    std::vector<Term> Terms = std::vector<Term>();
+    std::vector<double> Yield = std::vector<double>();
+    std::vector<char> Available = std::vector<char>();
+    std::vector<char> Relevant = std::vector<char>();
+    std::vector<char> Usable = std::vector<char>();
+    std::vector<char> Banned = std::vector<char>();
+    std::vector<char> Started = std::vector<char>();
+    std::vector<size_t> Kept = std::vector<size_t>();
+    std::vector<std::uint32_t> RowOf = std::vector<std::uint32_t>();
+    std::vector<std::uint32_t> RowResource = std::vector<std::uint32_t>();
+    std::vector<size_t> ColumnOffsets = std::vector<size_t>();
+    std::vector<std::uint32_t> ColumnRows = std::vector<std::uint32_t>();
+    std::vector<double> ColumnValues = std::vector<double>();
+    std::vector<double> Reduced = std::vector<double>();
+    std::vector<double> Inverse = std::vector<double>();
+    std::vector<double> Values = std::vector<double>();
+    std::vector<double> Column = std::vector<double>();
+    std::vector<double> PivotRow = std::vector<double>();
+    std::vector<size_t> Basis = std::vector<size_t>();
+    std::vector<double> Counts = std::vector<double>();
+    std::vector<double> Expected = std::vector<double>();
+
+    std::uint32_t LocalIndex(ResourceId Resource);
+    void Describe(const Plan& Candidates, const Stockpile& Start);
+    void Prune(std::uint32_t Target);
+    double Solve(std::uint32_t Target, size_t MaxApplications);
+    bool Sequence(std::uint32_t Target, Schedule& Result);
+
+    public:
+    ThroughputPlanner();
+
+    Schedule Optimize(const Plan& Candidates, const Stockpile& Start, ResourceId Target, size_t MaxApplications);
+    Schedule Optimize(const Plan& Candidates, const Stockpile& Start, const std::string& Target, size_t MaxApplications);
+
+    static ExecutablePlan ToPlan(const Plan& Candidates, const Schedule& Best);
+  };
+}//[NAMESPACE]: ResourceConversion
+#endif /*ThroughputPlanner_h*/
@@ -0,0 +1,158 @@
+//[FILE]: VersionedQuantities.cpp
+//[DESC]: This file contains the implementation of the 'VersionedQuantities' class {[SEE]: VersionedQuantities.h}
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: Level 1 nodes are 'Leaf's, every other node is a 'Branch'. Bits [5(L - 1), 5L) of an id
+//             select the child at level L.
+
+#include <utility>
+
+#include "VersionedQuantities.h"
+
+namespace ResourceConversion
+{
+  //[DESC]: Copy the path from 'Node' down to the quantity of 'Resource' and change that quantity
+  //[PARAM]: 'Node' The node to copy, may be null
+  //[PARAM]: 'Level' The level of 'Node', 1 for a leaf
+  //[PRE]: 'Resource' is below 32^Level
+  //[POST]: 'Node' is unchanged
+  //[RETURN]: The copy, sharing every child that is not on the path
+  std::shared_ptr<const void> VersionedQuantities::SetIn(const std::shared_ptr<const void>& Node, size_t Level, ResourceId Resource, size_t Quantity)
+  {
+    if(Level == 1)
+    {
+      std::shared_ptr<Leaf> Copy = (Node != nullptr) ? std::make_shared<Leaf>(*static_cast<const Leaf*>(Node.get())) : std::make_shared<Leaf>();
+      Copy -> Quantities[Resource & Mask] = Quantity;
+      return Copy;
+    }
+
+    std::shared_ptr<Branch> Copy = (Node != nullptr) ? std::make_shared<Branch>(*static_cast<const Branch*>(Node.get())) : std::make_shared<Branch>();
+    const size_t Slot = (static_cast<size_t>(Resource) >> (Bits * (Level - 1))) & Mask;
+    Copy -> Children[Slot] = SetIn(Copy -> Children[Slot], Level - 1, Resource, Quantity);
+    return Copy;
+  }
+
+  //[DESC]: Get the number of ids a version can hold without growing
+  //[RETURN]: 32^Levels
+  size_t VersionedQuantities::Tree::Capacity() const
+  {
+    return size_t(1) << (Bits * Levels);
+  }
+
+  //[DESC]: Look up the quantity of a resource in this version
+  //[PRE]: None
+  //[POST]: None
+  //[RETURN]: The quantity, 'AbsentQuantity' if the resource is not part of this version
+  size_t VersionedQuantities::Tree::Find(ResourceId Resource) const
+  {
+    if(Resource >= Capacity()) { return AbsentQuantity; }
+
+    const void* Node = Root.get();
+    for(size_t Level = Levels; Level > 1 && Node != nullptr; Level--)
+    {
+      const size_t Slot = (static_cast<size_t>(Resource) >> (Bits * (Level - 1))) & Mask;
+      Node = static_cast<const Branch*>(Node) -> Children[Slot].get();
+    }
+
+    if(Node == nullptr) { return AbsentQuantity; }
+    return static_cast<const Leaf*>(Node) -> Quantities[Resource & Mask];
+  }
+
+  //[DESC]: Start an edit on top of 'Base'
+  //[PRE]: None
+  //[POST]: The draft shares every node with 'Base'
+  VersionedQuantities::Draft::Draft(const Tree& Base) : Working(Base) {}
+
+  //[DESC]: Read a quantity, including the changes already made to this draft
+  //[RETURN]: The quantity, 'AbsentQuantity' if the resource is not part of the draft
+  size_t VersionedQuantities::Draft::Get(ResourceId Resource) const
+  {
+    return Working.Find(Resource);
+  }
+
+  //[DESC]: Change a quantity of the draft
+  //[PARAM]: 'Quantity' The new quantity, 'AbsentQuantity' removes the resource
+  //[PRE]: None
+  //[POST]: Only the draft changed, published versions are untouched. The trie grows a level when
+  //        'Resource' does not fit.
+  void VersionedQuantities::Draft::Set(ResourceId Resource, size_t Quantity)
+  {
+    while(Resource >= Working.Capacity())
+    {
+      std::shared_ptr<Branch> Grown = std::make_shared<Branch>();
+      Grown -> Children[0] = std::move(Working.Root);
+      Working.Root = std::move(Grown);
+      Working.Levels++;
+    }
+
+    Working.Root = SetIn(Working.Root, Working.Levels, Resource, Quantity);
+    Changed = true;
+  }
+
+  //[DESC]: Default constructor
+  //[PRE]: None
+  //[POST]: An unused object is constructed, it reads as empty
+  VersionedQuantities::VersionedQuantities() {}
+
+  //[DESC]: Move constructor
+  //[PRE]: 'other' has to be an !rvalue! reference
+  //[POST]: Ownership is transfered, 'other' is unused
+  VersionedQuantities::VersionedQuantities(VersionedQuantities&& other) noexcept : Head(std::move(other.Head)) {}
+
+  //[DESC]: Move assignment operator
+  //[PRE]: 'other' has to be an !rvalue! reference
+  //[POST]: Data is swapped
+  VersionedQuantities& VersionedQuantities::operator=(VersionedQuantities&& other) noexcept
+  {
+    if(this != &other) { std::swap(Head, other.Head); }
+    return *this;
+  }
+
+  //[DESC]: Start over with an empty version
+  //[PRE]: No other thread uses the object
+  //[POST]: The head is an empty version 0. Snapshots taken before stay valid.
+  void VersionedQuantities::Reset()
+  {
+    std::atomic_store(&Head, std::make_shared<const Tree>());
+  }
+
+  //[DESC]: Release the head
+  //[PRE]: No other thread uses the object
+  //[POST]: The object is unused, snapshots taken before stay valid
+  void VersionedQuantities::Clear()
+  {
+    std::atomic_store(&Head, std::shared_ptr<const Tree>());
+  }
+
+  //[DESC]: Get the newest version
+  //[PRE]: None
+  //[POST]: None
+  //[RETURN]: The version, it never changes and stays alive as long as the returned pointer does
+  std::shared_ptr<const VersionedQuantities::Tree> VersionedQuantities::Current() const
+  {
+    return std::atomic_load(&Head);
+  }
+
+  //[DESC]: Check whether a resource is part of the newest version
+  //[RETURN]: True if it is, false otherwise (also if the object is unused)
+  bool VersionedQuantities::Has(ResourceId Resource) const
+  {
+    std::shared_ptr<const Tree> Version = Current();
+    return Version != nullptr && Version -> Find(Resource) != AbsentQuantity;
+  }
+
+  //[DESC]: Get the quantity of a resource in the newest version
+  //[RETURN]: The quantity, 0 if the resource is absent
+  size_t VersionedQuantities::Load(ResourceId Resource) const
+  {
+    std::shared_ptr<const Tree> Version = Current();
+    const size_t Quantity = (Version == nullptr) ? AbsentQuantity : Version -> Find(Resource);
+    return (Quantity == AbsentQuantity) ? 0 : Quantity;
+  }
+}//[NAMESPACE]: ResourceConversion
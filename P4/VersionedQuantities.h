@@ -0,0 +1,211 @@
+//[FILE]: VersionedQuantities.h
+//[DESC]: This file defines the 'VersionedQuantities' class, the storage behind 'Stockpile's 'Versioned'
+//        mode. Quantities live in a persistent (immutable, path-copying) 32-way trie indexed by
+//        'ResourceId'. A change never modifies a published node: it copies the nodes on the path to
+//        the changed quantity (at most a handful for tens of thousands of resources) and publishes a
+//        new root with a single compare-and-swap. Every published root is a complete, consistent
+//        version of the stockpile, so taking a snapshot is copying one pointer.
+//
+//          Head -> Tree #7 -> Branch -> Leaf [q0 .. q31]
+//                                    -> Leaf [q32 .. q63]      <- shared with Tree #6
+//
+//        Writers build their version in a 'Draft' and commit it; if another writer committed first
+//        the edit runs again on the newer version (optimistic concurrency). Readers only load the
+//        head and never wait for an edit to finish; the load and the publishing compare-and-swap
+//        copy the head pointer under a short lock {[SEE]: [NOTE] below}.
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: Nodes reachable from a published 'Tree' are never modified.
+//[INVARIANT]: A 'Tree' with 'Levels' levels holds ids below 32^Levels, a null child means every quantity
+//             below it is absent.
+//[INVARIANT]: 'Number' grows by one with every committed change.
+//
+//[USAGE]
+//{
+// VersionedQuantities Versions;
+// Versions.Reset();
+//
+// Versions.Commit([&](VersionedQuantities::Draft& Working) {
+//   if(Working.Get(Iron) < 5) { return false; }     -> nothing is published
+//   Working.Set(Iron, Working.Get(Iron) - 5);
+//   Working.Set(Tools, Working.Get(Tools) + 1);     -> both changes become visible together
+//   return true;
+// });
+//
+// std::shared_ptr<const VersionedQuantities::Tree> Version = Versions.Current();   -> O(1) snapshot
+//}
+//
+//[NOTE]: The head is published with 'std::atomic_load'/'std::atomic_compare_exchange_weak' on
+//        'std::shared_ptr' ('std::atomic<std::shared_ptr>' is C++20). libstdc++ implements these with
+//        a small pool of mutexes, held only while the pointer is copied or swapped, so readers and
+//        writers can briefly wait on each other (or on an unrelated pointer hashed to the same mutex).
+//
+//[DEPENDENCIES]:
+//       [INTERNAL]:
+//          - Member, Helper, Utility methods
+//          - Private Data Members
+//
+//        [EXTERNAL]:
+//          - 'std::shared_ptr'
+//          - 'ResourceId' {[SEE]: ResourceRegistry.h}
+//
+//[NAMESPACE]: {ResourceConversion} Encapsulates the 'Formula', 'Plan', 'ExecutablePlan', 'Stockpile'
+//             and supporting classes.
+#ifndef VersionedQuantities_h
+#define VersionedQuantities_h
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+#include "ResourceRegistry.h"
+
+namespace ResourceConversion
+{
+  class VersionedQuantities
+  {
+    public:
+    //[NOTE]: Marks the quantity of a resource that is not part of the stockpile
+    static constexpr size_t AbsentQuantity = std::numeric_limits<size_t>::max();
+
+    private:
+    static constexpr size_t Bits = 5;
+    static constexpr size_t Fanout = size_t(1) << Bits;
+    static constexpr size_t Mask = Fanout - 1;
+
+    struct Leaf
+    {
+      std::array<size_t, Fanout> Quantities;
+      Leaf() : Quantities() { Quantities.fill(AbsentQuantity); }
+    };
+
+    struct Branch
+    {
+      std::array<std::shared_ptr<const void>, Fanout> Children = {};
+    };
+
+    static std::shared_ptr<const void> SetIn(const std::shared_ptr<const void>& Node, size_t Level, ResourceId Resource, size_t Quantity);
+
+    template<typename Visitor>
+    static void VisitNode(const void* Node, size_t Level, size_t FirstId, Visitor& Visit);
+
+    public:
+    //[DESC]: One immutable version of all quantities
+    struct Tree
+    {
+      std::shared_ptr<const void> Root = nullptr;
+      size_t Levels = 1;
+      std::uint64_t Number = 0;
+
+      size_t Capacity() const;
+      size_t Find(ResourceId Resource) const;
+      template<typename Visitor> void Visit(Visitor&& Callback) const;
+    };
+
+    //[DESC]: A private, not yet published version that an edit works on
+    class Draft
+    {
+      private:
+      Tree Working;
+      bool Changed = false;
+
+      friend class VersionedQuantities;
+
+      public:
+      explicit Draft(const Tree& Base);
+
+      size_t Get(ResourceId Resource) const;
+      void Set(ResourceId Resource, size_t Quantity);
+    };
+
+    private:
+    std::shared_ptr<const Tree> Head = nullptr;
+
+    public:
+    VersionedQuantities();
+    VersionedQuantities(VersionedQuantities&& other) noexcept;
+    VersionedQuantities& operator=(VersionedQuantities&& other) noexcept;
+    ~VersionedQuantities() = default;
+
+    VersionedQuantities(const VersionedQuantities& other) = delete;
+    VersionedQuantities& operator=(const VersionedQuantities& other) = delete;
+
+    void Reset();
+    void Clear();
+
+    std::shared_ptr<const Tree> Current() const;
+    bool Has(ResourceId Resource) const;
+    size_t Load(ResourceId Resource) const;
+
+    template<typename Edit> bool Commit(Edit&& Change);
+  };
+
+  //[DESC]: Call 'Visit(ResourceId, size_t)' once per present resource of a node, in id order
+  //[PARAM]: 'Level' The number of levels below and including 'Node', 1 for a leaf
+  //[PARAM]: 'FirstId' The id of the first quantity below 'Node'
+  template<typename Visitor>
+  void VersionedQuantities::VisitNode(const void* Node, size_t Level, size_t FirstId, Visitor& Visit)
+  {
+    if(Node == nullptr) { return; }
+
+    if(Level == 1)
+    {
+      const Leaf& Values = *static_cast<const Leaf*>(Node);
+      for(size_t i = 0; i < Fanout; i++)
+      {
+        if(Values.Quantities[i] != AbsentQuantity) { Visit(static_cast<ResourceId>(FirstId + i), Values.Quantities[i]); }
+      }
+      return;
+    }
+
+    const Branch& Children = *static_cast<const Branch*>(Node);
+    const size_t Span = size_t(1) << (Bits * (Level - 1));
+    for(size_t i = 0; i < Fanout; i++)
+    {
+      VisitNode(Children.Children[i].get(), Level - 1, FirstId + i * Span, Visit);
+    }
+  }
+
+  //[DESC]: Call 'Visit(ResourceId, size_t)' once per present resource of this version, in id order
+  //[PRE]: None
+  //[POST]: None
+  template<typename Visitor>
+  void VersionedQuantities::Tree::Visit(Visitor&& Callback) const
+  {
+    VisitNode(Root.get(), Levels, 0, Callback);
+  }
+
+  //[DESC]: Apply an edit to the newest version and publish the result atomically
+  //[PARAM]: 'Change' Callable 'bool(Draft&)'. It reads and sets quantities on the draft and returns
+  //         'false' to abandon the edit. It may run more than once and must not have other side effects.
+  //[PRE]: None, an unused object starts from an empty version
+  //[POST]: Either every 'Set' of the edit became visible at once, or none did
+  //[THROW]: Whatever 'Change' throws, nothing is published in that case
+  //[RETURN]: The value returned by the last run of 'Change'
+  //[NOTE]: If another writer publishes between the load and the compare-and-swap, the edit is run
+  //        again on that newer version. Writers never hold a lock while editing, at worst they redo their edit.
+  template<typename Edit>
+  bool VersionedQuantities::Commit(Edit&& Change)
+  {
+    std::shared_ptr<const Tree> Base = std::atomic_load(&Head);
+    while(true)
+    {
+      Draft Working((Base != nullptr) ? *Base : Tree());
+      if(!Change(Working)) { return false; }
+      if(!Working.Changed) { return true; }
+
+      Working.Working.Number = ((Base != nullptr) ? Base -> Number : 0) + 1;
+      std::shared_ptr<const Tree> Next = std::make_shared<const Tree>(std::move(Working.Working));
+      if(std::atomic_compare_exchange_weak(&Head, &Base, Next)) { return true; }
+    }
+  }
+}//[NAMESPACE]: ResourceConversion
+#endif /*VersionedQuantities_h*/
@@ -0,0 +1,191 @@
+//[FILE]: WorkStealingPool.cpp
+//[DESC]: This file contains the implementation of the 'WorkStealingPool' class {[SEE]: WorkStealingPool.h}
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: 'BusyWorkers' counts the pool threads that have not finished the current run yet, it is
+//             only touched under 'StateLock'.
+//[INVARIANT]: 'Pending[j]' is the number of unfinished predecessors of step j in the current run.
+
+#include <algorithm>
+
+#include "WorkStealingPool.h"
+
+namespace ResourceConversion
+{
+  //[DESC]: Default constructor
+  //[PRE]: None
+  //[POST]: A pool with one worker per hardware thread is constructed, the threads are started
+  WorkStealingPool::WorkStealingPool() : WorkStealingPool(0) {}
+
+  //[DESC]: Constructor
+  //[PARAM]: 'Workers_' The number of workers including the calling thread, 0 for one per hardware thread
+  //[PRE]: None
+  //[POST]: 'Workers_' - 1 threads are started and wait for the first run
+  WorkStealingPool::WorkStealingPool(size_t Workers_)
+    : Workers((Workers_ != 0) ? Workers_ : std::max<size_t>(1, std::thread::hardware_concurrency()))
+  {
+    Queues = std::make_unique<WorkerQueue[]>(Workers);
+    Threads.reserve(Workers - 1);
+    for(size_t i = 1; i < Workers; i++) { Threads.emplace_back(&WorkStealingPool::WorkerMain, this, i); }
+  }
+
+  //[DESC]: Destructor
+  //[PRE]: No run is in progress
+  //[POST]: Every pool thread has stopped and was joined
+  WorkStealingPool::~WorkStealingPool()
+  {
+    {
+      std::lock_guard<std::mutex> Guard(StateLock);
+      Stopping = true;
+    }
+    RunStarted.notify_all();
+    for(std::thread& Worker : Threads) { Worker.join(); }
+  }
+
+  //[DESC]: Body of a pool thread, takes part in every run until the pool is destroyed
+  //[PARAM]: 'Self' The index of the worker
+  void WorkStealingPool::WorkerMain(size_t Self)
+  {
+    std::uint64_t Seen = 0;
+    while(true)
+    {
+      {
+        std::unique_lock<std::mutex> Guard(StateLock);
+        RunStarted.wait(Guard, [this, Seen]() { return Stopping || RunNumber != Seen; });
+        if(Stopping) { return; }
+        Seen = RunNumber;
+      }
+
+      Work(Self);
+
+      std::lock_guard<std::mutex> Guard(StateLock);
+      if(--BusyWorkers == 0) { RunFinished.notify_all(); }
+    }
+  }
+
+  //[DESC]: Run ready steps until every step of the run finished or one of them threw
+  //[PARAM]: 'Self' The index of the worker
+  //[POST]: The successors released by the steps this worker ran are on its deque
+  void WorkStealingPool::Work(size_t Self)
+  {
+    while(Remaining.load(std::memory_order_acquire) != 0 && !Failed.load(std::memory_order_acquire))
+    {
+      std::uint32_t Step = 0;
+      if(!Pop(Self, Step) && !Steal(Self, Step))
+      {
+        std::this_thread::yield();
+        continue;
+      }
+
+      try
+      {
+        (*Task)(Step);
+      }
+      catch(...)
+      {
+        std::lock_guard<std::mutex> Guard(StateLock);
+        if(Error == nullptr) { Error = std::current_exception(); }
+        Failed.store(true, std::memory_order_release);
+      }
+
+      for(std::uint32_t Next : Graph -> GetSuccessors(Step))
+      {
+        if(Pending[Next].fetch_sub(1, std::memory_order_acq_rel) == 1) { Push(Self, Next); }
+      }
+      Remaining.fetch_sub(1, std::memory_order_acq_rel);
+    }
+  }
+
+  //[DESC]: Take the newest step of the worker's own deque
+  //[RETURN]: 'true' if a step was taken
+  bool WorkStealingPool::Pop(size_t Self, std::uint32_t& Step)
+  {
+    std::lock_guard<std::mutex> Guard(Queues[Self].Lock);
+    if(Queues[Self].Ready.empty()) { return false; }
+    Step = Queues[Self].Ready.back();
+    Queues[Self].Ready.pop_back();
+    return true;
+  }
+
+  //[DESC]: Take the oldest step of another worker's deque, visiting the others round-robin
+  //[RETURN]: 'true' if a step was taken
+  bool WorkStealingPool::Steal(size_t Self, std::uint32_t& Step)
+  {
+    for(size_t Offset = 1; Offset < Workers; Offset++)
+    {
+      WorkerQueue& Victim = Queues[(Self + Offset) % Workers];
+      std::lock_guard<std::mutex> Guard(Victim.Lock);
+      if(Victim.Ready.empty()) { continue; }
+      Step = Victim.Ready.front();
+      Victim.Ready.pop_front();
+      return true;
+    }
+    return false;
+  }
+
+  //[DESC]: Put a ready step on the worker's own deque
+  void WorkStealingPool::Push(size_t Self, std::uint32_t Step)
+  {
+    std::lock_guard<std::mutex> Guard(Queues[Self].Lock);
+    Queues[Self].Ready.push_back(Step);
+  }
+
+  //[DESC]: Run every step of a graph, each one after all of its predecessors
+  //[PARAM]: 'Graph_' The dependency graph, steps are numbered 0 .. 'StepCount()' - 1
+  //[PARAM]: 'Task_' Called once per step with its index, from any worker. Steps without a path
+  //         between them may run at the same time.
+  //[PRE]: 'Task_' is safe to call concurrently for independent steps
+  //[POST]: Every step ran and its effects are visible to the caller, or a step threw and the steps
+  //        that were not started yet never run
+  //[THROW]: The first exception thrown by 'Task_', after every worker stopped
+  void WorkStealingPool::Run(const StepGraph& Graph_, const std::function<void(size_t)>& Task_)
+  {
+    std::lock_guard<std::mutex> Serial(RunLock);
+    const size_t Count = Graph_.StepCount();
+    if(Count == 0) { return; }
+
+    if(PendingSize < Count)
+    {
+      Pending = std::make_unique<std::atomic<std::uint32_t>[]>(Count);
+      PendingSize = Count;
+    }
+
+    size_t Roots = 0;
+    for(size_t i = 0; i < Count; i++)
+    {
+      Pending[i].store(Graph_.GetPredecessorCount(i), std::memory_order_relaxed);
+      if(Graph_.GetPredecessorCount(i) == 0) { Push(Roots++ % Workers, static_cast<std::uint32_t>(i)); }
+    }
+
+    Graph = &Graph_;
+    Task = &Task_;
+    Remaining.store(Count, std::memory_order_relaxed);
+    Failed.store(false, std::memory_order_relaxed);
+    Error = nullptr;
+
+    {
+      std::lock_guard<std::mutex> Guard(StateLock);
+      BusyWorkers = Workers - 1;
+      ++RunNumber;
+    }
+    RunStarted.notify_all();
+
+    Work(0);
+
+    {
+      std::unique_lock<std::mutex> Guard(StateLock);
+      RunFinished.wait(Guard, [this]() { return BusyWorkers == 0; });
+    }
+
+    for(size_t i = 0; i < Workers; i++) { Queues[i].Ready.clear(); }
+    Graph = nullptr;
+    Task = nullptr;
+    if(Error != nullptr) { std::rethrow_exception(Error); }
+  }
+}//[NAMESPACE]: ResourceConversion
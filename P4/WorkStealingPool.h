@@ -0,0 +1,116 @@
+//[FILE]: WorkStealingPool.h
+//[DESC]: This file defines the 'WorkStealingPool' class, a fixed set of worker threads that runs the
+//        steps of a 'StepGraph' {[SEE]: StepGraph.h} as soon as their predecessors are done.
+//
+//        Every worker owns a deque of ready steps. A worker takes its newest step (LIFO, the data it
+//        just produced is still in cache) and, when its own deque runs dry, steals the oldest step of
+//        another worker (FIFO, the coarsest piece of remaining work). Finishing a step counts down
+//        the predecessors of its successors; a successor that reaches zero is pushed on the deque of
+//        the worker that released it.
+//
+//        The threads are started once and sleep between runs, so a pool is meant to be kept and
+//        reused for many plan applications. The thread that calls 'Run(...)' works as one of the
+//        workers.
+//
+//[AUTHOR]: Jakob Balkovec (CPSC 3200)
+//[INSTRUCTOR]: A. Dingle (CPSC 3200)
+//
+//[DATE]: Fri 16th Oct
+//[VERSION]: Revision History
+//          - 1.0 [16/10/2026] - Initial class design
+//
+//[INVARIANT]: A step is pushed on a deque exactly once per run, when its last predecessor finished.
+//[INVARIANT]: Worker 0 is the calling thread, workers 1 .. 'WorkerCount()' - 1 are pool threads.
+//
+//[USAGE]
+//{
+// WorkStealingPool Pool;                              -> one worker per hardware thread
+// Pool.Run(Graph, [&](size_t Step) { ... });          -> returns when every step ran
+//}
+//
+//[NOTE]: Runs are serialized, a second thread calling 'Run(...)' waits for the first run to end.
+//        While a run has fewer ready steps than workers, the idle workers yield instead of sleeping.
+//
+//[DEPENDENCIES]:
+//       [INTERNAL]:
+//          - Member, Helper, Utility methods
+//          - Private Data Members
+//
+//        [EXTERNAL]:
+//          - 'StepGraph' class {[SEE]: StepGraph.h}
+//          - 'std::thread', 'std::mutex', 'std::condition_variable'
+//
+//[NAMESPACE]: {ResourceConversion} Encapsulates the 'Formula', 'Plan', 'ExecutablePlan', 'Stockpile'
+//             and supporting classes.
+#ifndef WorkStealingPool_h
+#define WorkStealingPool_h
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "StepGraph.h"
+
+namespace ResourceConversion
+{
+  class WorkStealingPool
+  {
+    private:
+    //[NOTE]: One cache line per worker, so pushing and stealing on different deques never collide
+    struct alignas(64) WorkerQueue
+    {
+      std::mutex Lock;
+      std::deque<std::uint32_t> Ready;
+      WorkerQueue() : Lock(), Ready() {}
+    };
+
+    std::vector<std::thread> Threads = std::vector<std::thread>();
+    std::unique_ptr<WorkerQueue[]> Queues = nullptr;
+    size_t Workers = 1;
+
+    std::mutex RunLock{};
+    std::mutex StateLock{};
+    std::condition_variable RunStarted{};
+    std::condition_variable RunFinished{};
+    std::uint64_t RunNumber = 0;
+    size_t BusyWorkers = 0;
+    bool Stopping = false;
+
+    const StepGraph* Graph = nullptr;
+    const std::function<void(size_t)>* Task = nullptr;
+    std::unique_ptr<std::atomic<std::uint32_t>[]> Pending = nullptr;
+    size_t PendingSize = 0;
+    std::atomic<size_t> Remaining{0};
+    std::atomic<bool> Failed{false};
+    std::exception_ptr Error = nullptr;
+
+    void WorkerMain(size_t Self);
+    void Work(size_t Self);
+    bool Pop(size_t Self, std::uint32_t& Step);
+    bool Steal(size_t Self, std::uint32_t& Step);
+    void Push(size_t Self, std::uint32_t Step);
+
+    public:
+    WorkStealingPool();
+    explicit WorkStealingPool(size_t Workers_);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool& other) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool& other) = delete;
+    WorkStealingPool(WorkStealingPool&& other) = delete;
+    WorkStealingPool& operator=(WorkStealingPool&& other) = delete;
+
+    void Run(const StepGraph& Graph_, const std::function<void(size_t)>& Task_);
+
+    inline size_t WorkerCount() const { return Workers; }
+  };
+}//[NAMESPACE]: ResourceConversion
+#endif /*WorkStealingPool_h*/